@@ -149,6 +149,8 @@ static ulonglong opt_system= 0ULL;
 static my_bool insert_pat_inited= 0, debug_info_flag= 0, debug_check_flag= 0,
                select_field_names_inited= 0;
 static ulong opt_max_allowed_packet, opt_net_buffer_length;
+static uint opt_parallel= 0;
+static ulonglong opt_chunk_rows;
 static double opt_max_statement_time= 0.0;
 static MYSQL mysql_connection,*mysql=0;
 static DYNAMIC_STRING insert_pat, select_field_names, select_field_names_for_header;
@@ -289,6 +291,12 @@ static struct my_option my_long_options[] =
   {"character-sets-dir", OPT_CHARSETS_DIR,
    "Directory for character set files.", (char **)&charsets_dir,
    (char **)&charsets_dir, 0, GET_STR, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
+  {"chunk-rows", 0,
+   "With --parallel, split the data of a table with a single-column integer "
+   "primary key into ranges of about this many rows, each dumped by its own "
+   "query into its own file named table.NNNNN.txt.",
+   &opt_chunk_rows, &opt_chunk_rows, 0, GET_ULL, REQUIRED_ARG,
+   1000000, 1000, ~0ULL, 0, 1, 0},
   {"comments", 'i', "Write additional information.",
    &opt_comments, &opt_comments, 0, GET_BOOL, NO_ARG,
    1, 0, 0, 0, 0, 0},
@@ -525,6 +533,15 @@ static struct my_option my_long_options[] =
    "Dump tables in the order of their size, smaller first. Useful when using --single-transaction on tables which get truncated often. "
    "Dumping smaller tables first reduces chances of often truncated tables to get altered before being dumped.",
     &opt_order_by_size, &opt_order_by_size, 0, GET_BOOL, NO_ARG, 0, 0, 0, 0, 0, 0},
+  {"parallel", 0,
+   "Dump the data of the tables in this many threads, each with its own "
+   "connection. All connections read one consistent snapshot, taken under "
+   "FLUSH TABLES WITH READ LOCK. Requires --tab and implies "
+   "--single-transaction. The files can be loaded in parallel with "
+   "mariadb-import --use-threads, but not with mariadb-import --delete, "
+   "which refuses several files of one table.",
+   &opt_parallel, &opt_parallel, 0, GET_UINT, REQUIRED_ARG, 0, 0, 256, 0, 0,
+   0},
   {"password", 'p',
    "Password to use when connecting to server. If password is not given it's solicited on the tty.",
    0, 0, 0, GET_STR, OPT_ARG, 0, 0, 0, 0, 0, 0},
@@ -648,6 +665,7 @@ static int dump_all_timezones();
 static char *quote_name(const char *name, char *buff, my_bool force);
 char check_if_ignore_table(const char *table_name, char *table_type);
 static char *primary_key_fields(const char *table_name);
+static int start_transaction(MYSQL *mysql_con);
 static my_bool get_view_structure(char *table, char* db);
 static my_bool dump_all_views_in_db(char *database);
 static int dump_all_tablespaces();
@@ -1303,6 +1321,23 @@ static int get_options(int *argc, char ***argv)
     return(EX_USAGE);
   }
 
+  if (opt_parallel > 1)
+  {
+    if (!path)
+    {
+      fprintf(stderr, "%s: You must use option --tab with --parallel\n",
+              my_progname_short);
+      return(EX_USAGE);
+    }
+    if (opt_lock_all_tables)
+    {
+      fprintf(stderr, "%s: You can't use --parallel and --lock-all-tables "
+              "at the same time.\n", my_progname_short);
+      return(EX_USAGE);
+    }
+    opt_single_transaction= 1;
+  }
+
   /* We don't delete master logs if slave data option */
   if (opt_slave_data)
   {
@@ -2006,67 +2041,60 @@ static void maybe_exit(int error)
   db_connect -- connects to the host and selects DB.
 */
 
-static int connect_to_db(char *host, char *user,char *passwd)
+/*
+  Open a connection with the options of the command line, and set the
+  session variables that the dump depends on.
+*/
+
+static int open_connection(MYSQL *con, char *host, char *user, char *passwd)
 {
   char buff[20+FN_REFLEN];
   my_bool reconnect;
-  DBUG_ENTER("connect_to_db");
 
-  verbose_msg("-- Connecting to %s...\n", host ? host : "localhost");
-  mysql_init(&mysql_connection);
+  mysql_init(con);
   if (opt_compress)
-    mysql_options(&mysql_connection,MYSQL_OPT_COMPRESS,NullS);
+    mysql_options(con,MYSQL_OPT_COMPRESS,NullS);
 #ifdef HAVE_OPENSSL
   if (opt_use_ssl)
   {
-    mysql_ssl_set(&mysql_connection, opt_ssl_key, opt_ssl_cert, opt_ssl_ca,
+    mysql_ssl_set(con, opt_ssl_key, opt_ssl_cert, opt_ssl_ca,
                   opt_ssl_capath, opt_ssl_cipher);
-    mysql_options(&mysql_connection, MYSQL_OPT_SSL_CRL, opt_ssl_crl);
-    mysql_options(&mysql_connection, MYSQL_OPT_SSL_CRLPATH, opt_ssl_crlpath);
-    mysql_options(&mysql_connection, MARIADB_OPT_TLS_VERSION, opt_tls_version);
+    mysql_options(con, MYSQL_OPT_SSL_CRL, opt_ssl_crl);
+    mysql_options(con, MYSQL_OPT_SSL_CRLPATH, opt_ssl_crlpath);
+    mysql_options(con, MARIADB_OPT_TLS_VERSION, opt_tls_version);
   }
-  mysql_options(&mysql_connection,MYSQL_OPT_SSL_VERIFY_SERVER_CERT,
+  mysql_options(con,MYSQL_OPT_SSL_VERIFY_SERVER_CERT,
                 (char*)&opt_ssl_verify_server_cert);
 #endif
   if (opt_protocol)
-    mysql_options(&mysql_connection,MYSQL_OPT_PROTOCOL,(char*)&opt_protocol);
-  mysql_options(&mysql_connection, MYSQL_SET_CHARSET_NAME, default_charset);
+    mysql_options(con,MYSQL_OPT_PROTOCOL,(char*)&opt_protocol);
+  mysql_options(con, MYSQL_SET_CHARSET_NAME, default_charset);
 
   if (opt_plugin_dir && *opt_plugin_dir)
-    mysql_options(&mysql_connection, MYSQL_PLUGIN_DIR, opt_plugin_dir);
+    mysql_options(con, MYSQL_PLUGIN_DIR, opt_plugin_dir);
 
   if (opt_default_auth && *opt_default_auth)
-    mysql_options(&mysql_connection, MYSQL_DEFAULT_AUTH, opt_default_auth);
+    mysql_options(con, MYSQL_DEFAULT_AUTH, opt_default_auth);
 
-  mysql_options(&mysql_connection, MYSQL_OPT_CONNECT_ATTR_RESET, 0);
-  mysql_options4(&mysql_connection, MYSQL_OPT_CONNECT_ATTR_ADD,
+  mysql_options(con, MYSQL_OPT_CONNECT_ATTR_RESET, 0);
+  mysql_options4(con, MYSQL_OPT_CONNECT_ATTR_ADD,
                  "program_name", "mysqldump");
-  mysql= &mysql_connection;          /* So we can mysql_close() it properly */
-  if (!mysql_real_connect(&mysql_connection,host,user,passwd,
+  if (!mysql_real_connect(con,host,user,passwd,
                           NULL,opt_mysql_port,opt_mysql_unix_port, 0))
   {
-    DB_error(&mysql_connection, "when trying to connect");
-    DBUG_RETURN(1);
+    DB_error(con, "when trying to connect");
+    return 1;
   }
-  if ((mysql_get_server_version(&mysql_connection) < 40100) ||
-      (opt_compatible_mode & 3))
-  {
-    /* Don't dump SET NAMES with a pre-4.1 server (bug#7997).  */
-    opt_set_charset= 0;
-
-    /* Don't switch charsets for 4.1 and earlier.  (bug#34192). */
-    server_supports_switching_charsets= FALSE;
-  } 
   /*
     As we're going to set SQL_MODE, it would be lost on reconnect, so we
     cannot reconnect.
   */
   reconnect= 0;
-  mysql_options(&mysql_connection, MYSQL_OPT_RECONNECT, &reconnect);
+  mysql_options(con, MYSQL_OPT_RECONNECT, &reconnect);
   my_snprintf(buff, sizeof(buff), "/*!40100 SET @@SQL_MODE='%s' */",
               compatible_mode_normal_str);
-  if (mysql_query_with_error_report(mysql, 0, buff))
-    DBUG_RETURN(1);
+  if (mysql_query_with_error_report(con, 0, buff))
+    return 1;
   /*
     set time_zone to UTC to allow dumping date types between servers with
     different time zone settings
@@ -2074,9 +2102,30 @@ static int connect_to_db(char *host, char *user,char *passwd)
   if (opt_tz_utc)
   {
     my_snprintf(buff, sizeof(buff), "/*!40103 SET TIME_ZONE='+00:00' */");
-    if (mysql_query_with_error_report(mysql, 0, buff))
-      DBUG_RETURN(1);
+    if (mysql_query_with_error_report(con, 0, buff))
+      return 1;
   }
+  return 0;
+}
+
+
+static int connect_to_db(char *host, char *user,char *passwd)
+{
+  DBUG_ENTER("connect_to_db");
+
+  verbose_msg("-- Connecting to %s...\n", host ? host : "localhost");
+  mysql= &mysql_connection;          /* So we can mysql_close() it properly */
+  if (open_connection(&mysql_connection, host, user, passwd))
+    DBUG_RETURN(1);
+  if ((mysql_get_server_version(&mysql_connection) < 40100) ||
+      (opt_compatible_mode & 3))
+  {
+    /* Don't dump SET NAMES with a pre-4.1 server (bug#7997).  */
+    opt_set_charset= 0;
+
+    /* Don't switch charsets for 4.1 and earlier.  (bug#34192). */
+    server_supports_switching_charsets= FALSE;
+  } 
   DBUG_RETURN(0);
 } /* connect_to_db */
 
@@ -4079,6 +4128,472 @@ static void vers_append_system_time(DYNAMIC_STRING* query_string)
 }
 
 
+/*
+  Make the name of a file of --tab for the data of a table, and delete an
+  old file of that name, as SELECT ... INTO OUTFILE does not overwrite it.
+
+  SYNOPSIS
+    tab_file_name()
+    filename  buffer of FN_REFLEN bytes for the name, in unix format
+    table     name of the table
+    chunk     number of the chunk of --parallel, or 0 for the whole table
+*/
+
+static void tab_file_name(char *filename, const char *table, uint chunk)
+{
+  char tmp_path[FN_REFLEN], name[NAME_LEN + 20];
+  /*
+    Convert the path to native os format
+    and resolve to the full filepath.
+  */
+  convert_dirname(tmp_path,path,NullS);
+  my_load_path(tmp_path, tmp_path, NULL);
+  if (chunk)
+  {
+    my_snprintf(name, sizeof(name), "%s.%05u.txt", table, chunk);
+    fn_format(filename, name, tmp_path, "", MYF(MY_UNPACK_FILENAME));
+  }
+  else
+    fn_format(filename, table, tmp_path, ".txt", MYF(MY_UNPACK_FILENAME));
+
+  /* Must delete the file that 'INTO OUTFILE' will write to */
+  my_delete(filename, MYF(0));
+
+  /* convert to a unix path name to stick into the query */
+  to_unix_path(filename);
+}
+
+
+/*
+  Build the SELECT ... INTO OUTFILE query of --tab
+
+  SYNOPSIS
+    build_outfile_query()
+    query         the query is appended here
+    filename      the file to write
+    result_table  quoted name of the table
+    versioned     whether the table is system versioned
+    cond          the condition of --where, or NULL
+    range         the condition of a chunk of --parallel, or NULL
+*/
+
+static void build_outfile_query(DYNAMIC_STRING *query_string,
+                                const char *filename,
+                                const char *result_table, my_bool versioned,
+                                const char *cond, const char *range)
+{
+  dynstr_append_checked(query_string, "SELECT /*!40001 SQL_NO_CACHE */ ");
+  dynstr_append_checked(query_string, select_field_names.str);
+  dynstr_append_checked(query_string, " INTO OUTFILE '");
+  dynstr_append_checked(query_string, filename);
+  dynstr_append_checked(query_string, "'");
+
+  dynstr_append_checked(query_string, " /*!50138 CHARACTER SET ");
+  dynstr_append_checked(query_string, default_charset == mysql_universal_client_charset ?
+                                      my_charset_bin.coll_name.str : /* backward compatibility */
+                                      default_charset);
+  dynstr_append_checked(query_string, " */");
+
+  if (fields_terminated || enclosed || opt_enclosed || escaped)
+    dynstr_append_checked(query_string, " FIELDS");
+
+  add_load_option(query_string, " TERMINATED BY ", fields_terminated);
+  add_load_option(query_string, " ENCLOSED BY ", enclosed);
+  add_load_option(query_string, " OPTIONALLY ENCLOSED BY ", opt_enclosed);
+  add_load_option(query_string, " ESCAPED BY ", escaped);
+  add_load_option(query_string, " LINES TERMINATED BY ", lines_terminated);
+
+  if (opt_header)
+  {
+    dynstr_append_checked(query_string, " FROM ( SELECT ");
+    if (order_by)
+      dynstr_append_checked(query_string, " 0 AS `_$is_data_row$_`,");
+    dynstr_append_checked(query_string, select_field_names_for_header.str);
+    dynstr_append_checked(query_string, " UNION ALL SELECT ");
+    if (order_by)
+      dynstr_append_checked(query_string, "1 AS `_$is_data_row$_`,");
+    dynstr_append_checked(query_string, select_field_names.str);
+  }
+  dynstr_append_checked(query_string, " FROM ");
+  dynstr_append_checked(query_string, result_table);
+
+  if (versioned)
+    vers_append_system_time(query_string);
+
+  if (cond && range)
+  {
+    dynstr_append_checked(query_string, " WHERE (");
+    dynstr_append_checked(query_string, cond);
+    dynstr_append_checked(query_string, ") AND ");
+    dynstr_append_checked(query_string, range);
+  }
+  else if (cond || range)
+  {
+    dynstr_append_checked(query_string, " WHERE ");
+    dynstr_append_checked(query_string, cond ? cond : range);
+  }
+  if (opt_header)
+    dynstr_append_checked(query_string, ") s");
+
+  if (order_by)
+  {
+    if (opt_header)
+      dynstr_append_checked(query_string, " ORDER BY `_$is_data_row$_`,");
+    else
+      dynstr_append_checked(query_string, " ORDER BY ");
+    dynstr_append_checked(query_string, order_by);
+  }
+}
+
+
+/*
+  --parallel: the data of the tables is dumped by worker threads, each
+  with its own connection. The main thread writes the table structures and
+  queues one SELECT ... INTO OUTFILE query per table, or per range of the
+  primary key of a large table.
+*/
+
+typedef struct st_dump_job
+{
+  struct st_dump_job *next;
+  char *query;
+  char table[NAME_LEN * 4 + 8];
+} DUMP_JOB;
+
+static MYSQL *dump_worker_connections;
+static pthread_t *dump_worker_threads;
+static uint dump_worker_count;
+static pthread_mutex_t dump_job_mutex;
+static pthread_cond_t dump_job_cond;
+static DUMP_JOB *dump_job_first, **dump_job_last= &dump_job_first;
+static my_bool dump_jobs_done, dump_jobs_failed;
+
+
+static pthread_handler_t dump_worker(void *arg)
+{
+  MYSQL *con= (MYSQL*) arg;
+  mysql_thread_init();
+
+  for (;;)
+  {
+    DUMP_JOB *job;
+    pthread_mutex_lock(&dump_job_mutex);
+    while (!(job= dump_job_first) && !dump_jobs_done)
+      pthread_cond_wait(&dump_job_cond, &dump_job_mutex);
+    if (job && !(dump_job_first= job->next))
+      dump_job_last= &dump_job_first;
+    pthread_mutex_unlock(&dump_job_mutex);
+    if (!job)
+      break;
+
+    verbose_msg("-- Dumping data of table %s...\n", job->table);
+    /*
+      The query is skipped after an error, unless --force was given.
+      ROLLBACK TO SAVEPOINT releases the metadata lock on the table, see
+      dump_all_tables_in_db().
+    */
+    if (!dump_jobs_failed &&
+        (mysql_query(con, job->query) ||
+         mysql_query(con, "ROLLBACK TO SAVEPOINT sp")))
+    {
+      pthread_mutex_lock(&dump_job_mutex);
+      fprintf(stderr, "%s: Got error: %d: \"%s\" when dumping table %s\n",
+              my_progname_short, mysql_errno(con), mysql_error(con),
+              job->table);
+      fflush(stderr);
+      if (!first_error)
+        first_error= EX_MYSQLERR;
+      if (!ignore_errors)
+        dump_jobs_failed= 1;
+      pthread_mutex_unlock(&dump_job_mutex);
+    }
+    my_free(job);
+  }
+
+  mysql_thread_end();
+  return 0;
+}
+
+
+/*
+  Open the connections of --parallel and start a consistent snapshot in
+  each of them. The caller holds FLUSH TABLES WITH READ LOCK, so that all
+  the snapshots see the same data.
+*/
+
+static int open_dump_workers()
+{
+  uint i;
+  char query[48];
+  DBUG_ENTER("open_dump_workers");
+
+  if (!(dump_worker_connections= (MYSQL*)
+        my_malloc(PSI_NOT_INSTRUMENTED, opt_parallel * sizeof(MYSQL),
+                  MYF(MY_WME | MY_ZEROFILL))) ||
+      !(dump_worker_threads= (pthread_t*)
+        my_malloc(PSI_NOT_INSTRUMENTED, opt_parallel * sizeof(pthread_t),
+                  MYF(MY_WME))))
+    DBUG_RETURN(1);
+  pthread_mutex_init(&dump_job_mutex, NULL);
+  pthread_cond_init(&dump_job_cond, NULL);
+
+  my_snprintf(query, sizeof(query), "/*!100100 SET @@MAX_STATEMENT_TIME=%f */",
+              opt_max_statement_time);
+  for (i= 0; i < opt_parallel; i++)
+  {
+    MYSQL *con= &dump_worker_connections[i];
+    verbose_msg("-- Opening connection %u of --parallel...\n", i + 1);
+    if (open_connection(con, current_host, current_user, opt_password) ||
+        mysql_query_with_error_report(con, 0, query) ||
+        mysql_query_with_error_report(con, 0,
+                                      "/*!100100 SET WAIT_TIMEOUT=DEFAULT */") ||
+        start_transaction(con) ||
+        mysql_query_with_error_report(con, 0, "SAVEPOINT sp"))
+    {
+      mysql_close(con);
+      break;
+    }
+  }
+
+  for (; dump_worker_count < i; dump_worker_count++)
+  {
+    if (pthread_create(&dump_worker_threads[dump_worker_count], NULL,
+                       dump_worker,
+                       &dump_worker_connections[dump_worker_count]))
+    {
+      fprintf(stderr, "%s: Could not create thread\n", my_progname_short);
+      break;
+    }
+  }
+  DBUG_RETURN(dump_worker_count < opt_parallel);
+}
+
+
+/* Wait until the queued data has been dumped, and close the connections */
+
+static void close_dump_workers()
+{
+  uint i;
+  if (!dump_worker_connections)
+    return;
+
+  pthread_mutex_lock(&dump_job_mutex);
+  dump_jobs_done= 1;
+  pthread_cond_broadcast(&dump_job_cond);
+  pthread_mutex_unlock(&dump_job_mutex);
+
+  for (i= 0; i < dump_worker_count; i++)
+    pthread_join(dump_worker_threads[i], NULL);
+  for (i= 0; i < opt_parallel; i++)
+    if (dump_worker_connections[i].net.vio)
+      mysql_close(&dump_worker_connections[i]);
+
+  pthread_mutex_destroy(&dump_job_mutex);
+  pthread_cond_destroy(&dump_job_cond);
+  my_free(dump_worker_threads);
+  my_free(dump_worker_connections);
+  dump_worker_connections= 0;
+  dump_worker_count= 0;
+}
+
+
+static void queue_dump_job(const char *table, DYNAMIC_STRING *query)
+{
+  DUMP_JOB *job;
+  if (!(job= (DUMP_JOB*) my_malloc(PSI_NOT_INSTRUMENTED,
+                                   sizeof(DUMP_JOB) + query->length + 1,
+                                   MYF(MY_WME))))
+    die(EX_MYSQLERR, "Couldn't allocate memory");
+  job->next= 0;
+  job->query= (char*) (job + 1);
+  memcpy(job->query, query->str, query->length + 1);
+  strmake_buf(job->table, table);
+
+  pthread_mutex_lock(&dump_job_mutex);
+  *dump_job_last= job;
+  dump_job_last= &job->next;
+  pthread_cond_signal(&dump_job_cond);
+  pthread_mutex_unlock(&dump_job_mutex);
+}
+
+
+/*
+  Find the ranges of the primary key in which a table is dumped with
+  --parallel. Only a primary key on a single integer column is split.
+
+  SYNOPSIS
+    get_chunk_bounds()
+    db            name of the database
+    table         name of the table
+    qualified     quoted name of the table with its database
+    pk            buffer for the quoted name of the key column
+    bounds        the first key value of each range except the first one;
+                  to be freed by the caller
+    is_unsigned   set if the key column is unsigned
+
+  RETURN
+    the number of ranges; 1 if the table is not split
+*/
+
+static uint get_chunk_bounds(const char *db, const char *table,
+                             const char *qualified, char *pk,
+                             ulonglong **bounds, my_bool *is_unsigned)
+{
+  char query[QUERY_LENGTH + NAME_LEN * 8], name_buff[NAME_LEN * 2 + 3],
+       db_buff[NAME_LEN * 2 + 3], *key_column;
+  MYSQL_RES *res;
+  MYSQL_ROW row;
+  MYSQL_FIELD *field;
+  ulonglong rows, lo, hi, span;
+  uint chunks= 1, i;
+
+  *bounds= 0;
+  my_snprintf(query, sizeof(query),
+              "SHOW KEYS FROM %s WHERE Key_name='PRIMARY'", qualified);
+  if (mysql_query_with_error_report(mysql, &res, query))
+    return 1;
+  if (mysql_num_rows(res) != 1 || !(row= mysql_fetch_row(res)))
+  {
+    mysql_free_result(res);
+    return 1;
+  }
+  key_column= quote_name(row[4], name_buff, 1);
+  strmov(pk, key_column);
+  mysql_free_result(res);
+
+  mysql_real_escape_string(mysql, name_buff, table, (ulong) strlen(table));
+  mysql_real_escape_string(mysql, db_buff, db, (ulong) strlen(db));
+  my_snprintf(query, sizeof(query),
+              "SELECT MIN(%s), MAX(%s), (SELECT TABLE_ROWS FROM "
+              "INFORMATION_SCHEMA.TABLES WHERE TABLE_SCHEMA='%s' AND "
+              "TABLE_NAME='%s') FROM %s",
+              pk, pk, db_buff, name_buff, qualified);
+  if (mysql_query_with_error_report(mysql, &res, query))
+    return 1;
+  row= mysql_fetch_row(res);
+  field= mysql_fetch_field(res);
+  if (!row || !row[0] || !row[1] || !row[2] ||
+      (field->type != MYSQL_TYPE_TINY && field->type != MYSQL_TYPE_SHORT &&
+       field->type != MYSQL_TYPE_INT24 && field->type != MYSQL_TYPE_LONG &&
+       field->type != MYSQL_TYPE_LONGLONG))
+    goto end;
+
+  /*
+    Signed values are mapped to unsigned ones of the same order by
+    flipping the sign bit.
+  */
+  *is_unsigned= MY_TEST(field->flags & UNSIGNED_FLAG);
+  if (*is_unsigned)
+  {
+    lo= strtoull(row[0], NULL, 10);
+    hi= strtoull(row[1], NULL, 10);
+  }
+  else
+  {
+    lo= (ulonglong) strtoll(row[0], NULL, 10) ^ (1ULL << 63);
+    hi= (ulonglong) strtoll(row[1], NULL, 10) ^ (1ULL << 63);
+  }
+  rows= strtoull(row[2], NULL, 10);
+  span= hi - lo;
+
+  chunks= (uint) MY_MIN((rows + opt_chunk_rows - 1) / opt_chunk_rows, 99999);
+  /* Every range has at least one key value */
+  if (span < chunks)
+    chunks= (uint) span;
+  if (chunks < 2)
+  {
+    chunks= 1;
+    goto end;
+  }
+
+  if (!(*bounds= (ulonglong*) my_malloc(PSI_NOT_INSTRUMENTED,
+                                        chunks * sizeof(ulonglong),
+                                        MYF(MY_WME))))
+    die(EX_MYSQLERR, "Couldn't allocate memory");
+  for (i= 1; i < chunks; i++)
+    (*bounds)[i - 1]= lo + span / chunks * i +
+                      (span % chunks) * i / chunks;
+
+end:
+  mysql_free_result(res);
+  return chunks;
+}
+
+
+/*
+  Queue the dump of the data of a table with --parallel
+
+  SYNOPSIS
+    queue_table_data()
+    table         name of the table
+    db            name of the database
+    result_table  quoted name of the table
+    versioned     whether the table is system versioned
+*/
+
+static void queue_table_data(const char *table, const char *db,
+                             const char *result_table, my_bool versioned)
+{
+  char filename[FN_REFLEN], db_buff[NAME_LEN * 2 + 3],
+       qualified[NAME_LEN * 4 + 8], pk[NAME_LEN * 2 + 3],
+       range[NAME_LEN * 4 + 60];
+  DYNAMIC_STRING query_string;
+  ulonglong *bounds;
+  my_bool is_unsigned= 0;
+  uint chunks, i;
+
+  strxmov(qualified, quote_name(db, db_buff, 1), ".", result_table, NullS);
+  chunks= get_chunk_bounds(db, table, qualified, pk, &bounds, &is_unsigned);
+  init_dynamic_string_checked(&query_string, "", 1024, 1024);
+
+  if (chunks == 1)
+  {
+    tab_file_name(filename, table, 0);
+    build_outfile_query(&query_string, filename, qualified, versioned,
+                        where, NULL);
+    queue_dump_job(qualified, &query_string);
+  }
+  else
+  {
+    verbose_msg("-- Splitting table %s into %u ranges of %s\n",
+                qualified, chunks, pk);
+    /* Do not leave a file of an earlier dump that was not split */
+    tab_file_name(filename, table, 0);
+    for (i= 0; i < chunks; i++)
+    {
+      char lo[22], hi[22], *end= range;
+      if (i)
+      {
+        if (is_unsigned)
+          longlong10_to_str((longlong) bounds[i - 1], lo, 10);
+        else
+          longlong10_to_str((longlong) (bounds[i - 1] ^ (1ULL << 63)), lo,
+                            -10);
+        end= strxmov(end, pk, ">=", lo, NullS);
+      }
+      if (i + 1 < chunks)
+      {
+        if (is_unsigned)
+          longlong10_to_str((longlong) bounds[i], hi, 10);
+        else
+          longlong10_to_str((longlong) (bounds[i] ^ (1ULL << 63)), hi, -10);
+        end= strxmov(end, i ? " AND " : "", pk, "<", hi, NullS);
+      }
+      tab_file_name(filename, table, i + 1);
+      dynstr_set_checked(&query_string, "");
+      build_outfile_query(&query_string, filename, qualified, versioned,
+                          where, range);
+      queue_dump_job(qualified, &query_string);
+    }
+  }
+
+  my_free(bounds);
+  my_free(order_by);
+  order_by= 0;
+  dynstr_free(&query_string);
+}
+
+
 /*
 
  SYNOPSIS
@@ -4183,79 +4698,20 @@ static void dump_table(const char *table, const char *db, const uchar *hash_key,
 
   if (path)
   {
-    char filename[FN_REFLEN], tmp_path[FN_REFLEN];
-    /*
-      Convert the path to native os format
-      and resolve to the full filepath.
-    */
-    convert_dirname(tmp_path,path,NullS);    
-    my_load_path(tmp_path, tmp_path, NULL);
-    fn_format(filename, table, tmp_path, ".txt", MYF(MY_UNPACK_FILENAME));
-
-    /* Must delete the file that 'INTO OUTFILE' will write to */
-    my_delete(filename, MYF(0));
-
-    /* convert to a unix path name to stick into the query */
-    to_unix_path(filename);
-
-    /* now build the query string */
-
-    dynstr_append_checked(&query_string, "SELECT /*!40001 SQL_NO_CACHE */ ");
-    dynstr_append_checked(&query_string, select_field_names.str);
-    dynstr_append_checked(&query_string, " INTO OUTFILE '");
-    dynstr_append_checked(&query_string, filename);
-    dynstr_append_checked(&query_string, "'");
+    char filename[FN_REFLEN];
 
-    dynstr_append_checked(&query_string, " /*!50138 CHARACTER SET ");
-    dynstr_append_checked(&query_string, default_charset == mysql_universal_client_charset ?
-                                         my_charset_bin.coll_name.str : /* backward compatibility */
-                                         default_charset);
-    dynstr_append_checked(&query_string, " */");
-
-    if (fields_terminated || enclosed || opt_enclosed || escaped)
-      dynstr_append_checked(&query_string, " FIELDS");
-
-    add_load_option(&query_string, " TERMINATED BY ", fields_terminated);
-    add_load_option(&query_string, " ENCLOSED BY ", enclosed);
-    add_load_option(&query_string, " OPTIONALLY ENCLOSED BY ", opt_enclosed);
-    add_load_option(&query_string, " ESCAPED BY ", escaped);
-    add_load_option(&query_string, " LINES TERMINATED BY ", lines_terminated);
-
-    if (opt_header)
-    {
-      dynstr_append_checked(&query_string, " FROM ( SELECT ");
-      if (order_by)
-        dynstr_append_checked(&query_string, " 0 AS `_$is_data_row$_`,");
-      dynstr_append_checked(&query_string, select_field_names_for_header.str);
-      dynstr_append_checked(&query_string, " UNION ALL SELECT ");
-      if (order_by)
-        dynstr_append_checked(&query_string, "1 AS `_$is_data_row$_`,");
-      dynstr_append_checked(&query_string, select_field_names.str);
-    }
-    dynstr_append_checked(&query_string, " FROM ");
-    dynstr_append_checked(&query_string, result_table);
-
-    if (versioned)
-      vers_append_system_time(&query_string);
-
-    if (where)
+    if (opt_parallel > 1)
     {
-      dynstr_append_checked(&query_string, " WHERE ");
-      dynstr_append_checked(&query_string, where);
+      queue_table_data(table, db, result_table, versioned);
+      dynstr_free(&query_string);
+      DBUG_VOID_RETURN;
     }
-    if (opt_header)
-      dynstr_append_checked(&query_string, ") s");
 
-    if (order_by)
-    {
-      if (opt_header)
-        dynstr_append_checked(&query_string, " ORDER BY `_$is_data_row$_`,");
-      else
-        dynstr_append_checked(&query_string, " ORDER BY ");
-      dynstr_append_checked(&query_string, order_by);
-      my_free(order_by);
-      order_by= 0;
-    }
+    tab_file_name(filename, table, 0);
+    build_outfile_query(&query_string, filename, result_table, versioned,
+                        where, NULL);
+    my_free(order_by);
+    order_by= 0;
 
     if (mysql_real_query(mysql, query_string.str, (ulong)query_string.length))
     {
@@ -7153,7 +7609,7 @@ int main(int argc, char **argv)
   }
 
   if ((opt_lock_all_tables || (opt_master_data && !consistent_binlog_pos) ||
-       (opt_single_transaction && flush_logs)) &&
+       (opt_single_transaction && flush_logs) || opt_parallel > 1) &&
       do_flush_tables_read_lock(mysql))
     goto err;
 
@@ -7187,6 +7643,9 @@ int main(int argc, char **argv)
       goto err;
   }
 
+  if (opt_parallel > 1 && open_dump_workers())
+    goto err;
+
   if (opt_single_transaction && start_transaction(mysql))
     goto err;
 
@@ -7270,6 +7729,13 @@ int main(int argc, char **argv)
   if (opt_slave_apply && add_slave_statements())
     goto err;
 
+  if (opt_parallel > 1)
+  {
+    close_dump_workers();
+    if (first_error)
+      goto err;
+  }
+
   /* ensure dumped data flushed */
   if (md_result_file && fflush(md_result_file))
   {
@@ -7292,6 +7758,7 @@ int main(int argc, char **argv)
   if (opt_slave_data)
     do_start_slave_sql(mysql);
 
+  close_dump_workers();
   dbDisconnect(current_host);
   if (!path)
     write_footer(md_result_file);
@@ -350,6 +350,30 @@ static int get_options(int *argc, char ***argv)
   }
   current_db= *((*argv)++);
   (*argc)--;
+  if (opt_delete)
+  {
+    /*
+      The files of a table split by mariadb-dump --parallel are loaded
+      one by one, and each DELETE would remove the rows of the files
+      loaded before it
+    */
+    char table[FN_REFLEN], other[FN_REFLEN];
+    int i, j;
+    for (i= 0; i < *argc; i++)
+    {
+      fn_format(table, (*argv)[i], "", "", 1 | 2);
+      for (j= 0; j < i; j++)
+      {
+        fn_format(other, (*argv)[j], "", "", 1 | 2);
+        if (!strcmp(table, other))
+        {
+          fprintf(stderr, "You can't use --delete (-d) with several files "
+                  "of table %s.\n", table);
+          return(1);
+        }
+      }
+    }
+  }
   if (tty_password)
     opt_password=get_tty_password(NullS);
   return(0);
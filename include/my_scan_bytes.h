@@ -0,0 +1,166 @@
+/* Copyright (c) 2026, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+#ifndef MY_SCAN_BYTES_INCLUDED
+#define MY_SCAN_BYTES_INCLUDED
+
+/*
+  Search of a buffer for the first of a small set of bytes, like the field
+  and line terminators, quotes and escapes of delimited text files.
+
+  The buffer is compared with every byte of the set 32 bytes at a time with
+  SSE2 on x86-64, 16 bytes at a time with NEON on ARMv8 and 8 bytes at a
+  time in a general purpose register elsewhere. The results for all the
+  bytes of the set are combined into one bit mask, in which the lowest set
+  bit is the position of the first match.
+*/
+
+#include <my_bit.h>
+#include <string.h>
+
+#if defined __SSE2__ || defined _M_X64
+#include <emmintrin.h>
+#define MY_SCAN_BYTES_SSE2
+#elif defined __aarch64__ && defined __ARM_NEON
+#include <arm_neon.h>
+#define MY_SCAN_BYTES_NEON
+#endif
+
+C_MODE_START
+
+#define MY_BYTE_SET_MAX 4
+
+typedef struct st_my_byte_set
+{
+  /* the bytes; the unused entries repeat the first one */
+  uchar bytes[MY_BYTE_SET_MAX];
+  uint count;
+} MY_BYTE_SET;
+
+/*
+  Initialize a set of bytes.
+
+  @param set     the set
+  @param values  up to MY_BYTE_SET_MAX values; the values that are not
+                 in the range 0..255, like the INT_MAX that stands for a
+                 missing terminator, are skipped
+  @param count   number of values
+*/
+static inline void my_byte_set_init(MY_BYTE_SET *set, const int *values,
+                                    uint count)
+{
+  uint i;
+  DBUG_ASSERT(count <= MY_BYTE_SET_MAX);
+  set->count= 0;
+  set->bytes[0]= 0;
+  for (i= 0; i < count; i++)
+    if (values[i] >= 0 && values[i] <= 255)
+      set->bytes[set->count++]= (uchar) values[i];
+  for (i= set->count; i < MY_BYTE_SET_MAX; i++)
+    set->bytes[i]= set->bytes[0];
+}
+
+/*
+  Find the first byte of a set in a buffer.
+
+  @param set  the bytes to search for
+  @param ptr  start of the buffer
+  @param end  end of the buffer
+
+  @return pointer to the first byte of the set, or end if there is none
+*/
+static inline const uchar *my_scan_bytes(const MY_BYTE_SET *set,
+                                         const uchar *ptr, const uchar *end)
+{
+  const uchar b0= set->bytes[0], b1= set->bytes[1], b2= set->bytes[2],
+              b3= set->bytes[3];
+
+  if (!set->count)
+    return end;
+
+#if defined MY_SCAN_BYTES_SSE2
+  {
+    const __m128i v0= _mm_set1_epi8((char) b0), v1= _mm_set1_epi8((char) b1),
+                  v2= _mm_set1_epi8((char) b2), v3= _mm_set1_epi8((char) b3);
+#define MY_SCAN_BYTES_EQ(x)                                              \
+    _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, v0), _mm_cmpeq_epi8(x, v1)), \
+                 _mm_or_si128(_mm_cmpeq_epi8(x, v2), _mm_cmpeq_epi8(x, v3)))
+    for (; end - ptr >= 32; ptr+= 32)
+    {
+      const __m128i lo= _mm_loadu_si128((const __m128i*) ptr);
+      const __m128i hi= _mm_loadu_si128((const __m128i*) (ptr + 16));
+      const uint32 mask= (uint32) _mm_movemask_epi8(MY_SCAN_BYTES_EQ(lo)) |
+        (uint32) _mm_movemask_epi8(MY_SCAN_BYTES_EQ(hi)) << 16;
+      if (mask)
+        return ptr + my_find_first_bit(mask);
+    }
+    if (end - ptr >= 16)
+    {
+      const __m128i x= _mm_loadu_si128((const __m128i*) ptr);
+      const uint32 mask= (uint32) _mm_movemask_epi8(MY_SCAN_BYTES_EQ(x));
+      if (mask)
+        return ptr + my_find_first_bit(mask);
+      ptr+= 16;
+    }
+#undef MY_SCAN_BYTES_EQ
+  }
+#elif defined MY_SCAN_BYTES_NEON
+  {
+    const uint8x16_t v0= vdupq_n_u8(b0), v1= vdupq_n_u8(b1),
+                     v2= vdupq_n_u8(b2), v3= vdupq_n_u8(b3);
+    for (; end - ptr >= 16; ptr+= 16)
+    {
+      const uint8x16_t x= vld1q_u8(ptr);
+      const uint8x16_t eq= vorrq_u8(vorrq_u8(vceqq_u8(x, v0), vceqq_u8(x, v1)),
+                                    vorrq_u8(vceqq_u8(x, v2), vceqq_u8(x, v3)));
+      /* Narrow the 0x00/0xff bytes to 4 bits each */
+      const ulonglong mask= vget_lane_u64(vreinterpret_u64_u8(
+        vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+      if (mask)
+        return ptr + (my_find_first_bit(mask) >> 2);
+    }
+  }
+#else
+  {
+    /*
+      A byte of x ^ (b * 0x0101010101010101) is zero where the byte is b,
+      and (y - 0x01..01) & ~y & 0x80..80 is nonzero if y has a zero byte.
+    */
+    const ulonglong ones= 0x0101010101010101ULL, highs= 0x8080808080808080ULL;
+    const ulonglong w0= b0 * ones, w1= b1 * ones, w2= b2 * ones, w3= b3 * ones;
+    for (; end - ptr >= 8; ptr+= 8)
+    {
+      ulonglong w, x0, x1, x2, x3;
+      memcpy(&w, ptr, 8);
+      x0= w ^ w0;
+      x1= w ^ w1;
+      x2= w ^ w2;
+      x3= w ^ w3;
+      if (((x0 - ones) & ~x0 & highs) | ((x1 - ones) & ~x1 & highs) |
+          ((x2 - ones) & ~x2 & highs) | ((x3 - ones) & ~x3 & highs))
+        break;
+    }
+  }
+#endif
+
+  for (; ptr < end; ptr++)
+    if (*ptr == b0 || *ptr == b1 || *ptr == b2 || *ptr == b3)
+      return ptr;
+  return end;
+}
+
+C_MODE_END
+
+#endif /* MY_SCAN_BYTES_INCLUDED */
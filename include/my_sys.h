@@ -916,6 +916,15 @@ extern void *my_az_allocator(void *dummy, unsigned int items, unsigned int size)
 extern void my_az_free(void *dummy, void *address);
 extern int my_compress_buffer(uchar *dest, size_t *destLen,
                               const uchar *source, size_t sourceLen);
+typedef struct st_my_compress_stream MY_COMPRESS_STREAM;
+extern MY_COMPRESS_STREAM *my_compress_stream_init(uint level);
+extern void my_compress_stream_end(MY_COMPRESS_STREAM *stream);
+extern size_t my_compress_stream_bound(MY_COMPRESS_STREAM *stream, size_t len);
+extern my_bool my_compress_stream(MY_COMPRESS_STREAM *stream,
+                                  const uchar *packet, size_t len,
+                                  uchar *dest, size_t *complen);
+extern my_bool my_uncompress_stream(MY_COMPRESS_STREAM *stream, uchar *packet,
+                                    size_t len, size_t *complen);
 extern int packfrm(const uchar *, size_t, uchar **, size_t *);
 extern int unpackfrm(uchar **, size_t *, const uchar *);
 
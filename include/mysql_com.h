@@ -288,8 +288,14 @@ enum enum_indicator_type
 /* Do not resend metadata for prepared statements, since 10.6*/
 #define MARIADB_CLIENT_CACHE_METADATA (1ULL << 36)
 
+/*
+  With CLIENT_COMPRESS, compress the packets with a zlib stream that is
+  kept for the life of the connection, since 11.0
+*/
+#define MARIADB_CLIENT_COMPRESS_STREAM (1ULL << 37)
+
 #ifdef HAVE_COMPRESS
-#define CAN_CLIENT_COMPRESS CLIENT_COMPRESS
+#define CAN_CLIENT_COMPRESS (CLIENT_COMPRESS | MARIADB_CLIENT_COMPRESS_STREAM)
 #else
 #define CAN_CLIENT_COMPRESS 0
 #endif
@@ -329,6 +335,7 @@ enum enum_indicator_type
                            MARIADB_CLIENT_STMT_BULK_OPERATIONS |\
                            MARIADB_CLIENT_EXTENDED_METADATA|\
                            MARIADB_CLIENT_CACHE_METADATA |\
+                           MARIADB_CLIENT_COMPRESS_STREAM |\
                            CLIENT_CAN_HANDLE_EXPIRED_PASSWORDS)
 /*
   Switch off the flags that are optional and depending on build flags
@@ -336,7 +343,8 @@ enum enum_indicator_type
   on before sending to the client during the connection handshake.
 */
 #define CLIENT_BASIC_FLAGS (((CLIENT_ALL_FLAGS & ~CLIENT_SSL) \
-                                               & ~CLIENT_COMPRESS) \
+                                               & ~(CLIENT_COMPRESS | \
+                                                   MARIADB_CLIENT_COMPRESS_STREAM)) \
                                                & ~CLIENT_SSL_VERIFY_SERVER_CERT)
 
 enum mariadb_field_attr_t
@@ -34,8 +34,23 @@ struct st_net_server
   before_header_callback_fn m_before_header;
   after_header_callback_fn m_after_header;
   void *m_user_data;
+  /*
+    Compression context kept for the life of the connection, see
+    MARIADB_CLIENT_COMPRESS_STREAM. NULL if every compressed packet
+    is compressed on its own.
+  */
+  struct st_my_compress_stream *m_compress_stream;
 };
 
 typedef struct st_net_server NET_SERVER;
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+my_bool net_compress_stream_init(struct st_net *net);
+void net_compress_stream_end(struct st_net *net);
+#ifdef __cplusplus
+}
+#endif
+
 #endif
@@ -183,4 +183,161 @@ my_bool my_uncompress(uchar *packet, size_t len, size_t *complen)
   DBUG_RETURN(0);
 }
 
+/*
+  Compression of a connection with one zlib stream per direction
+
+  The packets that are compressed with my_compress() are independent of
+  each other, so every packet pays for a new compression context and
+  starts with an empty dictionary. A MY_COMPRESS_STREAM keeps a deflate
+  and an inflate stream for the life of the connection. Every packet is
+  ended with Z_SYNC_FLUSH so that the peer can uncompress it as soon as it
+  arrives, while the data of the preceding packets remains available as
+  the dictionary.
+
+  Both ends must feed the same packets, in the same order, to their
+  streams: a packet that was given to my_compress_stream() must be sent
+  compressed even if it got longer, and the receiver must give every
+  compressed packet to my_uncompress_stream().
+*/
+
+struct st_my_compress_stream
+{
+  z_stream deflate;
+  z_stream inflate;
+};
+
+
+MY_COMPRESS_STREAM *my_compress_stream_init(uint level)
+{
+  MY_COMPRESS_STREAM *stream;
+  DBUG_ENTER("my_compress_stream_init");
+
+  if (!(stream= (MY_COMPRESS_STREAM*) my_malloc(key_memory_my_compress_alloc,
+                                               sizeof(*stream),
+                                               MYF(MY_WME | MY_ZEROFILL))))
+    DBUG_RETURN(0);
+
+  stream->deflate.zalloc= stream->inflate.zalloc= (alloc_func)my_az_allocator;
+  stream->deflate.zfree= stream->inflate.zfree= (free_func)my_az_free;
+
+  if (deflateInit(&stream->deflate, (int) level) != Z_OK)
+  {
+    my_free(stream);
+    DBUG_RETURN(0);
+  }
+  if (inflateInit(&stream->inflate) != Z_OK)
+  {
+    deflateEnd(&stream->deflate);
+    my_free(stream);
+    DBUG_RETURN(0);
+  }
+  DBUG_RETURN(stream);
+}
+
+
+void my_compress_stream_end(MY_COMPRESS_STREAM *stream)
+{
+  if (stream)
+  {
+    deflateEnd(&stream->deflate);
+    inflateEnd(&stream->inflate);
+    my_free(stream);
+  }
+}
+
+
+/*
+  Maximal size of a compressed packet of 'len' bytes: the bound of
+  deflate() and the empty stored block of Z_SYNC_FLUSH
+*/
+
+size_t my_compress_stream_bound(MY_COMPRESS_STREAM *stream, size_t len)
+{
+  return (size_t) deflateBound(&stream->deflate, (uLong) len) + 16;
+}
+
+
+/*
+  Compress a packet
+
+   SYNOPSIS
+     my_compress_stream()
+     stream	Stream of the connection
+     packet	Data to compress
+     len	Length of data to compress at 'packet'
+     dest	Buffer of my_compress_stream_bound(len) bytes
+     complen	out: Length of the compressed data
+
+   RETURN
+     1   error. The stream can't be used any more
+     0   ok
+*/
+
+my_bool my_compress_stream(MY_COMPRESS_STREAM *stream, const uchar *packet,
+                           size_t len, uchar *dest, size_t *complen)
+{
+  z_stream *z= &stream->deflate;
+  size_t bound= my_compress_stream_bound(stream, len);
+  DBUG_ENTER("my_compress_stream");
+
+  z->next_in= (Bytef*) packet;
+  z->avail_in= (uInt) len;
+  z->next_out= (Bytef*) dest;
+  z->avail_out= (uInt) bound;
+
+  if (deflate(z, Z_SYNC_FLUSH) != Z_OK || z->avail_in || !z->avail_out)
+  {
+    DBUG_PRINT("error",("Can't compress packet"));
+    DBUG_RETURN(1);
+  }
+  *complen= bound - z->avail_out;
+  DBUG_RETURN(0);
+}
+
+
+/*
+  Uncompress packet that was compressed with my_compress_stream()
+
+   SYNOPSIS
+     my_uncompress_stream()
+     stream	Stream of the connection
+     packet	Compressed data. This is is replaced with the original data.
+     len	Length of compressed data
+     complen	Length of the original data; the packet buffer must be
+                big enough for it
+
+   RETURN
+     1   error
+     0   ok
+*/
+
+my_bool my_uncompress_stream(MY_COMPRESS_STREAM *stream, uchar *packet,
+                             size_t len, size_t *complen)
+{
+  z_stream *z= &stream->inflate;
+  uchar *compbuf;
+  int error;
+  DBUG_ENTER("my_uncompress_stream");
+
+  if (!(compbuf= (uchar *) my_malloc(key_memory_my_compress_alloc,
+                                     *complen, MYF(MY_WME))))
+    DBUG_RETURN(1);                             /* Not enough memory */
+
+  z->next_in= (Bytef*) packet;
+  z->avail_in= (uInt) len;
+  z->next_out= (Bytef*) compbuf;
+  z->avail_out= (uInt) *complen;
+
+  error= inflate(z, Z_SYNC_FLUSH);
+  if (error != Z_OK || z->avail_in || z->avail_out)
+  {                                             /* Probably wrong packet */
+    DBUG_PRINT("error",("Can't uncompress packet, error: %d",error));
+    my_free(compbuf);
+    DBUG_RETURN(1);
+  }
+  memcpy(packet, compbuf, *complen);
+  my_free(compbuf);
+  DBUG_RETURN(0);
+}
+
 #endif /* HAVE_COMPRESS */
@@ -0,0 +1,199 @@
+#!/usr/bin/env perl
+# Test of the join order search: optimization time against plan cost
+#
+# A star schema (a fact table joined with 4..29 dimension tables) and a
+# chain of 5..30 tables are optimized with the greedy search, with the
+# greedy search limited by optimizer_search_depth=0 and with the dynamic
+# programming search of optimizer_switch='join_order_dp=on'.
+# For every query the time of optimizing it (EXPLAIN) and the cost of the
+# chosen plan (Last_query_cost) are printed.
+
+use Cwd;
+use DBI;
+use Getopt::Long;
+use Benchmark;
+
+$opt_loop_count=1000;
+$opt_small_loop_count=20;
+$max_tables=30;
+
+$pwd = cwd(); $pwd = "." if ($pwd eq '');
+require "$pwd/bench-init.pl" || die "Can't read Configuration file: $!\n";
+
+if ($opt_small_test)
+{
+  $opt_loop_count/=10;
+  $opt_small_loop_count/=10;
+}
+
+print "Testing the join order search\n";
+print "The fact table has $opt_loop_count rows.\n\n";
+
+####
+####  Connect and start timeing
+####
+
+$dbh = $server->connect();
+$start_time=new Benchmark;
+
+if ($server->{'cmp_name'} ne "mysql")
+{
+  print "Skipping: the test needs optimizer_switch and Last_query_cost\n";
+  $dbh->disconnect;
+  end_benchmark($start_time);
+  exit(0);
+}
+
+####
+#### Create needed tables
+####
+
+goto select_test if ($opt_skip_create);
+
+print "Creating tables\n";
+$dbh->do("drop table jo_fact" . $server->{'drop_attr'});
+for ($i=1 ; $i < $max_tables ; $i++)
+{
+  $dbh->do("drop table jo_dim$i" . $server->{'drop_attr'});
+}
+
+# The fact table references every dimension table
+@fields=();
+for ($i=1 ; $i < $max_tables ; $i++)
+{
+  push(@fields,"d$i integer");
+}
+do_many($dbh,$server->create("jo_fact", \@fields, []));
+
+# The dimension tables have different sizes, so that the order matters.
+# 'next' makes the dimension tables a chain.
+for ($i=1 ; $i < $max_tables ; $i++)
+{
+  do_many($dbh,$server->create("jo_dim$i",
+                               ["id integer",
+                                "next integer",
+                                "attr integer"],
+                               ["primary key (id)"]));
+}
+
+$loop_time=new Benchmark;
+
+if ($opt_fast && $server->{transactions})
+{
+  $dbh->{AutoCommit} = 0;
+}
+
+for ($i=1 ; $i < $max_tables ; $i++)
+{
+  $rows= $i * 10;
+  for ($id=0 ; $id < $rows ; $id++)
+  {
+    $next= $id % (($i + 1) * 10);
+    do_query($dbh,"insert into jo_dim$i values ($id,$next," . ($id % 7) . ")");
+  }
+}
+
+for ($id=0 ; $id < $opt_loop_count ; $id++)
+{
+  @values=();
+  for ($i=1 ; $i < $max_tables ; $i++)
+  {
+    push(@values, $id % ($i * 10));
+  }
+  do_query($dbh,"insert into jo_fact values (" . join(",",@values) . ")");
+}
+
+if ($opt_fast && $server->{transactions})
+{
+  $dbh->commit;
+  $dbh->{AutoCommit} = 1;
+}
+
+$end_time=new Benchmark;
+print "Time to insert: " .
+    timestr(timediff($end_time, $loop_time),"all") . "\n\n";
+
+for ($i=1 ; $i < $max_tables ; $i++)
+{
+  do_query($dbh,"analyze table jo_dim$i");
+}
+do_query($dbh,"analyze table jo_fact");
+
+####
+#### Optimize the queries
+####
+
+select_test:
+
+@search_modes=(["greedy",
+                "set optimizer_search_depth=62, optimizer_switch='join_order_dp=off'"],
+               ["greedy_auto_depth",
+                "set optimizer_search_depth=0, optimizer_switch='join_order_dp=off'"],
+               ["dp",
+                "set optimizer_search_depth=62, optimizer_switch='join_order_dp=on'"]);
+
+for ($tables=5 ; $tables <= $max_tables ; $tables+=5)
+{
+  # Star: jo_fact joined with jo_dim1 .. jo_dim<tables-1>
+  @from=("jo_fact");
+  @where=("jo_dim1.attr=1");
+  for ($i=1 ; $i < $tables ; $i++)
+  {
+    push(@from,"jo_dim$i");
+    push(@where,"jo_fact.d$i=jo_dim$i.id");
+  }
+  $star="select count(*) from " . join(",",@from) . " where " .
+    join(" and ",@where);
+
+  # Chain: jo_dim1 .. jo_dim<tables> joined through 'next'
+  @from=("jo_dim1");
+  @where=("jo_dim1.attr=1");
+  for ($i=2 ; $i <= $tables ; $i++)
+  {
+    push(@from,"jo_dim$i");
+    push(@where,"jo_dim" . ($i-1) . ".next=jo_dim$i.id");
+  }
+  $chain="select count(*) from " . join(",",@from) . " where " .
+    join(" and ",@where);
+
+  foreach $query (["star", $star], ["chain", $chain])
+  {
+    foreach $mode (@search_modes)
+    {
+      do_query($dbh,$mode->[1]);
+      $loop_time=new Benchmark;
+      for ($i=0 ; $i < $opt_small_loop_count ; $i++)
+      {
+        fetch_all_rows($dbh,"explain $query->[1]");
+      }
+      $end_time=new Benchmark;
+      $sth=$dbh->prepare("show session status like 'Last_query_cost'") or
+        die $DBI::errstr;
+      $sth->execute or die $DBI::errstr;
+      ($name,$cost)=$sth->fetchrow_array;
+      $sth->finish;
+      print "time for optimize_$query->[0]_$mode->[0] " .
+        "($tables tables:$opt_small_loop_count) cost $cost: " .
+        timestr(timediff($end_time, $loop_time),"all") . "\n";
+    }
+  }
+}
+
+do_query($dbh,"set optimizer_search_depth=default, optimizer_switch=default");
+
+####
+#### End of benchmark
+####
+
+if (!$opt_skip_delete)
+{
+  do_query($dbh,"drop table jo_fact" . $server->{'drop_attr'});
+  for ($i=1 ; $i < $max_tables ; $i++)
+  {
+    do_query($dbh,"drop table jo_dim$i" . $server->{'drop_attr'});
+  }
+}
+
+$dbh->disconnect;				# close connection
+
+end_benchmark($start_time);
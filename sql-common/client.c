@@ -101,6 +101,12 @@ my_bool	net_flush(NET *net);
 #include <sql_common.h>
 #include <mysql/client_plugin.h>
 
+#if defined(MYSQL_SERVER) && !defined(EMBEDDED_LIBRARY) && defined(HAVE_COMPRESS)
+/* The server's client can compress with MARIADB_CLIENT_COMPRESS_STREAM */
+#define HAVE_COMPRESS_STREAM
+#include <mysql_com_server.h>
+#endif
+
 typedef enum {
   ALWAYS_ACCEPT,       /* heuristics is disabled, use CLIENT_LOCAL_FILES */
   WAIT_FOR_QUERY,      /* heuristics is enabled, not sending files */
@@ -732,6 +738,10 @@ void end_server(MYSQL *mysql)
     mysql_prune_stmt_list(mysql);
   }
   net_end(&mysql->net);
+#ifdef HAVE_COMPRESS_STREAM
+  my_free(mysql->net.extension);
+  mysql->net.extension= 0;
+#endif
   free_old_query(mysql);
   errno= save_errno;
   DBUG_VOID_RETURN;
@@ -2122,6 +2132,14 @@ static int send_client_reply_packet(MCPVIO_EXT *mpvio,
     int4store(buff+4, net->max_packet_size);
     buff[8]= (char) mysql->charset->number;
     bzero(buff+9, 32-9);
+#ifdef HAVE_COMPRESS_STREAM
+    if (net->extension && (mysql->client_flag & CLIENT_COMPRESS))
+    {
+      /* A client with MariaDB extensions sends them in the last 4 bytes */
+      int4store(buff, mysql->client_flag & ~CLIENT_MYSQL);
+      int4store(buff+28, MARIADB_CLIENT_COMPRESS_STREAM >> 32);
+    }
+#endif
     end= buff+32;
   }
   else
@@ -3032,6 +3050,26 @@ CLI_MYSQL_REAL_CONNECT(MYSQL *mysql,const char *host, const char *user,
                       unknown_sqlstate);        /* purecov: inspected */
       goto error;
     }
+#ifdef HAVE_COMPRESS_STREAM
+    /*
+      A MariaDB server sends its extended capabilities in the last 4 bytes.
+      The stream is set up here and used once the compression is switched on
+      after the authentication.
+    */
+    if (((client_flag | mysql->options.client_flag) & CLIENT_COMPRESS) &&
+        (mysql->server_capabilities & CLIENT_COMPRESS) &&
+        !(mysql->server_capabilities & CLIENT_MYSQL) &&
+        (uint4korr(end+14) & (MARIADB_CLIENT_COMPRESS_STREAM >> 32)))
+    {
+      if (!(net->extension= my_malloc(key_memory_MYSQL, sizeof(NET_SERVER),
+                                      MYF(MY_ZEROFILL))) ||
+          net_compress_stream_init(net))
+      {
+        set_mysql_error(mysql, CR_OUT_OF_MEMORY, unknown_sqlstate);
+        goto error;
+      }
+    }
+#endif
   }
   end+= 18;
 
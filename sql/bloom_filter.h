@@ -0,0 +1,115 @@
+#ifndef BLOOM_FILTER_INCLUDED
+#define BLOOM_FILTER_INCLUDED
+
+/* Copyright (c) 2026, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+#include "my_sys.h"
+#include <string.h>
+
+/*
+  Bloom filter (Bloom 1970) over 64-bit hash values
+
+  The filter is an array of bits in which HASHES bits, picked by the hash
+  of a value, are set for every added value. A value that was added is
+  always reported as possibly contained. A value that was not added is
+  reported with a probability of about (1 - exp(-HASHES/BITS_PER_VALUE))^HASHES,
+  that is 0.5% when the filter was sized for the number of added values.
+
+  The caller supplies hash values; they are passed through a finalizer
+  here, so weak hashes are fine as long as equal values hash equally.
+*/
+
+class Bloom_filter
+{
+public:
+  static constexpr uint BITS_PER_VALUE= 16;
+  static constexpr uint HASHES= 3;
+
+  Bloom_filter() : bits(NULL), mask(0), allocated(0) {}
+
+  /*
+    Size the filter for n values and clear it.
+    Return true if the memory could not be allocated.
+  */
+  bool init(PSI_memory_key key, size_t n)
+  {
+    size_t words= 1;
+    while (words * 64 < n * BITS_PER_VALUE)
+      words*= 2;
+    if (words > allocated)
+    {
+      free();
+      if (!(bits= (ulonglong*) my_malloc(key, words * sizeof(ulonglong),
+                                         MYF(MY_THREAD_SPECIFIC))))
+        return true;
+      allocated= words;
+    }
+    memset(bits, 0, words * sizeof(ulonglong));
+    mask= words * 64 - 1;
+    return false;
+  }
+
+  void free()
+  {
+    my_free(bits);
+    bits= NULL;
+    allocated= 0;
+  }
+
+  void add(ulonglong hash)
+  {
+    hash= mix(hash);
+    const ulonglong step= (hash >> 32) | 1;
+    for (uint i= 0; i < HASHES; i++, hash+= step)
+    {
+      ulonglong bit= hash & mask;
+      bits[bit / 64]|= 1ULL << (bit % 64);
+    }
+  }
+
+  /* Return false if the value was certainly not added */
+  bool may_contain(ulonglong hash) const
+  {
+    hash= mix(hash);
+    const ulonglong step= (hash >> 32) | 1;
+    for (uint i= 0; i < HASHES; i++, hash+= step)
+    {
+      ulonglong bit= hash & mask;
+      if (!(bits[bit / 64] & (1ULL << (bit % 64))))
+        return false;
+    }
+    return true;
+  }
+
+private:
+  /* The 64-bit finalizer of MurmurHash3 */
+  static ulonglong mix(ulonglong h)
+  {
+    h^= h >> 33;
+    h*= 0xff51afd7ed558ccdULL;
+    h^= h >> 33;
+    h*= 0xc4ceb9fe1a85ec53ULL;
+    h^= h >> 33;
+    return h;
+  }
+
+  ulonglong *bits;
+  ulonglong mask;
+  /* Number of words in bits */
+  size_t allocated;
+};
+
+#endif /* BLOOM_FILTER_INCLUDED */
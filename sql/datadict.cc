@@ -267,6 +267,11 @@ bool dd_recreate_table(THD *thd, const char *db, const char *table_name)
   create_info.init();
   build_table_filename(path_buf, sizeof(path_buf) - 1,
                        db, table_name, "", 0);
+  /*
+    The table keeps its definition and tabledef_version: invalidate the
+    cached results that were read from its old rows.
+  */
+  table_version_bump(table_version_slot(db, table_name));
   /* Attempt to reconstruct the table. */
   DBUG_RETURN(ha_create_table(thd, path_buf, db, table_name, &create_info, 0, 0));
 }
@@ -2360,6 +2360,10 @@ int ha_commit_or_rollback_by_xid(XID *xid, bool commit)
   plugin_foreach(NULL, commit ? xacommit_handlerton : xarollback_handlerton,
                  MYSQL_STORAGE_ENGINE_PLUGIN, &xaop);
 
+  /* The tables changed by the transaction are not known here */
+  if (commit)
+    table_version_bump(TABLE_VERSION_ALL);
+
   return xaop.result;
 }
 
@@ -3612,6 +3616,40 @@ int handler::ha_rnd_next(uchar *buf)
   DBUG_RETURN(result);
 }
 
+int handler::ha_sample_next(uchar *buf)
+{
+  int result;
+  DBUG_ENTER("handler::ha_sample_next");
+  DBUG_ASSERT(table_share->tmp_table != NO_TMP_TABLE ||
+              m_lock_type != F_UNLCK);
+  DBUG_ASSERT(inited == RND);
+
+  do
+  {
+    TABLE_IO_WAIT(tracker, PSI_TABLE_FETCH_ROW, MAX_KEY, result,
+      { result= sample_next(buf); })
+    if (result != HA_ERR_RECORD_DELETED)
+      break;
+    status_var_increment(table->in_use->status_var.ha_read_rnd_deleted_count);
+  } while (!table->in_use->check_killed(1));
+
+  if (result == HA_ERR_RECORD_DELETED)
+    result= HA_ERR_ABORTED_BY_USER;
+  else
+  {
+    if (!result)
+    {
+      update_rows_read();
+      if (table->vfield && buf == table->record[0])
+        table->update_virtual_fields(this, VCOL_UPDATE_FOR_READ);
+    }
+    increment_statistics(&SSV::ha_read_rnd_next_count);
+  }
+
+  table->status=result ? STATUS_NOT_FOUND: 0;
+  DBUG_RETURN(result);
+}
+
 int handler::ha_rnd_pos(uchar *buf, uchar *pos)
 {
   int result;
@@ -5189,6 +5227,13 @@ void handler::mark_trx_read_write_internal()
     if (table_share == NULL || table_share->tmp_table == NO_TMP_TABLE)
       ha_info->set_trx_read_write();
   }
+  /*
+    Invalidate the cached results that were read from the table. DDL done
+    through a handler that is not open changes the table definition instead.
+  */
+  if (table && table_share && table_share->tmp_table == NO_TMP_TABLE)
+    table_version_bump_changed(ha_thd(), table_share,
+                               referenced_by_foreign_key());
 }
 
 
@@ -7348,6 +7393,9 @@ int handler::ha_reset()
   table->default_column_bitmaps();
   pushed_cond= NULL;
   tracker= NULL;
+  /* The changes of a non-transactional table are complete */
+  if (mark_trx_read_write_done && table_share->tmp_table == NO_TMP_TABLE)
+    table_version_bump(table_version_slot(table_share));
   mark_trx_read_write_done= 0;
   /*
     Disable row logging.
@@ -7358,6 +7406,7 @@ int handler::ha_reset()
   cancel_pushed_idx_cond();
   /* Reset information about pushed index conditions */
   cancel_pushed_rowid_filter();
+  parallel_scan_threads= 0;
   if (lookup_handler != this)
   {
     lookup_handler->ha_external_unlock(table->in_use);
@@ -598,6 +598,13 @@ enum enum_binlog_command {
   LOGCOM_DROP_DB
 };
 
+/*
+  The fewest pages handler::sample_init() should sample: with fewer, the
+  rows of each page are too alike for a sample of pages to stand in for
+  a sample of rows.
+*/
+#define HA_SAMPLE_MIN_BLOCKS 64
+
 /* struct to hold information about the table that should be created */
 
 /* Bits in used_fields */
@@ -3234,6 +3241,12 @@ class handler :public Sql_alloc
   /* Used for disabling/enabling pushed_rowid_filter */
   Rowid_filter *save_pushed_rowid_filter;
   bool save_rowid_filter_is_active;
+  /*
+    Number of worker threads the next table scan may use, set by the
+    optimizer when the order of the rows does not matter; 0 if the scan
+    must be serial. Reset in ha_reset().
+  */
+  uint parallel_scan_threads;
 
   Discrete_interval auto_inc_interval_for_cur_row;
   /**
@@ -3359,6 +3372,7 @@ class handler :public Sql_alloc
     rowid_filter_is_active(0),
     save_pushed_rowid_filter(NULL),
     save_rowid_filter_is_active(false),
+    parallel_scan_threads(0),
     auto_inc_intervals_count(0),
     m_psi(NULL),
     m_psi_batch_mode(PSI_BATCH_MODE_NONE),
@@ -3440,7 +3454,12 @@ class handler :public Sql_alloc
     int result;
     DBUG_ENTER("ha_rnd_init");
     DBUG_ASSERT(inited==NONE || (inited==RND && scan));
-    inited= (result= rnd_init(scan)) ? NONE: RND;
+    if (!scan || !parallel_scan_threads ||
+        rnd_init_parallel(parallel_scan_threads))
+      result= rnd_init(scan);
+    else
+      result= 0;
+    inited= result ? NONE: RND;
     end_range= NULL;
     DBUG_RETURN(result);
   }
@@ -3453,6 +3472,22 @@ class handler :public Sql_alloc
     DBUG_RETURN(rnd_end());
   }
   int ha_rnd_init_with_error(bool scan) __attribute__ ((warn_unused_result));
+  int ha_sample_init(double fraction) __attribute__ ((warn_unused_result))
+  {
+    int result;
+    DBUG_ENTER("ha_sample_init");
+    DBUG_ASSERT(inited==NONE);
+    inited= (result= sample_init(fraction)) ? NONE: RND;
+    end_range= NULL;
+    DBUG_RETURN(result);
+  }
+  int ha_sample_end()
+  {
+    DBUG_ENTER("ha_sample_end");
+    DBUG_ASSERT(inited==RND);
+    inited=NONE;
+    DBUG_RETURN(sample_end());
+  }
   int ha_reset();
   /* this is necessary in many places, e.g. in HANDLER command */
   int ha_index_or_rnd_end()
@@ -4212,6 +4247,7 @@ class handler :public Sql_alloc
   inline int ha_ft_read(uchar *buf);
   inline void ha_ft_end() { ft_end(); ft_handler=NULL; }
   int ha_rnd_next(uchar *buf);
+  int ha_sample_next(uchar *buf);
   int ha_rnd_pos(uchar *buf, uchar *pos);
   inline int ha_rnd_pos_by_record(uchar *buf);
   inline int ha_read_first_row(uchar *buf, uint primary_key);
@@ -5048,6 +5084,27 @@ class handler :public Sql_alloc
   */
   virtual int rnd_init(bool scan)= 0;
   virtual int rnd_end() { return 0; }
+  /**
+    Start a table scan that reads the table with up to n_threads worker
+    threads, for a statement that does not depend on the order of the
+    rows. rnd_next() then returns the rows in any order and rnd_end()
+    stops the workers. Engines that cannot split the scan, or decide that
+    it is not worth it, return nonzero and the scan is started with
+    rnd_init() instead.
+  */
+  virtual int rnd_init_parallel(uint n_threads) { return HA_ERR_WRONG_COMMAND; }
+  /**
+    Block sampling, used by ANALYZE TABLE: return the rows of randomly
+    chosen pages that together hold about 'fraction' of the table, so
+    that only that part of the table is read. Pages may be chosen more
+    than once. Engines that cannot sample, or for which the sample would
+    be fewer than HA_SAMPLE_MIN_BLOCKS pages or more than half of the
+    table, return HA_ERR_WRONG_COMMAND from sample_init() and the caller
+    scans the whole table instead.
+  */
+  virtual int sample_init(double fraction) { return HA_ERR_WRONG_COMMAND; }
+  virtual int sample_next(uchar *buf) { return HA_ERR_WRONG_COMMAND; }
+  virtual int sample_end() { return rnd_end(); }
   virtual int write_row(const uchar *buf __attribute__((unused)))
   {
     return HA_ERR_WRONG_COMMAND;
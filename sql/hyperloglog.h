@@ -0,0 +1,99 @@
+#ifndef HYPERLOGLOG_INCLUDED
+#define HYPERLOGLOG_INCLUDED
+
+/* Copyright (c) 2026, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+#include "sql_alloc.h"
+#include <my_bit.h>
+#include <math.h>
+#include <string.h>
+
+/*
+  HyperLogLog sketch (Flajolet et al. 2007) for estimating the number of
+  distinct values in a stream using a fixed amount of memory.
+
+  The sketch keeps 2^PRECISION one-byte registers. Each added 64-bit hash
+  selects a register by its top PRECISION bits and stores there the
+  maximal position of the leftmost 1-bit seen in the remaining bits.
+  The standard error of the estimate is about 1.04/sqrt(2^PRECISION),
+  that is 0.8% for the default precision of 14 (16KB of registers).
+
+  The caller supplies hash values; they are passed through a finalizer
+  here, so weak hashes such as the ones produced by Hasher are fine.
+*/
+
+class Hyperloglog: public Sql_alloc
+{
+public:
+  static constexpr uint PRECISION= 14;
+  static constexpr uint REGISTERS= 1U << PRECISION;
+
+  Hyperloglog() { clear(); }
+
+  void clear() { memset(registers, 0, sizeof registers); }
+
+  void add(ulonglong hash)
+  {
+    hash= mix(hash);
+    uint idx= (uint) (hash >> (64 - PRECISION));
+    ulonglong rest= hash << PRECISION;
+    uchar rank= rest ? (uchar) (64 - my_bit_log2_uint64(rest))
+                     : (uchar) (64 - PRECISION + 1);
+    if (rank > registers[idx])
+      registers[idx]= rank;
+  }
+
+  /* Merge another sketch into this one */
+  void merge(const Hyperloglog &other)
+  {
+    for (uint i= 0; i < REGISTERS; i++)
+      if (other.registers[i] > registers[i])
+        registers[i]= other.registers[i];
+  }
+
+  ulonglong estimate() const
+  {
+    const double m= REGISTERS;
+    double sum= 0;
+    uint zeros= 0;
+    for (uint i= 0; i < REGISTERS; i++)
+    {
+      sum+= ldexp(1.0, -(int) registers[i]);
+      zeros+= !registers[i];
+    }
+    double est= (0.7213 / (1 + 1.079 / m)) * m * m / sum;
+    /* Small range correction: linear counting over the empty registers */
+    if (est <= 2.5 * m && zeros)
+      est= m * log(m / zeros);
+    return (ulonglong) (est + 0.5);
+  }
+
+private:
+  /* The 64-bit finalizer of MurmurHash3 */
+  static ulonglong mix(ulonglong h)
+  {
+    h^= h >> 33;
+    h*= 0xff51afd7ed558ccdULL;
+    h^= h >> 33;
+    h*= 0xc4ceb9fe1a85ec53ULL;
+    h^= h >> 33;
+    return h;
+  }
+
+  uchar registers[REGISTERS];
+};
+
+#endif /* HYPERLOGLOG_INCLUDED */
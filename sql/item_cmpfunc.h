@@ -2490,6 +2490,7 @@ class Item_func_in :public Item_func_opt_neg,
 protected:
   SEL_TREE *get_func_mm_tree(RANGE_OPT_PARAM *param,
                              Field *field, Item *value) override;
+  SEL_TREE *get_in_list_mm_tree(RANGE_OPT_PARAM *param, Field *field);
   bool transform_into_subq;
   bool transform_into_subq_checked;
 public:
@@ -30,6 +30,7 @@
 #include "sql_priv.h"
 #include "sql_select.h"
 #include "uniques.h"
+#include "hyperloglog.h"
 #include "sp_rcontext.h"
 #include "sp.h"
 #include "sql_parse.h"
@@ -1964,6 +1965,118 @@ void Item_sum_count::cleanup()
 }
 
 
+/*
+  Approximate count of distinct values
+*/
+
+bool Item_sum_approx_count_distinct::setup(THD *thd)
+{
+  DBUG_ENTER("Item_sum_approx_count_distinct::setup");
+  if (!sketch && !(sketch= new (thd->mem_root) Hyperloglog))
+    DBUG_RETURN(TRUE);
+  DBUG_RETURN(FALSE);
+}
+
+
+void Item_sum_approx_count_distinct::clear()
+{
+  if (sketch)
+    sketch->clear();
+}
+
+
+/**
+  Hash the value of the argument and add it to the sketch.
+
+  Values that compare equal must hash equally: numbers and temporal values
+  are added as their 64-bit image, other values are hashed with the
+  collation of the argument.
+*/
+
+bool Item_sum_approx_count_distinct::add()
+{
+  Item *item= args[0];
+  ulonglong image;
+
+  /* Window functions do not call setup() */
+  if (!sketch && !(sketch= new (current_thd->mem_root) Hyperloglog))
+    return TRUE;
+
+  switch (item->cmp_type()) {
+  case INT_RESULT:
+    image= (ulonglong) item->val_int();
+    break;
+  case REAL_RESULT:
+  {
+    double nr= item->val_real();
+    if (nr == 0.0)
+      nr= 0.0;                                  // -0.0 == 0.0
+    memcpy(&image, &nr, sizeof image);
+    break;
+  }
+  case TIME_RESULT:
+    image= (ulonglong) (item->field_type() == MYSQL_TYPE_TIME ?
+                        item->val_time_packed(current_thd) :
+                        item->val_datetime_packed(current_thd));
+    break;
+  case DECIMAL_RESULT:
+  {
+    my_decimal value, *dec= item->val_decimal(&value);
+    if (item->null_value)
+      return FALSE;
+    uchar buff[DECIMAL_MAX_FIELD_SIZE];
+    decimal_digits_t scale= MY_MIN(item->decimals, DECIMAL_MAX_SCALE);
+    uint precision= MY_MIN(MY_MAX(item->decimal_precision(), scale + 1),
+                           DECIMAL_MAX_PRECISION);
+    Hasher hasher;
+    dec->to_binary(buff, precision, scale);
+    hasher.add(&my_charset_bin, buff,
+               my_decimal_get_binary_size(precision, scale));
+    image= hasher.finalize_ulonglong();
+    break;
+  }
+  case STRING_RESULT:
+  case ROW_RESULT:
+  {
+    StringBuffer<MAX_FIELD_WIDTH> tmp;
+    String *res= item->val_str(&tmp);
+    if (item->null_value)
+      return FALSE;
+    Hasher hasher;
+    hasher.add(item->collation.collation, res->ptr(), res->length());
+    image= hasher.finalize_ulonglong();
+    break;
+  }
+  }
+  if (!item->null_value)
+    sketch->add(image);
+  return FALSE;
+}
+
+
+longlong Item_sum_approx_count_distinct::val_int()
+{
+  DBUG_ASSERT(fixed());
+  return sketch ? (longlong) sketch->estimate() : 0;
+}
+
+
+void Item_sum_approx_count_distinct::cleanup()
+{
+  DBUG_ENTER("Item_sum_approx_count_distinct::cleanup");
+  sketch= NULL;
+  Item_sum_int::cleanup();
+  DBUG_VOID_RETURN;
+}
+
+
+Item *Item_sum_approx_count_distinct::copy_or_same(THD* thd)
+{
+  DBUG_ENTER("Item_sum_approx_count_distinct::copy_or_same");
+  DBUG_RETURN(new (thd->mem_root) Item_sum_approx_count_distinct(thd, this));
+}
+
+
 /*
   Average
 */
@@ -356,7 +356,7 @@ class Item_sum :public Item_func_or_sum
     CUME_DIST_FUNC, NTILE_FUNC, FIRST_VALUE_FUNC, LAST_VALUE_FUNC,
     NTH_VALUE_FUNC, LEAD_FUNC, LAG_FUNC, PERCENTILE_CONT_FUNC,
     PERCENTILE_DISC_FUNC, SP_AGGREGATE_FUNC, JSON_ARRAYAGG_FUNC,
-    JSON_OBJECTAGG_FUNC
+    JSON_OBJECTAGG_FUNC, APPROX_COUNT_DISTINCT_FUNC
   };
 
   Item **ref_by; /* pointer to a ref to the object used to register it */
@@ -437,6 +437,7 @@ class Item_sum :public Item_func_or_sum
     case UDF_SUM_FUNC:
     case GROUP_CONCAT_FUNC:
     case JSON_ARRAYAGG_FUNC:
+    case APPROX_COUNT_DISTINCT_FUNC:
       return true;
     default:
       return false;
@@ -939,6 +940,51 @@ class Item_sum_count :public Item_sum_int
 };
 
 
+class Hyperloglog;
+
+/**
+  APPROX_COUNT_DISTINCT(expr): the number of distinct non-NULL values of
+  expr, estimated with a Hyperloglog sketch. Unlike COUNT(DISTINCT) it
+  uses a fixed amount of memory and never sorts or spills to disk.
+*/
+
+class Item_sum_approx_count_distinct :public Item_sum_int
+{
+  Hyperloglog *sketch;
+
+  void clear() override;
+  bool add() override;
+  void cleanup() override;
+
+public:
+  Item_sum_approx_count_distinct(THD *thd, Item *item_par):
+    Item_sum_int(thd, item_par), sketch(NULL)
+  { quick_group= 0; }
+  Item_sum_approx_count_distinct(THD *thd,
+                                 Item_sum_approx_count_distinct *item):
+    Item_sum_int(thd, item), sketch(NULL)
+  {}
+  enum Sumfunctype sum_func () const override
+  { return APPROX_COUNT_DISTINCT_FUNC; }
+  bool setup(THD *thd) override;
+  void no_rows_in_result() override { clear(); }
+  const Type_handler *type_handler() const override
+  { return &type_handler_slonglong; }
+  longlong val_int() override;
+  /* quick_group is 0, so the value is never kept in a temporary table */
+  void reset_field() override { DBUG_ASSERT(0); }
+  void update_field() override { DBUG_ASSERT(0); }
+  LEX_CSTRING func_name_cstring() const override
+  {
+    static LEX_CSTRING name= { STRING_WITH_LEN("approx_count_distinct(") };
+    return name;
+  }
+  Item *copy_or_same(THD* thd) override;
+  Item *get_copy(THD *thd) override
+  { return get_item_copy<Item_sum_approx_count_distinct>(thd, this); }
+};
+
+
 class Item_sum_avg :public Item_sum_sum
 {
 public:
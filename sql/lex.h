@@ -753,6 +753,7 @@ SYMBOL symbols[] = {
 SYMBOL sql_functions[] = {
   { "ADDDATE",		SYM(ADDDATE_SYM)},
   { "ADD_MONTHS",	SYM(ADD_MONTHS_SYM)},
+  { "APPROX_COUNT_DISTINCT", SYM(APPROX_COUNT_DISTINCT_SYM)},
   { "BIT_AND",		SYM(BIT_AND)},
   { "BIT_OR",		SYM(BIT_OR)},
   { "BIT_XOR",		SYM(BIT_XOR)},
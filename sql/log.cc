@@ -3542,7 +3542,7 @@ MYSQL_BIN_LOG::MYSQL_BIN_LOG(uint *sync_period)
    checksum_alg_reset(BINLOG_CHECKSUM_ALG_UNDEF),
    relay_log_checksum_alg(BINLOG_CHECKSUM_ALG_UNDEF),
    description_event_for_exec(0), description_event_for_queue(0),
-   current_binlog_id(0), reset_master_count(0)
+   current_binlog_id(0), reset_master_count(0), binlog_verified_pos(0)
 {
   /*
     We don't want to initialize locks here as such initialization depends on
@@ -3551,6 +3551,7 @@ MYSQL_BIN_LOG::MYSQL_BIN_LOG(uint *sync_period)
     before main().
   */
   index_file_name[0] = 0;
+  binlog_verified_file[0]= 0;
   bzero((char*) &index_file, sizeof(index_file));
   bzero((char*) &purge_index_file, sizeof(purge_index_file));
 }
@@ -5363,6 +5364,36 @@ void MYSQL_BIN_LOG::make_log_name(char* buf, const char* log_ident)
 }
 
 
+/**
+  Record that a dump thread verified the checksums of the events of a
+  binlog file from start_pos up to pos.
+*/
+
+void MYSQL_BIN_LOG::update_binlog_verified_pos(const char *file_name,
+                                              my_off_t start_pos,
+                                              my_off_t pos)
+{
+  mysql_mutex_assert_not_owner(&LOCK_binlog_end_pos);
+  lock_binlog_end_pos();
+  if (!strcmp(binlog_end_pos_file, file_name) && pos <= binlog_end_pos)
+  {
+    if (strcmp(binlog_verified_file, file_name))
+    {
+      if (start_pos <= BIN_LOG_HEADER_SIZE)
+      {
+        strcpy(binlog_verified_file, file_name);
+        binlog_verified_pos= pos;
+      }
+    }
+    else if (start_pos <= MY_MAX(binlog_verified_pos,
+                                 (my_off_t) BIN_LOG_HEADER_SIZE) &&
+             pos > binlog_verified_pos)
+      binlog_verified_pos= pos;
+  }
+  unlock_binlog_end_pos();
+}
+
+
 /**
   Check if we are writing/reading to the given log file.
 */
@@ -5648,7 +5679,7 @@ bool MYSQL_BIN_LOG::append_no_lock(Log_event* ev)
   DBUG_RETURN(error);
 }
 
-bool MYSQL_BIN_LOG::write_event_buffer(uchar* buf, uint len)
+bool MYSQL_BIN_LOG::write_event_buffer(uchar* buf, uint len, bool flush)
 {
   bool error= 1;
   uchar *ebuf= 0;
@@ -5698,7 +5729,7 @@ bool MYSQL_BIN_LOG::write_event_buffer(uchar* buf, uint len)
 
   error= 0;
   DBUG_PRINT("info",("max_size: %lu",max_size));
-  if (flush_and_sync(0))
+  if (flush && flush_and_sync(0))
     goto err;
   if (my_b_append_tell(&log_file) > max_size)
     error= new_file_without_locking();
@@ -832,7 +832,12 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
   bool write_event(Log_event *ev, binlog_cache_data *data, IO_CACHE *file);
   bool write_event(Log_event *ev) { return write_event(ev, 0, &log_file); }
 
-  bool write_event_buffer(uchar* buf,uint len);
+  /*
+    Append an event of the I/O thread to the relay log. With flush=false
+    the event is left in the append buffer of the log, from which the SQL
+    thread can read it, until the buffer is full or the log is flushed.
+  */
+  bool write_event_buffer(uchar* buf,uint len, bool flush= true);
   bool append(Log_event* ev);
   bool append_no_lock(Log_event* ev);
 
@@ -931,10 +936,40 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
     lock_binlog_end_pos();
     binlog_end_pos= pos;
     strcpy(binlog_end_pos_file, file_name);
+    /* A file of the same name was removed by RESET MASTER */
+    if (!strcmp(binlog_verified_file, file_name))
+      binlog_verified_pos= 0;
     signal_bin_log_update();
     unlock_binlog_end_pos();
   }
 
+  /**
+    Get the position up to which a dump thread verified the checksums of
+    the events of a binlog file.
+
+    @return the position, or 0 if no events of the file were verified
+  */
+  my_off_t get_binlog_verified_pos(const char *file_name)
+  {
+    mysql_mutex_assert_not_owner(&LOCK_binlog_end_pos);
+    lock_binlog_end_pos();
+    my_off_t pos= strcmp(binlog_verified_file, file_name)
+      ? 0 : binlog_verified_pos;
+    unlock_binlog_end_pos();
+    return pos;
+  }
+
+  /**
+    Record that a dump thread verified the checksums of the events of a
+    binlog file from start_pos up to pos. Only the active binlog file is
+    recorded, which is the one that most dump threads read. The position
+    only advances over a range that starts at or below it, so that the
+    events between the recorded position and start_pos, which this dump
+    thread did not read, are never taken for verified.
+  */
+  void update_binlog_verified_pos(const char *file_name, my_off_t start_pos,
+                                  my_off_t pos);
+
   /*
     It is called by the threads(e.g. dump thread) which want to read
     log without LOCK_log protection.
@@ -978,6 +1013,15 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
   */
   my_off_t binlog_end_pos;
   char binlog_end_pos_file[FN_REFLEN];
+
+  /*
+    The events of binlog_verified_file up to binlog_verified_pos passed the
+    checksum check of a dump thread, so that other dump threads send them
+    without checking them again.
+    Access to this is protected by LOCK_binlog_end_pos
+  */
+  my_off_t binlog_verified_pos;
+  char binlog_verified_file[FN_REFLEN];
 };
 
 class Log_event_handler
@@ -4488,6 +4488,9 @@ class Table_map_log_event : public Log_event
   @section Rows_log_event_binary_format Binary Format
 */
 
+#if defined(MYSQL_SERVER) && defined(HAVE_REPLICATION)
+struct Rows_hash_scan;
+#endif
 
 class Rows_log_event : public Log_event
 {
@@ -4739,9 +4742,14 @@ class Rows_log_event : public Log_event
   KEY      *m_key_info; /* Pointer to KEY info for m_key_nr */
   uint      m_key_nr;   /* Key number */
   bool master_had_triggers;     /* set after tables opening */
+  /* Find the rows without a key in one table scan (HASH_SCAN) */
+  bool m_use_hash_scan;
+  Rows_hash_scan *m_hash_scan;  /* The rows found by hash_scan() */
 
   int find_key(); // Find a best key to use in find_row()
   int find_row(rpl_group_info *);
+  int hash_scan(rpl_group_info *);
+  void free_hash_scan();
   int write_row(rpl_group_info *, const bool);
   int update_sequence();
 
@@ -4546,7 +4546,7 @@ Rows_log_event::Rows_log_event(THD *thd_arg, TABLE *tbl_arg, ulong tid,
 #ifdef HAVE_REPLICATION
     , m_curr_row(NULL), m_curr_row_end(NULL),
     m_key(NULL), m_key_info(NULL), m_key_nr(0),
-    master_had_triggers(0)
+    master_had_triggers(0), m_use_hash_scan(false), m_hash_scan(NULL)
 #endif
 {
   /*
@@ -6953,13 +6953,15 @@ uint8 Write_rows_log_event::get_trg_event_map()
 
 #if defined(HAVE_REPLICATION)
 /*
-  Compares table->record[0] and table->record[1]
+  Compares the fields of table->read_set in table->record[0] and
+  table->record[1]
 
   Returns TRUE if different.
 */
 static bool record_compare(TABLE *table)
 {
   bool result= FALSE;
+  const bool all_fields= bitmap_is_set_all(table->read_set);
   /**
     Compare full record only if:
     - there are no blob fields (otherwise we would also need 
@@ -6970,8 +6972,9 @@ static bool record_compare(TABLE *table)
       contents (i.e., the don't care bytes) may show arbitrary 
       values, depending on how each engine handles internally.
     */
-  if ((table->s->blob_fields + 
-       table->s->varchar_fields + 
+  if (all_fields &&
+      (table->s->blob_fields +
+       table->s->varchar_fields +
        table->s->null_fields) == 0)
   {
     result= cmp_record(table,record[1]);
@@ -6979,7 +6982,8 @@ static bool record_compare(TABLE *table)
   }
 
   /* Compare null bits */
-  if (memcmp(table->null_flags,
+  if (all_fields &&
+      memcmp(table->null_flags,
 	     table->null_flags+table->s->rec_buff_length,
 	     table->s->null_bytes))
   {
@@ -6994,6 +6998,16 @@ static bool record_compare(TABLE *table)
     {
       continue;
     }
+    if (!all_fields)
+    {
+      if (!bitmap_is_set(table->read_set, (*ptr)->field_index))
+        continue;
+      if ((*ptr)->is_null() != (*ptr)->is_null(table->s->rec_buff_length))
+      {
+        result= TRUE;
+        goto record_compare_exit;
+      }
+    }
     /**
       We only compare field contents that are not null.
       NULL fields (i.e., their null bits) were compared 
@@ -7021,7 +7035,8 @@ static bool record_compare(TABLE *table)
   preferred. Else we pick the index with the smalles rec_per_key value.
 
   If a suitable key is found, set @c m_key, @c m_key_nr and @c m_key_info
-  member fields appropriately.
+  member fields appropriately. Otherwise set @c m_use_hash_scan if the rows
+  are to be found by @c hash_scan().
 
   @returns Error code on failure, 0 on success.
 */
@@ -7030,10 +7045,15 @@ int Rows_log_event::find_key()
   uint i, best_key_nr, last_part;
   KEY *key, *UNINIT_VAR(best_key);
   ulong UNINIT_VAR(best_rec_per_key), tmp;
+  const ulonglong algorithms= slave_rows_search_algorithms_options;
   DBUG_ENTER("Rows_log_event::find_key");
   DBUG_ASSERT(m_table);
 
   best_key_nr= MAX_KEY;
+  m_use_hash_scan= false;
+
+  if (!(algorithms & (1ULL << SLAVE_ROWS_INDEX_SCAN)))
+    goto no_key;
 
   /*
     Keys are sorted so that any primary key is first, followed by unique keys,
@@ -7076,7 +7096,15 @@ int Rows_log_event::find_key()
 
   if (best_key_nr == MAX_KEY)
   {
+no_key:
     m_key_info= NULL;
+    /*
+      A versioned table is left to the table scan for each row, because
+      find_row() changes the before image of a row of an unversioned
+      master after unpacking it.
+    */
+    m_use_hash_scan= (algorithms & (1ULL << SLAVE_ROWS_HASH_SCAN)) &&
+                     !m_table->versioned();
     DBUG_RETURN(0);
   }
 
@@ -7148,6 +7176,248 @@ static int row_not_found_error(rpl_group_info *rgi)
          ? HA_ERR_KEY_NOT_FOUND : HA_ERR_RECORD_CHANGED;
 }
 
+
+/**
+  The rows of a Delete_rows or Update_rows event that were looked up by
+  Rows_log_event::hash_scan()
+*/
+struct Rows_hash_scan
+{
+  struct Row
+  {
+    uint32 hash;                        /* record_hash() of the image */
+    uint no;                            /* number of the row in the event */
+    const uchar *image;                 /* the before image in the event */
+  };
+  /* The rows, ordered by hash */
+  Dynamic_array<Row> rows;
+  /* The positions of the rows in the table by number, ref_length each */
+  uchar *refs;
+  /* Whether the row of each number was found */
+  bool *found;
+  /*
+    For each element of rows, an element at or after it that was not found
+    yet; links are followed and shortened by next_unfound()
+  */
+  uint *link;
+  /* The number of the row of the next find_row() */
+  uint next;
+
+  Rows_hash_scan() : rows(PSI_INSTRUMENT_MEM), link(NULL), next(0) {}
+  ~Rows_hash_scan() { my_free(link); }
+
+  /* Allocate refs, found and link for the elements of rows */
+  bool alloc(uint ref_length)
+  {
+    const size_t n= rows.elements();
+    if (!(link= (uint*) my_malloc(PSI_INSTRUMENT_ME,
+                                  (n + 1) * sizeof(uint) +
+                                  n * (ref_length + sizeof(bool)),
+                                  MYF(MY_WME | MY_ZEROFILL))))
+      return true;
+    refs= (uchar*) (link + n + 1);
+    found= (bool*) (refs + n * ref_length);
+    for (uint i= 0; i <= n; i++)
+      link[i]= i;
+    return false;
+  }
+
+  /* The first element of rows with a hash not less than the given one */
+  uint lower_bound(uint32 hash)
+  {
+    uint lo= 0, hi= (uint) rows.elements();
+    while (lo < hi)
+    {
+      uint mid= (lo + hi) / 2;
+      if (rows.at(mid).hash < hash)
+        lo= mid + 1;
+      else
+        hi= mid;
+    }
+    return lo;
+  }
+
+  /* The first element of rows at or after i that was not found yet */
+  uint next_unfound(uint i)
+  {
+    while (link[i] != i)
+    {
+      link[i]= link[link[i]];
+      i= link[i];
+    }
+    return i;
+  }
+
+  void set_found(uint i, const uchar *ref, uint ref_length)
+  {
+    const Row &row= rows.at(i);
+    memcpy(refs + row.no * ref_length, ref, ref_length);
+    found[row.no]= true;
+    link[i]= i + 1;
+  }
+};
+
+
+static int cmp_hash_scan_row(const Rows_hash_scan::Row *a,
+                             const Rows_hash_scan::Row *b)
+{
+  if (a->hash != b->hash)
+    return a->hash < b->hash ? -1 : 1;
+  return a->no < b->no ? -1 : a->no > b->no;
+}
+
+
+/*
+  Hash of the fields of table->read_set in table->record[0]. Records that
+  record_compare() finds equal have equal hashes.
+*/
+static uint32 record_hash(TABLE *table)
+{
+  Hasher hasher;
+  for (Field **ptr= table->field; *ptr; ptr++)
+  {
+    if (bitmap_is_set(table->read_set, (*ptr)->field_index) &&
+        !(table->versioned() && (*ptr)->vers_sys_field()))
+      (*ptr)->hash(&hasher);
+  }
+  return hasher.finalize();
+}
+
+
+/**
+  Look up the rows of the event in one scan of the table, for a table
+  without an index to find them by (HASH_SCAN of
+  slave_rows_search_algorithms).
+
+  The before images of the rows from the current one to the end of the
+  event are hashed. Each row of the table is then compared with the before
+  images of the same hash that were not found yet, and takes the first one
+  that is equal. Only the columns of the before images are read, hashed
+  and compared: the extra columns of the table on the slave have their
+  default values in the unpacked images. @c find_row() reads the rows by the positions that were
+  found, in the order of the event.
+
+  If the event has a single row, or the before images cannot be hashed,
+  @c m_hash_scan is left NULL and the rows are looked up by a table scan
+  for each row.
+
+  @returns Error code of the table scan, 0 on success.
+*/
+int Rows_log_event::hash_scan(rpl_group_info *rgi)
+{
+  TABLE *table= m_table;
+  handler *file= table->file;
+  const uchar *const curr_row= m_curr_row, *const curr_row_end= m_curr_row_end;
+  const bool update= get_general_type_code() == UPDATE_ROWS_EVENT;
+  MY_BITMAP *const read_set= table->read_set;
+  Rows_hash_scan *scan;
+  uint n_rows= 0, n_left;
+  int error= 0;
+  DBUG_ENTER("Rows_log_event::hash_scan");
+  DBUG_ASSERT(!m_hash_scan);
+
+  m_use_hash_scan= false;
+  if (!(scan= new Rows_hash_scan))
+    DBUG_RETURN(0);
+
+  bitmap_set_all(&table->tmp_set);
+  bitmap_intersect(&table->tmp_set, &m_cols);
+  table->column_bitmaps_set(&table->tmp_set);
+
+  /* Hash the before images, skipping the after images of an update */
+  while (m_curr_row != m_rows_end)
+  {
+    Rows_hash_scan::Row row;
+    prepare_record(table, m_width, FALSE);
+    if (unpack_current_row(rgi))
+      goto fallback;
+    row.hash= record_hash(table);
+    row.no= n_rows++;
+    row.image= m_curr_row;
+    if (scan->rows.append(row))
+      goto fallback;
+    m_curr_row= m_curr_row_end;
+    if (update &&
+        (m_curr_row == m_rows_end || unpack_current_row(rgi, &m_cols_ai)))
+      goto fallback;
+    m_curr_row= m_curr_row_end;
+  }
+
+  if (n_rows < 2 || scan->alloc(file->ref_length))
+    goto fallback;
+  scan->rows.sort(cmp_hash_scan_row);
+
+  DBUG_PRINT("info",("looking up %u rows in one table scan", n_rows));
+  if (unlikely((error= file->ha_rnd_init_with_error(1))))
+    goto end;
+
+  for (n_left= n_rows; n_left; )
+  {
+    if (unlikely((error= file->ha_rnd_next(table->record[0]))))
+    {
+      if (error == HA_ERR_END_OF_FILE)
+        error= 0;
+      else
+        file->print_error(error, MYF(0));
+      break;
+    }
+
+    const uint32 hash= record_hash(table);
+    bool positioned= false;
+    for (uint i= scan->next_unfound(scan->lower_bound(hash));
+         i < n_rows && scan->rows.at(i).hash == hash;
+         i= scan->next_unfound(i + 1))
+    {
+      if (!positioned)
+      {
+        /* Keep the row of the table in record[1] for record_compare() */
+        file->position(table->record[0]);
+        store_record(table, record[1]);
+        positioned= true;
+      }
+      m_curr_row= scan->rows.at(i).image;
+      prepare_record(table, m_width, FALSE);
+      if (unlikely((error= unpack_current_row(rgi))))
+        break;
+      if (!record_compare(table))
+      {
+        scan->set_found(i, file->ref, file->ref_length);
+        n_left--;
+        break;
+      }
+    }
+    if (unlikely(error))
+      break;
+  }
+  file->ha_rnd_end();
+
+end:
+  table->column_bitmaps_set(read_set);
+  m_curr_row= curr_row;
+  m_curr_row_end= curr_row_end;
+  if (likely(!error))
+    m_hash_scan= scan;
+  else
+    delete scan;
+  issue_long_find_row_warning(get_general_type_code(), m_table->alias.c_ptr(),
+                              false, rgi);
+  DBUG_RETURN(error);
+
+fallback:
+  table->column_bitmaps_set(read_set);
+  m_curr_row= curr_row;
+  m_curr_row_end= curr_row_end;
+  delete scan;
+  DBUG_RETURN(0);
+}
+
+
+void Rows_log_event::free_hash_scan()
+{
+  delete m_hash_scan;
+  m_hash_scan= NULL;
+}
+
 /**
   Locate the current row in event's table.
 
@@ -7161,7 +7431,9 @@ static int row_not_found_error(rpl_group_info *rgi)
   key, it is possible that the record found differs from the row being located.
 
   If no key is specified or table does not have keys, a table scan is used to 
-  find the row. In that case the row should be complete and contain values for
+  find the row, or with HASH_SCAN the row is read by the position that
+  @c hash_scan() found for it in one table scan for all the rows of the
+  event. In that case the row should be complete and contain values for
   all columns. However, it can still be shorter than the table, i.e. the table 
   can contain extra columns not present in the row. It is also possible that 
   the table has fewer columns than the row being located. 
@@ -7400,6 +7672,33 @@ int Rows_log_event::find_row(rpl_group_info *rgi)
   }
   else
   {
+    if (m_use_hash_scan && unlikely((error= hash_scan(rgi))))
+      goto end;
+
+    if (m_hash_scan)
+    {
+      const uint no= m_hash_scan->next++;
+      DBUG_ASSERT(no < m_hash_scan->rows.elements());
+      DBUG_PRINT("info",("locating record using hash scan (rnd_pos)"));
+      if (!m_hash_scan->found[no])
+      {
+        DBUG_PRINT("info", ("Record not found"));
+        error= HA_ERR_END_OF_FILE;
+        goto end;
+      }
+      if (!table->file->inited &&
+          unlikely((error= table->file->ha_rnd_init_with_error(0))))
+        goto end;
+      if (unlikely((error= table->file->ha_rnd_pos(table->record[0],
+                                                   m_hash_scan->refs +
+                                                   no * table->file->ref_length))))
+      {
+        table->file->print_error(error, MYF(0));
+        table->file->ha_rnd_end();
+      }
+      goto end;
+    }
+
     DBUG_PRINT("info",("locating record using table scan (rnd_next)"));
     /* We use this to test that the correct key is used in test cases. */
     DBUG_EXECUTE_IF("slave_crash_if_table_scan", abort(););
@@ -7518,6 +7817,7 @@ Delete_rows_log_event::do_after_row_operations(const Slave_reporting_capability
   my_free(m_key);
   m_key= NULL;
   m_key_info= NULL;
+  free_hash_scan();
 
   return error;
 }
@@ -7678,6 +7978,7 @@ Update_rows_log_event::do_after_row_operations(const Slave_reporting_capability
   my_free(m_key); // Free for multi_malloc
   m_key= NULL;
   m_key_info= NULL;
+  free_hash_scan();
 
   return error;
 }
@@ -388,6 +388,7 @@ my_bool opt_skip_slave_start = 0; ///< If set, slave is not autostarted
 my_bool opt_reckless_slave = 0;
 my_bool opt_enable_named_pipe= 0;
 my_bool opt_local_infile, opt_slave_compressed_protocol;
+uint opt_protocol_compression_level;
 my_bool opt_safe_user_create = 0;
 my_bool opt_show_slave_auth_info;
 my_bool opt_log_slave_updates= 0;
@@ -405,7 +406,7 @@ handlerton *partition_hton;
 
 my_bool read_only= 0, opt_readonly= 0;
 my_bool use_temp_pool, relay_log_purge;
-my_bool relay_log_recovery;
+my_bool relay_log_recovery, relay_log_buffered;
 my_bool opt_sync_frm, opt_allow_suspicious_udfs;
 my_bool opt_secure_auth= 0;
 my_bool opt_require_secure_transport= 0;
@@ -458,6 +459,7 @@ ulong slave_exec_mode_options;
 ulong slave_run_triggers_for_rbr= 0;
 ulong slave_ddl_exec_mode_options= SLAVE_EXEC_MODE_IDEMPOTENT;
 ulonglong slave_type_conversions_options;
+ulonglong slave_rows_search_algorithms_options;
 ulong thread_cache_size=0;
 ulonglong binlog_cache_size=0;
 ulonglong binlog_file_cache_size=0;
@@ -1072,7 +1074,7 @@ PSI_cond_key key_BINLOG_COND_xid_list,
   key_relay_log_info_start_cond, key_relay_log_info_stop_cond,
   key_rpl_group_info_sleep_cond,
   key_TABLE_SHARE_cond, key_user_level_lock_cond,
-  key_COND_start_thread, key_COND_binlog_send,
+  key_COND_start_thread, key_COND_binlog_send, key_COND_semi_sync_waiter,
   key_BINLOG_COND_queue_busy;
 PSI_cond_key key_RELAYLOG_COND_relay_log_updated,
   key_RELAYLOG_COND_bin_log_updated, key_COND_wakeup_ready,
@@ -1133,6 +1135,7 @@ static PSI_cond_info all_server_conds[]=
   { &key_COND_gtid_ignore_duplicates, "COND_gtid_ignore_duplicates", 0},
   { &key_COND_ack_receiver, "Ack_receiver::cond", 0},
   { &key_COND_binlog_send, "COND_binlog_send", 0},
+  { &key_COND_semi_sync_waiter, "Semi_sync_waiter::cond", 0},
   { &key_TABLE_SHARE_COND_rotation, "TABLE_SHARE::COND_rotation", 0}
 };
 
@@ -1227,6 +1230,7 @@ void init_net_server_extension(THD *thd)
   thd->m_net_server_extension.m_user_data= thd;
   thd->m_net_server_extension.m_before_header= net_before_header_psi;
   thd->m_net_server_extension.m_after_header= net_after_header_psi;
+  thd->m_net_server_extension.m_compress_stream= NULL;
   /* Activate this private extension for the mysqld server. */
   thd->net.extension= & thd->m_net_server_extension;
 }
@@ -7405,7 +7409,10 @@ SHOW_VAR status_vars[]= {
   {"Column_compressions",      (char*) offsetof(STATUS_VAR, column_compressions), SHOW_LONG_STATUS},
   {"Column_decompressions",    (char*) offsetof(STATUS_VAR, column_decompressions), SHOW_LONG_STATUS},
   {"Com",                      (char*) com_status_vars, SHOW_ARRAY},
+  {"Compressed_bytes_received", (char*) offsetof(STATUS_VAR, compressed_bytes_received), SHOW_LONGLONG_STATUS},
+  {"Compressed_bytes_sent",    (char*) offsetof(STATUS_VAR, compressed_bytes_sent), SHOW_LONGLONG_STATUS},
   {"Compression",              (char*) &show_net_compression, SHOW_SIMPLE_FUNC},
+  {"Compression_time",         (char*) offsetof(STATUS_VAR, compression_time), SHOW_DOUBLE_STATUS},
   {"Connections",              (char*) &global_thread_id,         SHOW_LONG_NOFLUSH},
   {"Connection_errors_accept", (char*) &connection_errors_accept, SHOW_LONG},
   {"Connection_errors_internal", (char*) &connection_errors_internal, SHOW_LONG},
@@ -7424,6 +7431,8 @@ SHOW_VAR status_vars[]= {
   {"Delayed_insert_threads",   (char*) &delayed_insert_threads, SHOW_LONG_NOFLUSH},
   {"Delayed_writes",           (char*) &delayed_insert_writes,  SHOW_LONG},
   {"Delete_scan",	       (char*) offsetof(STATUS_VAR, delete_scan_count), SHOW_LONG_STATUS},
+  {"Derived_cache_hit",        (char*) offsetof(STATUS_VAR, derived_cache_hits), SHOW_LONG_STATUS},
+  {"Derived_cache_miss",       (char*) offsetof(STATUS_VAR, derived_cache_misses), SHOW_LONG_STATUS},
   {"Empty_queries",            (char*) offsetof(STATUS_VAR, empty_queries), SHOW_LONG_STATUS},
   {"Executed_events",          (char*) &executed_events, SHOW_LONG_NOFLUSH },
   {"Executed_triggers",        (char*) offsetof(STATUS_VAR, executed_triggers), SHOW_LONG_STATUS},
@@ -7473,6 +7482,8 @@ SHOW_VAR status_vars[]= {
   {"Handler_tmp_write",        (char*) offsetof(STATUS_VAR, ha_tmp_write_count), SHOW_LONG_STATUS},
   {"Handler_update",           (char*) offsetof(STATUS_VAR, ha_update_count), SHOW_LONG_STATUS},
   {"Handler_write",            (char*) offsetof(STATUS_VAR, ha_write_count), SHOW_LONG_STATUS},
+  {"Join_cache_bloom_filter_checks", (char*) offsetof(STATUS_VAR, join_cache_bloom_filter_checks), SHOW_LONG_STATUS},
+  {"Join_cache_bloom_filter_rejects", (char*) offsetof(STATUS_VAR, join_cache_bloom_filter_rejects), SHOW_LONG_STATUS},
   SHOW_FUNC_ENTRY("Key",       &show_default_keycache),
   {"optimizer_join_prefixes_check_calls",     (char*) offsetof(STATUS_VAR, optimizer_join_prefixes_check_calls), SHOW_LONG_STATUS},
   {"Last_query_cost",          (char*) offsetof(STATUS_VAR, last_query_cost), SHOW_DOUBLE_STATUS},
@@ -7497,6 +7508,8 @@ SHOW_VAR status_vars[]= {
   {"Opened_table_definitions", (char*) offsetof(STATUS_VAR, opened_shares), SHOW_LONG_STATUS},
   {"Opened_tables",            (char*) offsetof(STATUS_VAR, opened_tables), SHOW_LONG_STATUS},
   {"Opened_views",             (char*) offsetof(STATUS_VAR, opened_views), SHOW_LONG_STATUS},
+  {"Prepared_stmt_cache_hit",  (char*) offsetof(STATUS_VAR, prepared_stmt_cache_hits), SHOW_LONG_STATUS},
+  {"Prepared_stmt_cache_miss", (char*) offsetof(STATUS_VAR, prepared_stmt_cache_misses), SHOW_LONG_STATUS},
   {"Prepared_stmt_count",      (char*) &show_prepared_stmt_count, SHOW_SIMPLE_FUNC},
   {"Rows_sent",                (char*) offsetof(STATUS_VAR, rows_sent), SHOW_LONGLONG_STATUS},
   {"Rows_read",                (char*) offsetof(STATUS_VAR, rows_read), SHOW_LONGLONG_STATUS},
@@ -7617,6 +7630,8 @@ SHOW_VAR status_vars[]= {
   {"Transactions_multi_engine", (char*) &transactions_multi_engine, SHOW_LONG},
   {"Rpl_transactions_multi_engine", (char*) &rpl_transactions_multi_engine, SHOW_LONG},
   {"Transactions_gtid_foreign_engine", (char*) &transactions_gtid_foreign_engine, SHOW_LONG},
+  {"Uncompressed_bytes_received", (char*) offsetof(STATUS_VAR, uncompressed_bytes_received), SHOW_LONGLONG_STATUS},
+  {"Uncompressed_bytes_sent",  (char*) offsetof(STATUS_VAR, uncompressed_bytes_sent), SHOW_LONGLONG_STATUS},
   {"Update_scan",	       (char*) offsetof(STATUS_VAR, update_scan_count), SHOW_LONG_STATUS},
   {"Uptime",                   (char*) &show_starttime,         SHOW_SIMPLE_FUNC},
 #ifdef ENABLED_PROFILING
@@ -210,10 +210,74 @@ void net_end(NET *net)
   DBUG_ENTER("net_end");
   my_free(net->buff);
   net->buff=0;
+#if defined(MYSQL_SERVER) && defined(HAVE_COMPRESS)
+  net_compress_stream_end(net);
+#endif
   DBUG_VOID_RETURN;
 }
 
 
+#if defined(MYSQL_SERVER) && defined(HAVE_COMPRESS)
+static inline MY_COMPRESS_STREAM *net_compress_stream(NET *net)
+{
+  NET_SERVER *ext= static_cast<NET_SERVER*>(net->extension);
+  return ext ? ext->m_compress_stream : NULL;
+}
+
+
+/**
+  Start to compress the packets of the connection with a stream that is
+  kept until net_end(), at the level @@protocol_compression_level.
+  The connection must have a NET_SERVER extension.
+
+  @return TRUE on error
+*/
+
+my_bool net_compress_stream_init(NET *net)
+{
+  NET_SERVER *ext= static_cast<NET_SERVER*>(net->extension);
+  DBUG_ASSERT(ext);
+  DBUG_ASSERT(!ext->m_compress_stream);
+  ext->m_compress_stream=
+    my_compress_stream_init(opt_protocol_compression_level);
+  return ext->m_compress_stream == NULL;
+}
+
+
+void net_compress_stream_end(NET *net)
+{
+  if (NET_SERVER *ext= static_cast<NET_SERVER*>(net->extension))
+  {
+    my_compress_stream_end(ext->m_compress_stream);
+    ext->m_compress_stream= NULL;
+  }
+}
+
+
+/** Account a compressed packet in the status of the connection */
+
+static void net_compress_stats(NET *net, size_t len, size_t complen,
+                               ulonglong start_time, bool sent)
+{
+  if (THD *thd= static_cast<THD*>(net->thd))
+  {
+    if (sent)
+    {
+      thd->status_var.uncompressed_bytes_sent+= len;
+      thd->status_var.compressed_bytes_sent+= complen;
+    }
+    else
+    {
+      thd->status_var.uncompressed_bytes_received+= len;
+      thd->status_var.compressed_bytes_received+= complen;
+    }
+    thd->status_var.compression_time+=
+      (double) (my_interval_timer() - start_time) / 1e9;
+  }
+}
+#endif
+
+
 /** Realloc the packet buffer. */
 
 my_bool net_realloc(NET *net, size_t length)
@@ -432,6 +496,35 @@ my_bool my_net_write(NET *net, const uchar *packet, size_t len)
 
   MYSQL_NET_WRITE_START(len);
 
+  /*
+    Result set rows and most other packets fit in the free space of the
+    buffer: store the header and the data there with one capacity check.
+    The buffer is sent when it fills up, so many small packets go out in
+    a single write.
+  */
+  if (len < MAX_PACKET_LENGTH)
+  {
+    size_t left_length= net->compress && net->max_packet > MAX_PACKET_LENGTH
+      ? MAX_PACKET_LENGTH - (net->write_pos - net->buff)
+      : (size_t) (net->buff_end - net->write_pos);
+    if (len + NET_HEADER_SIZE <= left_length)
+    {
+      uchar *pos= net->write_pos;
+      int3store(pos, len);
+      pos[3]= (uchar) net->pkt_nr++;
+#ifndef DEBUG_DATA_PACKETS
+      DBUG_DUMP("packet_header", pos, NET_HEADER_SIZE);
+#else
+      DBUG_DUMP("data_written", packet, len);
+#endif
+      if (len)
+        memcpy(pos + NET_HEADER_SIZE, packet, len);
+      net->write_pos= pos + NET_HEADER_SIZE + len;
+      MYSQL_NET_WRITE_DONE(0);
+      return 0;
+    }
+  }
+
   /*
     Big packets are handled by splitting them in packets of MAX_PACKET_LENGTH
     length. The last packet is always a packet that is < MAX_PACKET_LENGTH.
@@ -680,8 +773,25 @@ net_real_write(NET *net,const uchar *packet, size_t len)
     size_t complen;
     uchar *b;
     uint header_length=NET_HEADER_SIZE+COMP_HEADER_SIZE;
+    size_t buf_length= len;
+    /* Don't compress error packets (compress == 2) */
+    bool uncompressed= net->compress == 2;
+#ifdef MYSQL_SERVER
+    ulonglong start_time= my_interval_timer();
+    MY_COMPRESS_STREAM *stream= net_compress_stream(net);
+    /* Packets that are sent uncompressed are not given to the stream */
+    if (stream &&
+        (uncompressed || len < MIN_COMPRESS_LENGTH ||
+         (buf_length= my_compress_stream_bound(stream, len)) >
+         MAX_PACKET_LENGTH))
+    {
+      stream= NULL;
+      buf_length= len;
+      uncompressed= true;
+    }
+#endif
     if (!(b= (uchar*) my_malloc(key_memory_NET_compress_packet,
-                                len + NET_HEADER_SIZE + COMP_HEADER_SIZE + 1,
+                                buf_length + header_length + 1,
                                 MYF(MY_WME | (net->thread_specific_malloc
                                               ? MY_THREAD_SPECIFIC : 0)))))
     {
@@ -691,11 +801,33 @@ net_real_write(NET *net,const uchar *packet, size_t len)
       net->reading_or_writing= 0;
       DBUG_RETURN(1);
     }
-    memcpy(b+header_length,packet,len);
+#ifdef MYSQL_SERVER
+    if (stream)
+    {
+      if (my_compress_stream(stream, packet, len, b+header_length, &complen))
+      {
+        my_free(b);
+        net->error= 2;
+        net->last_errno= ER_OUT_OF_RESOURCES;
+        MYSQL_SERVER_my_error(ER_OUT_OF_RESOURCES, MYF(0));
+        net->reading_or_writing= 0;
+        DBUG_RETURN(1);
+      }
+      swap_variables(size_t, len, complen);
+      net_compress_stats(net, complen, len, start_time, true);
+    }
+    else
+#endif
+    {
+      memcpy(b+header_length,packet,len);
 
-    /* Don't compress error packets (compress == 2) */
-    if (net->compress == 2 || my_compress(b+header_length, &len, &complen))
-      complen=0;
+      if (uncompressed || my_compress(b+header_length, &len, &complen))
+        complen=0;
+#ifdef MYSQL_SERVER
+      else if (complen)
+        net_compress_stats(net, complen, len, start_time, true);
+#endif
+    }
     int3store(&b[NET_HEADER_SIZE],complen);
     int3store(b,len);
     b[3]=(uchar) (net->compress_pkt_nr++);
@@ -1271,6 +1403,29 @@ my_net_read_packet(NET *net, my_bool read_from_server)
 }
 
 
+#ifdef HAVE_COMPRESS
+/** Uncompress a packet, see my_uncompress() */
+
+static my_bool net_uncompress(NET *net, uchar *packet, size_t len,
+                              size_t *complen)
+{
+#ifdef MYSQL_SERVER
+  if (*complen)
+  {
+    ulonglong start_time= my_interval_timer();
+    MY_COMPRESS_STREAM *stream= net_compress_stream(net);
+    if (stream ? my_uncompress_stream(stream, packet, len, complen)
+               : my_uncompress(packet, len, complen))
+      return 1;
+    net_compress_stats(net, *complen, len, start_time, false);
+    return 0;
+  }
+#endif
+  return my_uncompress(packet, len, complen);
+}
+#endif
+
+
 ulong
 my_net_read_packet_reallen(NET *net, my_bool read_from_server, ulong* reallen)
 {
@@ -1396,8 +1551,8 @@ my_net_read_packet_reallen(NET *net, my_bool read_from_server, ulong* reallen)
 	return packet_error;
       }
       read_from_server= 0;
-      if (my_uncompress(net->buff + net->where_b, packet_len,
-			&complen))
+      if (net_uncompress(net, net->buff + net->where_b, packet_len,
+                         &complen))
       {
 	net->error= 2;			/* caller will close socket */
         net->last_errno= ER_NET_UNCOMPRESS_ERROR;
@@ -8258,20 +8258,195 @@ SEL_TREE *Item_func_in::get_func_mm_tree(RANGE_OPT_PARAM *param,
     }
   }
   else
+    tree= get_in_list_mm_tree(param, field);
+  DBUG_RETURN(tree);
+}
+
+
+static int sel_arg_cmp_min(const void *a, const void *b)
+{
+  return (*(SEL_ARG**) a)->cmp_min_to_min(*(SEL_ARG**) b);
+}
+
+
+/*
+  Link ranges sorted by their endpoints into a balanced RB-tree
+
+  All NULL links of the built tree are on its last two levels. The nodes
+  on the last level are red if that level is incomplete, all other nodes
+  are black.
+*/
+
+static SEL_ARG *sel_arg_tree_from_sorted(SEL_ARG **ranges, uint n,
+                                         uint depth, uint red_depth,
+                                         SEL_ARG *parent)
+{
+  if (!n)
+    return &null_element;
+  uint mid= n / 2;
+  SEL_ARG *node= ranges[mid];
+  node->parent= parent;
+  node->color= depth == red_depth ? SEL_ARG::RED : SEL_ARG::BLACK;
+  node->left= sel_arg_tree_from_sorted(ranges, mid, depth + 1, red_depth,
+                                       node);
+  node->right= sel_arg_tree_from_sorted(ranges + mid + 1, n - mid - 1,
+                                        depth + 1, red_depth, node);
+  return node;
+}
+
+
+/**
+  Build SEL_TREE for "field IN (c1, ..., cN)"
+
+  @param param  PARAM from SQL_SELECT::test_quick_select
+  @param field  the field in the left part of the IN predicate
+
+  @details
+    The tree of each "field = c_i" has a single point range for every index
+    over the field. Or-ing the trees one by one with tree_or() inserts each
+    range into the RB-tree of the result, which for long IN lists makes the
+    range analysis much more expensive than the ranges themselves.
+
+    Instead, the ranges of every index are collected in an array, sorted
+    by their endpoints and deduplicated. The RB-tree of the index is then
+    linked from the sorted array in one pass and checked against
+    @@optimizer_max_sel_arg_weight once.
+
+    This is only done when all trees are of the simple form above and the
+    sorted ranges either are equal or do not overlap. Otherwise, e.g. when
+    some value makes a tree without ranges, the trees are or-ed with
+    tree_or().
+
+  @returns
+    the built SEL_TREE if it can be constructed
+    0 - otherwise.
+*/
+
+SEL_TREE *Item_func_in::get_in_list_mm_tree(RANGE_OPT_PARAM *param,
+                                            Field *field)
+{
+  uint n_values= arg_count - 1;
+  SEL_TREE **trees;
+  SEL_TREE *result= NULL;
+  uint n_key_trees= 0;
+  SEL_ARG **ranges[MAX_KEY];
+  uint n_ranges[MAX_KEY];
+  uint8 maybe_flags[MAX_KEY];
+  DBUG_ENTER("Item_func_in::get_in_list_mm_tree");
+
+  if (!(trees= (SEL_TREE**) alloc_root(param->mem_root,
+                                       n_values * sizeof(SEL_TREE*))))
+    DBUG_RETURN(0);
+
+  for (uint i= 0; i < n_values; i++)
   {
-    tree= get_mm_parts(param, field, Item_func::EQ_FUNC, args[1]);
-    if (tree)
+    if (!(trees[i]= get_mm_parts(param, field, Item_func::EQ_FUNC,
+                                 args[i + 1])))
+      DBUG_RETURN(0);                           // As tree_or() would do
+  }
+
+  for (uint i= 0; i < n_values; i++)
+  {
+    if (trees[i]->type == SEL_TREE::IMPOSSIBLE)
+      continue;
+    if (trees[i]->type != SEL_TREE::KEY || !trees[i]->without_imerges() ||
+        (result && !(trees[i]->keys_map == result->keys_map)))
+      goto or_trees;
+    key_map::Iterator it(trees[i]->keys_map);
+    int key_no;
+    while ((key_no= it++) != key_map::Iterator::BITMAP_END)
+    {
+      SEL_ARG *key= trees[i]->keys[key_no];
+      if (key->type != SEL_ARG::KEY_RANGE || key->elements != 1 ||
+          key->next_key_part || (key->min_flag & GEOM_FLAG))
+        goto or_trees;
+    }
+    if (!result)
+      result= trees[i];
+    n_key_trees++;
+  }
+
+  if (n_key_trees < 2)
+    goto or_trees;
+
+  {
+    key_map::Iterator it(result->keys_map);
+    int key_no;
+    while ((key_no= it++) != key_map::Iterator::BITMAP_END)
+    {
+      SEL_ARG **key_ranges;
+      if (!(key_ranges= (SEL_ARG**) alloc_root(param->mem_root,
+                                               n_key_trees *
+                                               sizeof(SEL_ARG*))))
+        DBUG_RETURN(0);
+      uint n= 0;
+      bool sorted= true;
+      for (uint i= 0; i < n_values; i++)
+      {
+        if (trees[i]->type == SEL_TREE::IMPOSSIBLE)
+          continue;
+        key_ranges[n]= trees[i]->keys[key_no];
+        if (n && key_ranges[n - 1]->cmp_min_to_min(key_ranges[n]) > 0)
+          sorted= false;
+        n++;
+      }
+      if (!sorted)
+        my_qsort(key_ranges, n, sizeof(SEL_ARG*), sel_arg_cmp_min);
+
+      uint8 maybe_flag= key_ranges[0]->maybe_flag;
+      uint distinct= 1;
+      for (uint i= 1; i < n; i++)
+      {
+        SEL_ARG *prev= key_ranges[distinct - 1];
+        if (prev->is_same(key_ranges[i]) &&
+            prev->maybe_flag == key_ranges[i]->maybe_flag)
+          continue;
+        if (prev->cmp_max_to_min(key_ranges[i]) != -1)
+          goto or_trees;
+        maybe_flag|= key_ranges[i]->maybe_flag;
+        key_ranges[distinct++]= key_ranges[i];
+      }
+      ranges[key_no]= key_ranges;
+      n_ranges[key_no]= distinct;
+      maybe_flags[key_no]= maybe_flag;
+    }
+  }
+
+  {
+    key_map::Iterator it(result->keys_map);
+    int key_no;
+    while ((key_no= it++) != key_map::Iterator::BITMAP_END)
     {
-      Item **arg, **end;
-      for (arg= args + 2, end= arg + arg_count - 2;
-           arg < end ; arg++)
+      SEL_ARG **key_ranges= ranges[key_no];
+      uint n= n_ranges[key_no];
+      uint red_depth= 0;
+      for (uint i= n + 1; i > 1; i>>= 1)
+        red_depth++;
+      for (uint i= 0; i < n; i++)
       {
-        tree= tree_or(param, tree, get_mm_parts(param, field,
-                                                Item_func::EQ_FUNC, *arg));
+        key_ranges[i]->prev= i ? key_ranges[i - 1] : 0;
+        key_ranges[i]->next= i + 1 < n ? key_ranges[i + 1] : 0;
       }
+      SEL_ARG *root= sel_arg_tree_from_sorted(key_ranges, n, 0, red_depth, 0);
+      root->elements= n;
+      root->use_count= 1;
+      root->weight= n;
+      root->maybe_flag= maybe_flags[key_no];
+#ifndef DBUG_OFF
+      root->verify_weight();
+#endif
+      if (!(result->keys[key_no]= enforce_sel_arg_weight_limit(param, key_no,
+                                                               root)))
+        result->keys_map.clear_bit(key_no);
     }
   }
-  DBUG_RETURN(tree);
+  DBUG_RETURN(result);
+
+or_trees:
+  result= trees[0];
+  for (uint i= 1; i < n_values; i++)
+    result= tree_or(param, result, trees[i]);
+  DBUG_RETURN(result);
 }
 
 
@@ -283,7 +283,7 @@ Protocol::net_send_ok(THD *thd,
   DBUG_ASSERT(store.length() <= MAX_PACKET_LENGTH);
 
   error= my_net_write(net, (const unsigned char*)store.ptr(), store.length());
-  if (likely(!error))
+  if (likely(!error) && !thd->defer_net_flush)
     error= net_flush(net);
 
   thd->get_stmt_da()->set_overwrite_status(false);
@@ -345,7 +345,7 @@ Protocol::net_send_eof(THD *thd, uint server_status, uint statement_warn_count)
   {
     thd->get_stmt_da()->set_overwrite_status(true);
     error= write_eof_packet(thd, net, server_status, statement_warn_count);
-    if (likely(!error))
+    if (likely(!error) && !thd->defer_net_flush)
       error= net_flush(net);
     thd->get_stmt_da()->set_overwrite_status(false);
     DBUG_PRINT("info", ("EOF sent, so no more error sending allowed"));
@@ -1282,6 +1282,53 @@ bool Protocol::send_list_fields(List<Field> *list, const TABLE_LIST *table_list)
 }
 
 
+/**
+  Send column info that was saved by Saved_metadata::save().
+
+  @param metadata       the saved column info
+  @param flags          Protocol::SEND_EOF to end with an EOF packet
+
+  @retval 0 ok
+  @retval 1 error
+*/
+
+bool Protocol::send_saved_metadata(const Saved_metadata *metadata, uint flags)
+{
+  DBUG_ENTER("Protocol::send_saved_metadata");
+  Protocol_text prot(thd, thd->variables.net_buffer_length);
+
+#ifndef DBUG_OFF
+  field_handlers= (const Type_handler **) thd->alloc(sizeof(field_handlers[0]) *
+                                                     metadata->count);
+#endif
+
+  for (uint pos= 0; pos < metadata->count; pos++)
+  {
+    prot.prepare_for_resend();
+    if (prot.store_field_metadata(thd, *metadata->fields[pos],
+                                  metadata->charsets[pos], pos))
+      goto err;
+    if (prot.write())
+      DBUG_RETURN(1);
+#ifndef DBUG_OFF
+    field_handlers[pos]= metadata->fields[pos]->type_handler();
+#endif
+  }
+
+  if ((flags & SEND_EOF) &&
+      !(thd->client_capabilities & CLIENT_DEPRECATE_EOF) &&
+      write_eof_packet(thd, &thd->net, thd->server_status,
+                       thd->get_stmt_da()->current_statement_warn_count()))
+    DBUG_RETURN(1);
+
+  DBUG_RETURN(prepare_for_send(metadata->count));
+
+err:
+  my_message(ER_OUT_OF_RESOURCES, ER_THD(thd, ER_OUT_OF_RESOURCES), MYF(0));
+  DBUG_RETURN(1);
+}
+
+
 bool Protocol::write()
 {
   DBUG_ENTER("Protocol::write");
@@ -1291,6 +1338,51 @@ bool Protocol::write()
 #endif /* EMBEDDED_LIBRARY */
 
 
+static bool save_lex_cstring(MEM_ROOT *root, LEX_CSTRING *str)
+{
+  if (!str->str)
+    return false;
+  return !(str->str= strmake_root(root, str->str, str->length));
+}
+
+
+/**
+  Copy the column info of items, as Protocol::send_result_set_metadata()
+  would send it, to a memory root.
+
+  @return the copy, or NULL if out of memory
+*/
+
+Saved_metadata *Saved_metadata::save(THD *thd, MEM_ROOT *root,
+                                     List<Item> *list)
+{
+  Saved_metadata *metadata;
+  if (!(metadata= new (root) Saved_metadata) ||
+      !(metadata->fields= (Send_field **) alloc_root(root,
+                              sizeof(Send_field *) * list->elements)) ||
+      !(metadata->charsets= (CHARSET_INFO **) alloc_root(root,
+                              sizeof(CHARSET_INFO *) * list->elements)))
+    return NULL;
+
+  List_iterator_fast<Item> it(*list);
+  metadata->count= 0;
+  for (Item *item; (item= it++); metadata->count++)
+  {
+    Send_field *field= new (root) Send_field(thd, item);
+    if (!field ||
+        save_lex_cstring(root, &field->db_name) ||
+        save_lex_cstring(root, &field->table_name) ||
+        save_lex_cstring(root, &field->org_table_name) ||
+        save_lex_cstring(root, &field->col_name) ||
+        save_lex_cstring(root, &field->org_col_name))
+      return NULL;
+    metadata->fields[metadata->count]= field;
+    metadata->charsets[metadata->count]= item->charset_for_protocol();
+  }
+  return metadata;
+}
+
+
 bool Protocol_text::store_item_metadata(THD *thd, Item *item, uint pos)
 {
   Send_field field(thd, item);
@@ -1475,6 +1567,99 @@ bool Protocol_text::store_numeric_string_aux(const char *from, size_t length)
 }
 
 
+/* "00" .. "99", for converting integers two digits at a time */
+static const char dec_digit_pairs[201]=
+  "00010203040506070809101112131415161718192021222324252627282930313233343536"
+  "37383940414243444546474849505152535455565758596061626364656667686970717273"
+  "7475767778798081828384858687888990919293949596979899";
+
+
+/** @return the number of decimal digits of val */
+static inline uint dec_digits(ulonglong val)
+{
+  uint digits= 1;
+  for (;;)
+  {
+    if (val < 10)
+      return digits;
+    if (val < 100)
+      return digits + 1;
+    if (val < 1000)
+      return digits + 2;
+    if (val < 10000)
+      return digits + 3;
+    val/= 10000;
+    digits+= 4;
+  }
+}
+
+
+/**
+  Write the decimal digits of val, ending at to + digits.
+  Two digits are produced per division, from a table.
+*/
+static inline void dec_write_digits(char *to, ulonglong val, uint digits)
+{
+  char *pos= to + digits;
+  while (val >= 100)
+  {
+    const uint i= (uint) (val % 100) * 2;
+    val/= 100;
+    *--pos= dec_digit_pairs[i + 1];
+    *--pos= dec_digit_pairs[i];
+  }
+  if (val >= 10)
+  {
+    *--pos= dec_digit_pairs[val * 2 + 1];
+    *--pos= dec_digit_pairs[val * 2];
+  }
+  else
+    *--pos= (char) ('0' + val);
+  DBUG_ASSERT(pos == to);
+}
+
+
+/**
+  Store an integer in the text protocol.
+
+  Unless character_set_results needs a conversion, the length byte and
+  the digits are written straight to the end of the packet after a single
+  check of its capacity, instead of being formatted into a temporary
+  buffer and copied.
+*/
+
+bool Protocol_text::store_integer_aux(longlong from, bool unsigned_flag)
+{
+#ifndef EMBEDDED_LIBRARY
+  CHARSET_INFO *tocs= thd->variables.character_set_results;
+  if (!tocs || !(tocs->state & MY_CS_NONASCII))
+  {
+    const bool neg= !unsigned_flag && from < 0;
+    const ulonglong val= neg ? 0ULL - (ulonglong) from : (ulonglong) from;
+    const uint digits= dec_digits(val);
+    const size_t packet_length= packet->length();
+    /* A length byte, a sign and at most 20 digits */
+    if (packet_length + 22 > packet->alloced_length() &&
+        packet->realloc(packet_length + 22))
+      return true;
+    char *to= (char*) packet->ptr() + packet_length;
+    /* The length is below 251, so it is stored in a single byte */
+    *to++= (char) (digits + neg);
+    if (neg)
+      *to++= '-';
+    dec_write_digits(to, val, digits);
+    packet->length(packet_length + 1 + neg + digits);
+    return false;
+  }
+#endif
+  char buff[22];
+  size_t length= (size_t) (longlong10_to_str(from, buff,
+                                             unsigned_flag ? 10 : -10) -
+                           buff);
+  return store_numeric_string_aux(buff, length);
+}
+
+
 bool Protocol::store_warning(const char *from, size_t length)
 {
   BinaryStringBuffer<MYSQL_ERRMSG_SIZE> tmp;
@@ -1523,9 +1708,7 @@ bool Protocol_text::store_tiny(longlong from)
   DBUG_ASSERT(valid_handler(field_pos, PROTOCOL_SEND_TINY));
   field_pos++;
 #endif
-  char buff[22];
-  size_t length= (size_t) (int10_to_str((int) from, buff, -10) - buff);
-  return store_numeric_string_aux(buff, length);
+  return store_integer_aux((int) from, false);
 }
 
 
@@ -1535,9 +1718,7 @@ bool Protocol_text::store_short(longlong from)
   DBUG_ASSERT(valid_handler(field_pos, PROTOCOL_SEND_SHORT));
   field_pos++;
 #endif
-  char buff[22];
-  size_t length= (size_t) (int10_to_str((int) from, buff, -10) - buff);
-  return store_numeric_string_aux(buff, length);
+  return store_integer_aux((int) from, false);
 }
 
 
@@ -1547,10 +1728,7 @@ bool Protocol_text::store_long(longlong from)
   DBUG_ASSERT(valid_handler(field_pos, PROTOCOL_SEND_LONG));
   field_pos++;
 #endif
-  char buff[22];
-  size_t length= (size_t) (int10_to_str((long int)from, buff,
-                                        (from < 0) ? - 10 : 10) - buff);
-  return store_numeric_string_aux(buff, length);
+  return store_integer_aux(from, false);
 }
 
 
@@ -1560,11 +1738,7 @@ bool Protocol_text::store_longlong(longlong from, bool unsigned_flag)
   DBUG_ASSERT(valid_handler(field_pos, PROTOCOL_SEND_LONGLONG));
   field_pos++;
 #endif
-  char buff[22];
-  size_t length= (size_t) (longlong10_to_str(from, buff,
-                                             unsigned_flag ? 10 : -10) -
-                           buff);
-  return store_numeric_string_aux(buff, length);
+  return store_integer_aux(from, unsigned_flag);
 }
 
 
@@ -34,6 +34,21 @@ struct TABLE_LIST;
 typedef struct st_mysql_field MYSQL_FIELD;
 typedef struct st_mysql_rows MYSQL_ROWS;
 
+/*
+  Column info of a list of items, copied so that it can be sent again
+  after the items are gone, see Protocol::send_saved_metadata()
+*/
+class Saved_metadata: public Sql_alloc
+{
+  Send_field **fields;
+  CHARSET_INFO **charsets;
+  uint count;
+public:
+  static Saved_metadata *save(THD *thd, MEM_ROOT *root, List<Item> *list);
+  uint elements() const { return count; }
+  friend class Protocol;
+};
+
 class Protocol
 {
 protected:
@@ -96,6 +111,7 @@ class Protocol
   enum { SEND_NUM_ROWS= 1, SEND_EOF= 2, SEND_FORCE_COLUMN_INFO= 4 };
   virtual bool send_result_set_metadata(List<Item> *list, uint flags);
   bool send_list_fields(List<Field> *list, const TABLE_LIST *table_list);
+  bool send_saved_metadata(const Saved_metadata *metadata, uint flags);
   bool send_result_set_row(List<Item> *row_items);
 
   bool store(I_List<i_string> *str_list);
@@ -198,6 +214,7 @@ class Protocol_text :public Protocol
 {
   StringBuffer<FLOATING_POINT_BUFFER> buffer;
   bool store_numeric_string_aux(const char *from, size_t length);
+  bool store_integer_aux(longlong from, bool unsigned_flag);
 public:
   Protocol_text(THD *thd_arg, ulong prealloc= 0)
    :Protocol(thd_arg)
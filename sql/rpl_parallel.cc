@@ -900,6 +900,21 @@ retry_event_group(rpl_group_info *rgi, rpl_parallel_thread *rpt,
   */
   thd->reset_killed();
 
+  /*
+    The event group is read again from the relay log file. With
+    relay_log_buffered its events may still be only in the append buffer
+    of the active relay log, so write the buffer to the file first.
+  */
+  mysql_mutex_lock(rli->relay_log.get_log_lock());
+  if (rli->relay_log.is_open() && rli->relay_log.flush_and_sync(0))
+  {
+    mysql_mutex_unlock(rli->relay_log.get_log_lock());
+    errmsg= "slave SQL thread aborted because of I/O error";
+    err= 1;
+    goto err;
+  }
+  mysql_mutex_unlock(rli->relay_log.get_log_lock());
+
   strmake_buf(log_name, ir->name);
   if ((fd= open_binlog(&rlog, log_name, &errmsg)) <0)
   {
@@ -341,6 +341,8 @@ void Active_tranx::clear_active_tranx_nodes(const char *log_file_name,
 Repl_semi_sync_master::Repl_semi_sync_master()
   : m_active_tranxs(NULL),
     m_init_done(false),
+    m_waiters_front(NULL),
+    m_waiters_rear(NULL),
     m_reply_file_name_inited(false),
     m_reply_file_pos(0L),
     m_wait_file_name_inited(false),
@@ -525,6 +527,68 @@ int Repl_semi_sync_master::cond_timewait(struct timespec *wait_time)
   DBUG_RETURN(wait_res);
 }
 
+void Repl_semi_sync_master::add_waiter(Semi_sync_waiter *waiter)
+{
+  Semi_sync_waiter *prev= m_waiters_rear;
+
+  mysql_mutex_assert_owner(&LOCK_binlog);
+
+  /* Transactions mostly wait in binlog order: search from the tail. */
+  while (prev && Active_tranx::compare(prev->log_name, prev->log_pos,
+                                       waiter->log_name, waiter->log_pos) > 0)
+    prev= prev->prev;
+
+  waiter->prev= prev;
+  waiter->next= prev ? prev->next : m_waiters_front;
+  if (waiter->next)
+    waiter->next->prev= waiter;
+  else
+    m_waiters_rear= waiter;
+  if (prev)
+    prev->next= waiter;
+  else
+    m_waiters_front= waiter;
+  waiter->queued= true;
+}
+
+void Repl_semi_sync_master::remove_waiter(Semi_sync_waiter *waiter)
+{
+  mysql_mutex_assert_owner(&LOCK_binlog);
+  DBUG_ASSERT(waiter->queued);
+
+  if (waiter->prev)
+    waiter->prev->next= waiter->next;
+  else
+    m_waiters_front= waiter->next;
+  if (waiter->next)
+    waiter->next->prev= waiter->prev;
+  else
+    m_waiters_rear= waiter->prev;
+  waiter->queued= false;
+}
+
+bool Repl_semi_sync_master::release_waiters(const char *log_file_name,
+                                            my_off_t log_file_pos)
+{
+  bool released= false;
+
+  mysql_mutex_assert_owner(&LOCK_binlog);
+
+  while (Semi_sync_waiter *waiter= m_waiters_front)
+  {
+    if (log_file_name &&
+        Active_tranx::compare(waiter->log_name, waiter->log_pos,
+                              log_file_name, log_file_pos) > 0)
+      break;
+    remove_waiter(waiter);
+    /* The waiter may return as soon as it gets the mutex: signal it first */
+    mysql_cond_signal(&waiter->cond);
+    released= true;
+  }
+
+  return released;
+}
+
 void Repl_semi_sync_master::add_slave()
 {
   lock();
@@ -551,16 +615,15 @@ void Repl_semi_sync_master::remove_slave()
   unlock();
 }
 
-int Repl_semi_sync_master::report_reply_packet(uint32 server_id,
-                                               const uchar *packet,
-                                               ulong packet_len)
+int Repl_semi_sync_master::read_reply_packet(const uchar *packet,
+                                             ulong packet_len,
+                                             char *log_file_name,
+                                             my_off_t *log_file_pos)
 {
   int result= -1;
-  char log_file_name[FN_REFLEN+1];
-  my_off_t log_file_pos;
   ulong log_file_len = 0;
 
-  DBUG_ENTER("Repl_semi_sync_master::report_reply_packet");
+  DBUG_ENTER("Repl_semi_sync_master::read_reply_packet");
 
   if (unlikely(packet[REPLY_MAGIC_NUM_OFFSET] !=
                Repl_semi_sync_master::k_packet_magic_num))
@@ -575,7 +638,7 @@ int Repl_semi_sync_master::report_reply_packet(uint32 server_id,
     goto l_end;
   }
 
-  log_file_pos = uint8korr(packet + REPLY_BINLOG_POS_OFFSET);
+  *log_file_pos = uint8korr(packet + REPLY_BINLOG_POS_OFFSET);
   log_file_len = packet_len - REPLY_BINLOG_NAME_OFFSET;
   if (unlikely(log_file_len >= FN_REFLEN))
   {
@@ -586,6 +649,25 @@ int Repl_semi_sync_master::report_reply_packet(uint32 server_id,
   log_file_name[log_file_len] = 0;
 
   DBUG_ASSERT(dirname_length(log_file_name) == 0);
+  result= 0;
+
+l_end:
+
+  DBUG_RETURN(result);
+}
+
+int Repl_semi_sync_master::report_reply_packet(uint32 server_id,
+                                               const uchar *packet,
+                                               ulong packet_len)
+{
+  int result= -1;
+  char log_file_name[FN_REFLEN+1];
+  my_off_t log_file_pos;
+
+  DBUG_ENTER("Repl_semi_sync_master::report_reply_packet");
+
+  if (read_reply_packet(packet, packet_len, log_file_name, &log_file_pos))
+    goto l_end;
 
   DBUG_PRINT("semisync", ("%s: Got reply(%s, %lu) from server %u",
                           "Repl_semi_sync_master::report_reply_packet",
@@ -673,10 +755,18 @@ int Repl_semi_sync_master::report_reply_binlog(uint32 server_id,
     if (cmp >= 0)
     {
       /* Yes, at least one waiting thread can now proceed:
-       * let us release all waiting threads with a broadcast
+       * let us wake up the threads up to the reply position.  The others
+       * keep sleeping, and the smallest wait position is the first of them.
        */
-      can_release_threads = true;
-      m_wait_file_name_inited = false;
+      can_release_threads = release_waiters(m_reply_file_name,
+                                            m_reply_file_pos);
+      if (m_waiters_front)
+      {
+        strmake_buf(m_wait_file_name, m_waiters_front->log_name);
+        m_wait_file_pos = m_waiters_front->log_pos;
+      }
+      else
+        m_wait_file_name_inited = false;
     }
   }
 
@@ -685,7 +775,8 @@ int Repl_semi_sync_master::report_reply_binlog(uint32 server_id,
 
   if (can_release_threads)
   {
-    DBUG_PRINT("semisync", ("%s: signal all waiting threads.",
+    DBUG_PRINT("semisync", ("%s: signaled the waiting threads up to the "
+                            "reply position.",
                             "Repl_semi_sync_master::report_reply_binlog"));
 
     cond_broadcast();
@@ -825,15 +916,20 @@ int Repl_semi_sync_master::commit_trx(const char* trx_wait_binlog_name,
     int wait_result;
     PSI_stage_info old_stage;
     THD *thd= current_thd;
+    Semi_sync_waiter waiter;
 
     set_timespec(start_ts, 0);
+    waiter.log_name= trx_wait_binlog_name;
+    waiter.log_pos= trx_wait_binlog_pos;
+    waiter.queued= false;
+    mysql_cond_init(key_COND_semi_sync_waiter, &waiter.cond, NULL);
 
     DEBUG_SYNC(thd, "rpl_semisync_master_commit_trx_before_lock");
     /* Acquire the mutex. */
     lock();
 
     /* This must be called after acquired the lock */
-    THD_ENTER_COND(thd, &COND_binlog_send, &LOCK_binlog,
+    THD_ENTER_COND(thd, &waiter.cond, &LOCK_binlog,
                    & stage_waiting_for_semi_sync_ack_from_slave,
                    & old_stage);
 
@@ -901,10 +997,12 @@ int Repl_semi_sync_master::commit_trx(const char* trx_wait_binlog_name,
        * thread has received the reply on the relevant binlog segment from the
        * replication slave.
        *
-       * Let us suspend this thread to wait on the condition;
+       * Let us suspend this thread to wait on its own condition;
        * when replication has progressed far enough, we will release
-       * these waiting threads.
+       * this waiting thread.
        */
+      if (!waiter.queued)
+        add_waiter(&waiter);
       rpl_semi_sync_master_wait_sessions++;
 
       /* We keep track of when this thread is awaiting an ack to ensure it is
@@ -918,7 +1016,9 @@ int Repl_semi_sync_master::commit_trx(const char* trx_wait_binlog_name,
                               m_wait_file_name, (ulong)m_wait_file_pos));
 
       create_timeout(&abstime, &start_ts);
-      wait_result = cond_timewait(&abstime);
+      wait_result = mysql_cond_timedwait(&waiter.cond, &LOCK_binlog,
+                                         &abstime);
+      DEBUG_SYNC(thd, "rpl_semisync_master_commit_trx_after_wait");
 
       set_thd_awaiting_semisync_ack(thd, FALSE);
       rpl_semi_sync_master_wait_sessions--;
@@ -960,13 +1060,17 @@ int Repl_semi_sync_master::commit_trx(const char* trx_wait_binlog_name,
       At this point, the binlog file and position of this transaction
       must have been removed from Active_tranx.
       m_active_tranxs may be NULL if someone disabled semi sync during
-      cond_timewait()
+      the wait
     */
     assert(thd_killed(thd) || !m_active_tranxs ||
            !m_active_tranxs->is_tranx_end_pos(trx_wait_binlog_name,
                                              trx_wait_binlog_pos));
 
   l_end:
+    /* A killed thread is still in the list of waiters */
+    if (waiter.queued)
+      remove_waiter(&waiter);
+
     /* Update the status counter. */
     if (is_on())
       rpl_semi_sync_master_yes_transactions++;
@@ -976,6 +1080,7 @@ int Repl_semi_sync_master::commit_trx(const char* trx_wait_binlog_name,
     /* The lock held will be released by thd_exit_cond, so no need to
        call unlock() here */
     THD_EXIT_COND(thd, &old_stage);
+    mysql_cond_destroy(&waiter.cond);
   }
 
   DBUG_RETURN(0);
@@ -1013,7 +1118,8 @@ void Repl_semi_sync_master::switch_off()
   m_wait_file_name_inited   = false;
   m_reply_file_name_inited  = false;
   sql_print_information("Semi-sync replication switched OFF.");
-  cond_broadcast();                            /* wake up all waiting threads */
+  release_waiters(NULL, 0);                    /* wake up all waiting threads */
+  cond_broadcast();
 
   DBUG_VOID_RETURN;
 }
@@ -26,6 +26,7 @@
 extern PSI_mutex_key key_LOCK_rpl_semi_sync_master_enabled;
 extern PSI_mutex_key key_LOCK_binlog;
 extern PSI_cond_key key_COND_binlog_send;
+extern PSI_cond_key key_COND_semi_sync_waiter;
 #endif
 
 struct Tranx_node {
@@ -361,6 +362,22 @@ class Active_tranx
 
 };
 
+/**
+   A transaction that waits in commit_trx() for the reply of the slaves.
+
+   The waiters are kept in a list sorted by their binlog position, so that
+   a reply only wakes up the transactions whose position it covers, each
+   with its own condition.
+*/
+struct Semi_sync_waiter {
+  const char       *log_name;
+  my_off_t          log_pos;
+  mysql_cond_t      cond;
+  /* true while the waiter is in the list; reset when it is released */
+  bool              queued;
+  Semi_sync_waiter *prev, *next;
+};
+
 /**
    The extension class for the master of semi-synchronous replication
 */
@@ -372,11 +389,15 @@ class Repl_semi_sync_master
   /* True when init_object has been called */
   bool m_init_done;
 
-  /* This cond variable is signaled when enough binlog has been sent to slave,
-   * so that a waiting trx can return the 'ok' to the client for a commit.
+  /* This cond variable is signaled when waiting transactions have been
+   * released, either by a reply of a slave or by switching semi-sync off.
+   * The transactions themselves wait on the cond of their Semi_sync_waiter.
    */
   mysql_cond_t  COND_binlog_send;
 
+  /* The transactions waiting in commit_trx(), sorted by binlog position. */
+  Semi_sync_waiter *m_waiters_front, *m_waiters_rear;
+
   /* Mutex that protects the following state variables and the active
    * transaction list.
    * Under no cirumstances we can acquire mysql_bin_log.LOCK_log if we are
@@ -436,6 +457,18 @@ class Repl_semi_sync_master
   void cond_broadcast();
   int  cond_timewait(struct timespec *wait_time);
 
+  /* Insert a waiter into the sorted list of waiting transactions. */
+  void add_waiter(Semi_sync_waiter *waiter);
+  /* Remove a waiter that was not released from the list. */
+  void remove_waiter(Semi_sync_waiter *waiter);
+  /* Wake up and remove the waiters up to (inclusive) the given position,
+   * or all of them if log_file_name is NULL.
+   *
+   * Return:
+   *  whether any waiter was released
+   */
+  bool release_waiters(const char *log_file_name, my_off_t log_file_pos);
+
   /* Is semi-sync replication on? */
   bool is_on() {
     return (m_state);
@@ -515,6 +548,14 @@ class Repl_semi_sync_master
   /* Remove a semi-sync replication slave */
   void remove_slave();
 
+  /* It parses a reply packet into the binlog position that it acknowledges.
+   *
+   * Return:
+   *  0: success;  non-zero: error
+   */
+  int read_reply_packet(const uchar *packet, ulong packet_len,
+                        char *log_file_name, my_off_t *log_file_pos);
+
   /* It parses a reply packet and call report_reply_binlog to handle it. */
   int report_reply_packet(uint32 server_id, const uchar *packet,
                         ulong packet_len);
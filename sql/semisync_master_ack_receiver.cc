@@ -16,6 +16,7 @@
 #include <my_global.h>
 #include "semisync_master.h"
 #include "semisync_master_ack_receiver.h"
+#include "debug_sync.h"
 
 #ifdef HAVE_PSI_MUTEX_INTERFACE
 extern PSI_mutex_key key_LOCK_ack_receiver;
@@ -188,6 +189,10 @@ void Ack_receiver::run()
   THD *thd= new THD(next_thread_id());
   NET net;
   unsigned char net_buff[REPLY_MESSAGE_MAX_LENGTH];
+  /* The latest position that was acknowledged in a pass over the sockets */
+  char ack_file_name[FN_REFLEN+1];
+  my_off_t ack_file_pos= 0;
+  uint32 ack_server_id= 0;
 
   my_thread_init();
 
@@ -215,6 +220,7 @@ void Ack_receiver::run()
   {
     int ret;
     uint slave_count __attribute__((unused))= 0;
+    uint ack_count= 0;
     Slave *slave;
 
     mysql_mutex_lock(&m_mutex);
@@ -257,11 +263,29 @@ void Ack_receiver::run()
       continue;
     }
 
+#ifdef ENABLED_DEBUG_SYNC
+    DBUG_EXECUTE_IF("semisync_ack_receiver_wait_before_read",
+                    {
+                      const char act[]= "now signal ack_receiver.reached "
+                                        "wait_for ack_receiver.continue";
+                      DBUG_ASSERT(debug_sync_service);
+                      DBUG_ASSERT(!debug_sync_set_action(thd,
+                                                         STRING_WITH_LEN(act)));
+                    });
+#endif
+
+    /*
+      Read all the acks that the slaves have sent, and report only the
+      latest position, so that the acks that arrived together take
+      LOCK_binlog and wake up the committing transactions once.
+    */
     set_stage_info(stage_reading_semi_sync_ack);
     Slave_ilist_iterator it(m_slaves);
     while ((slave= it++))
     {
-      if (listener.is_socket_active(slave))
+      if (!listener.is_socket_active(slave))
+        continue;
+      do
       {
         ulong len;
 
@@ -272,15 +296,46 @@ void Ack_receiver::run()
           Slave_compress_protocol flag enabled Slaves
         */
         net.compress= slave->thd->net.compress;
+        /* and the compression stream of the connection */
+        net.extension= slave->thd->net.extension;
 
         len= my_net_read(&net);
+        net.extension= NULL;
         if (likely(len != packet_error))
-          repl_semisync_master.report_reply_packet(slave->server_id(),
-                                                   net.read_pos, len);
-        else if (net.last_errno == ER_NET_READ_ERROR)
-          listener.clear_socket_info(slave);
-      }
+        {
+          char log_file_name[FN_REFLEN+1];
+          my_off_t log_file_pos;
+
+          if (repl_semisync_master.read_reply_packet(net.read_pos, len,
+                                                     log_file_name,
+                                                     &log_file_pos))
+            break;
+
+          DBUG_PRINT("semisync", ("Got reply(%s, %lu) from server %u",
+                                  log_file_name, (ulong) log_file_pos,
+                                  slave->server_id()));
+          rpl_semi_sync_master_get_ack++;
+          if (!ack_count++ ||
+              Active_tranx::compare(log_file_name, log_file_pos,
+                                    ack_file_name, ack_file_pos) > 0)
+          {
+            strmake_buf(ack_file_name, log_file_name);
+            ack_file_pos= log_file_pos;
+            ack_server_id= slave->server_id();
+          }
+        }
+        else
+        {
+          if (net.last_errno == ER_NET_READ_ERROR)
+            listener.clear_socket_info(slave);
+          break;
+        }
+      } while (vio_pending(&slave->vio) > 0);
     }
+
+    if (ack_count)
+      repl_semisync_master.report_reply_binlog(ack_server_id, ack_file_name,
+                                               ack_file_pos);
     mysql_mutex_unlock(&m_mutex);
   }
 end:
@@ -6893,7 +6893,19 @@ static int queue_event(Master_info* mi, const uchar *buf, ulong event_len)
         int4store(&buf[event_len - BINLOG_CHECKSUM_LEN], crc);
       }
     }
-    if (likely(!rli->relay_log.write_event_buffer((uchar*)buf, event_len)))
+    /*
+      With GTID the relay log is only a buffer between the I/O and the SQL
+      thread: it is purged when replication restarts, and the events are
+      fetched again from the GTID position. So with relay_log_buffered the
+      event need not reach the file before the SQL thread may read it.
+      An event that a semi-synchronous master waits for is written to the
+      file before it is acknowledged.
+    */
+    bool flush= !relay_log_buffered ||
+                mi->using_gtid == Master_info::USE_GTID_NO ||
+                (mi->semi_ack & SEMI_SYNC_NEED_ACK);
+    if (likely(!rli->relay_log.write_event_buffer((uchar*)buf, event_len,
+                                                  flush)))
     {
       mi->master_log_pos+= inc_pos;
       DBUG_PRINT("info", ("master_log_pos: %lu", (ulong) mi->master_log_pos));
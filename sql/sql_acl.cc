@@ -13254,6 +13254,8 @@ static bool send_server_handshake_packet(MPVIO_EXT *mpvio,
     thd->client_capabilities|= CLIENT_TRANSACTIONS;
 
   thd->client_capabilities|= CAN_CLIENT_COMPRESS;
+  DBUG_EXECUTE_IF("no_compress_stream",
+                  thd->client_capabilities&= ~MARIADB_CLIENT_COMPRESS_STREAM;);
 
   if (ssl_acceptor_fd)
   {
@@ -13765,6 +13767,18 @@ static ulong parse_client_handshake_packet(MPVIO_EXT *mpvio,
   thd->client_capabilities&= client_capabilities;
 
   DBUG_PRINT("info", ("client capabilities: %llu", thd->client_capabilities));
+#ifdef HAVE_COMPRESS
+  /*
+    The stream is used from the first packet after the authentication, when
+    prepare_new_connection_state() switches the compression on
+  */
+  if (!(thd->client_capabilities & CLIENT_COMPRESS))
+    thd->client_capabilities&= ~MARIADB_CLIENT_COMPRESS_STREAM;
+  else if ((thd->client_capabilities & MARIADB_CLIENT_COMPRESS_STREAM) &&
+           !thd->m_net_server_extension.m_compress_stream &&
+           net_compress_stream_init(net))
+    return packet_error;
+#endif
   if (thd->client_capabilities & CLIENT_SSL)
   {
     unsigned long errptr __attribute__((unused));
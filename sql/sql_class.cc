@@ -61,6 +61,7 @@
 #include "sql_select.h" /* declares create_tmp_table() */
 #include "debug_sync.h"
 #include "sql_parse.h"                          // is_update_query
+#include "sql_prepare.h"                        // free_prepared_statement_cache
 #include "sql_callback.h"
 #include "lock.h"
 #include "wsrep_mysqld.h"
@@ -764,6 +765,7 @@ THD::THD(my_thread_id id, bool is_wsrep_applier)
   scheduler= thread_scheduler;                 // Will be fixed later
   event_scheduler.data= 0;
   skip_wait_timeout= false;
+  defer_net_flush= false;
   catalog= (char*)"std"; // the only catalog we have for now
   main_security_ctx.init();
   security_ctx= &main_security_ctx;
@@ -812,6 +814,7 @@ THD::THD(my_thread_id id, bool is_wsrep_applier)
   mysql_audit_init_thd(this);
   net.vio=0;
   net.buff= 0;
+  net.extension= 0;
   net.reading_or_writing= 0;
   client_capabilities= 0;                       // minimalistic client
   system_thread= NON_SYSTEM_THREAD;
@@ -1566,6 +1569,8 @@ void THD::cleanup(void)
 
   mysql_ull_cleanup(this);
   stmt_map.reset();
+  free_derived_cache(this);
+  free_prepared_statement_cache(this);
   /* All metadata locks must have been released by now. */
   DBUG_ASSERT(!mdl_context.has_locks());
 
@@ -1775,6 +1780,11 @@ void add_to_status(STATUS_VAR *to_var, STATUS_VAR *from_var)
   to_var->table_open_cache_hits+= from_var->table_open_cache_hits;
   to_var->table_open_cache_misses+= from_var->table_open_cache_misses;
   to_var->table_open_cache_overflows+= from_var->table_open_cache_overflows;
+  to_var->uncompressed_bytes_received+= from_var->uncompressed_bytes_received;
+  to_var->compressed_bytes_received+= from_var->compressed_bytes_received;
+  to_var->uncompressed_bytes_sent+= from_var->uncompressed_bytes_sent;
+  to_var->compressed_bytes_sent+= from_var->compressed_bytes_sent;
+  to_var->compression_time+=    from_var->compression_time;
 
   /*
     Update global_memory_used. We have to do this with atomic_add as the
@@ -1832,6 +1842,16 @@ void add_diff_to_status(STATUS_VAR *to_var, STATUS_VAR *from_var,
                                     dec_var->table_open_cache_misses;
   to_var->table_open_cache_overflows+= from_var->table_open_cache_overflows -
                                        dec_var->table_open_cache_overflows;
+  to_var->uncompressed_bytes_received+= from_var->uncompressed_bytes_received -
+                                        dec_var->uncompressed_bytes_received;
+  to_var->compressed_bytes_received+= from_var->compressed_bytes_received -
+                                      dec_var->compressed_bytes_received;
+  to_var->uncompressed_bytes_sent+= from_var->uncompressed_bytes_sent -
+                                    dec_var->uncompressed_bytes_sent;
+  to_var->compressed_bytes_sent+= from_var->compressed_bytes_sent -
+                                  dec_var->compressed_bytes_sent;
+  to_var->compression_time+=     from_var->compression_time -
+                                 dec_var->compression_time;
 
   /*
     We don't need to accumulate memory_used as these are not reset or used by
@@ -4045,11 +4065,6 @@ get_statement_id_as_hash_key(const uchar *record, size_t *key_length,
   return (uchar *) &((const Statement *) statement)->id;
 }
 
-static void delete_statement_as_hash_key(void *key)
-{
-  delete (Statement *) key;
-}
-
 static uchar *get_stmt_name_hash_key(Statement *entry, size_t *length,
                                     my_bool not_used __attribute__((unused)))
 {
@@ -4069,7 +4084,7 @@ Statement_map::Statement_map() :
   };
   my_hash_init(key_memory_prepared_statement_map, &st_hash, &my_charset_bin,
                START_STMT_HASH_SIZE, 0, 0, get_statement_id_as_hash_key,
-               delete_statement_as_hash_key, MYF(0));
+               NULL, MYF(0));
   my_hash_init(key_memory_prepared_statement_map, &names_hash, system_charset_info, START_NAME_HASH_SIZE, 0, 0,
                (my_hash_get_key) get_stmt_name_hash_key,
                NULL, MYF(0));
@@ -4101,11 +4116,6 @@ int Statement_map::insert(THD *thd, Statement *statement)
 {
   if (my_hash_insert(&st_hash, (uchar*) statement))
   {
-    /*
-      Delete is needed only in case of an insert failure. In all other
-      cases hash_delete will also delete the statement.
-    */
-    delete statement;
     my_error(ER_OUT_OF_RESOURCES, MYF(0));
     goto err_st_hash;
   }
@@ -4141,6 +4151,39 @@ int Statement_map::insert(THD *thd, Statement *statement)
 err_names_hash:
   my_hash_delete(&st_hash, (uchar*) statement);
 err_st_hash:
+  delete statement;
+  return 1;
+}
+
+
+/*
+  Put a statement taken out of the map by detach() back into it.
+
+  DESCRIPTION
+    The statement is still counted in prepared_stmt_count, so unlike
+    insert() this does not check max_prepared_stmt_count.
+
+  RETURN VALUE
+    0  success
+    1  error: out of resources. An error is sent to the client, the
+       statement is released.
+*/
+
+int Statement_map::attach(Statement *statement)
+{
+  if (my_hash_insert(&st_hash, (uchar*) statement))
+    goto err;
+  if (statement->name.str && my_hash_insert(&names_hash, (uchar*) statement))
+  {
+    my_hash_delete(&st_hash, (uchar*) statement);
+    goto err;
+  }
+  last_found_statement= statement;
+  return 0;
+
+err:
+  my_error(ER_OUT_OF_RESOURCES, MYF(0));
+  release_detached(statement);
   return 1;
 }
 
@@ -4156,13 +4199,25 @@ void Statement_map::close_transient_cursors()
 
 
 void Statement_map::erase(Statement *statement)
+{
+  detach(statement);
+  release_detached(statement);
+}
+
+
+void Statement_map::detach(Statement *statement)
 {
   if (statement == last_found_statement)
     last_found_statement= 0;
   if (statement->name.str)
     my_hash_delete(&names_hash, (uchar *) statement);
-
   my_hash_delete(&st_hash, (uchar *) statement);
+}
+
+
+void Statement_map::release_detached(Statement *statement)
+{
+  delete statement;
   mysql_mutex_lock(&LOCK_prepared_stmt_count);
   DBUG_ASSERT(prepared_stmt_count > 0);
   prepared_stmt_count--;
@@ -4181,6 +4236,8 @@ void Statement_map::reset()
     mysql_mutex_unlock(&LOCK_prepared_stmt_count);
   }
   my_hash_reset(&names_hash);
+  for (ulong i= 0; i < st_hash.records; i++)
+    delete (Statement *) my_hash_element(&st_hash, i);
   my_hash_reset(&st_hash);
   last_found_statement= 0;
 }
@@ -51,6 +51,7 @@
 #include "backup.h"
 #include "xa.h"
 #include "ddl_log.h"                            /* DDL_LOG_STATE */
+#include "sql_derived_cache.h"                  /* Table_version_set */
 
 extern "C"
 void set_thd_stage_info(void *thd,
@@ -85,6 +86,7 @@ enum wsrep_consistency_check_mode {
 #endif /* WITH_WSREP */
 
 class Reprepare_observer;
+class Prepared_statement_cache;
 class Relay_log_info;
 struct rpl_group_info;
 struct rpl_parallel_thread;
@@ -118,6 +120,9 @@ enum enum_slave_run_triggers_for_rbr { SLAVE_RUN_TRIGGERS_FOR_RBR_NO,
                                        SLAVE_RUN_TRIGGERS_FOR_RBR_ENFORCE};
 enum enum_slave_type_conversions { SLAVE_TYPE_CONVERSIONS_ALL_LOSSY,
                                    SLAVE_TYPE_CONVERSIONS_ALL_NON_LOSSY};
+enum enum_slave_rows_search_algorithms { SLAVE_ROWS_TABLE_SCAN,
+                                        SLAVE_ROWS_INDEX_SCAN,
+                                        SLAVE_ROWS_HASH_SCAN };
 
 /*
   COLUMNS_READ:       A column is goind to be read.
@@ -762,6 +767,7 @@ typedef struct system_variables
   ulong use_stat_tables;
   ulong histogram_size;
   ulong histogram_type;
+  ulong analyze_ndv_method;
   ulong preload_buff_size;
   ulong profiling_history_size;
   ulong read_buff_size;
@@ -813,6 +819,10 @@ typedef struct system_variables
 
   uint group_concat_max_len;
   uint eq_range_index_dive_limit;
+  uint parallel_scan_threads;
+  ulonglong derived_cache_size;
+  ulonglong subquery_cache_hash_size;
+  ulong prepared_stmt_cache_size;
   uint idle_transaction_timeout;
   uint idle_readonly_transaction_timeout;
   uint idle_write_transaction_timeout;
@@ -914,6 +924,12 @@ typedef struct system_status_var
   ulong com_register_slave;
   ulong created_tmp_disk_tables_;
   ulong created_tmp_tables_;
+  ulong derived_cache_hits;
+  ulong derived_cache_misses;
+  ulong prepared_stmt_cache_hits;
+  ulong prepared_stmt_cache_misses;
+  ulong join_cache_bloom_filter_checks;
+  ulong join_cache_bloom_filter_rejects;
   ulong ha_commit_count;
   ulong ha_delete_count;
   ulong ha_read_first_count;
@@ -1026,8 +1042,13 @@ typedef struct system_status_var
   ulonglong table_open_cache_misses;
   ulonglong table_open_cache_overflows;
   ulonglong send_metadata_skips;
+  /* Packets of the compressed protocol, before and after compression */
+  ulonglong uncompressed_bytes_received, compressed_bytes_received;
+  ulonglong uncompressed_bytes_sent, compressed_bytes_sent;
   double last_query_cost;
   double cpu_time, busy_time;
+  /* Time spent in compressing and uncompressing packets, in seconds */
+  double compression_time;
   uint32 threads_running;
   /* Don't initialize */
   /* Memory used for thread local storage */
@@ -1464,6 +1485,15 @@ class Statement_map
   */
   void close_transient_cursors();
   void erase(Statement *statement);
+  /*
+    Remove the statement from the map without destroying it. The statement
+    stays counted in prepared_stmt_count until it is given to attach() or
+    release_detached().
+  */
+  void detach(Statement *statement);
+  int attach(Statement *statement);
+  /* Destroy a detached statement and stop counting it */
+  static void release_detached(Statement *statement);
   /* Erase all statements (calls Statement destructor) */
   void reset();
   ~Statement_map();
@@ -2718,6 +2748,14 @@ class THD: public THD_count, /* this must be first */
   Statement *last_stmt;
   Statement *cur_stmt= 0;
 
+  /* Materialized derived tables of prepared statements, see
+     sql_derived_cache.cc */
+  Derived_cache *derived_cache= NULL;
+  /* table_change_seq at the start of the prepared statement execution */
+  ulonglong derived_cache_start_seq= 0;
+  /* Closed prepared statements kept for reuse, see sql_prepare.cc */
+  Prepared_statement_cache *ps_cache= NULL;
+
   inline void set_last_stmt(Statement *stmt)
   { last_stmt= (is_error() ? NULL : stmt); }
   inline void clear_last_stmt() { last_stmt= NULL; }
@@ -2895,6 +2933,13 @@ class THD: public THD_count, /* this must be first */
   /* Do not set socket timeouts for wait_timeout (used with threadpool) */
   bool skip_wait_timeout;
 
+  /*
+    The reply to the current command is not flushed when it is complete:
+    do_command() sends it only if the client has not already sent the next
+    command, otherwise it is sent together with the reply to the next one
+  */
+  bool defer_net_flush;
+
   bool prepare_derived_at_open;
 
   /* Set to 1 if status of this THD is already in global status */
@@ -3105,10 +3150,16 @@ class THD: public THD_count, /* this must be first */
        cache (instead of full list of changed in transaction tables).
     */
     CHANGED_TABLE_LIST* changed_tables;
+    /*
+      Table version slots of the tables changed in transaction, that are
+      changed again at its end, see sql_derived_cache.h
+    */
+    Table_version_set changed_table_versions;
     MEM_ROOT mem_root; // Transaction-life memory allocation pool
     void cleanup()
     {
       DBUG_ENTER("THD::st_transactions::cleanup");
+      changed_table_versions.bump();
       changed_tables= 0;
       savepoints= 0;
       implicit_xid.null();
@@ -1240,6 +1240,7 @@ bool mysql_derived_fill(THD *thd, LEX *lex, TABLE_LIST *derived)
   DBUG_ASSERT(derived->table && derived->table->is_created());
   select_unit *derived_result= derived->derived_result;
   SELECT_LEX *save_current_select= lex->current_select;
+  Derived_cache_lookup cache_lookup(thd, derived);
 
   if (derived->pushdown_derived)
   {
@@ -1268,7 +1269,11 @@ bool mysql_derived_fill(THD *thd, LEX *lex, TABLE_LIST *derived)
     }   
   }
   
-  if (derived_is_recursive)
+  if (cache_lookup.fill(thd, &res))
+  {
+    /* The rows were copied from the derived cache */
+  }
+  else if (derived_is_recursive)
   {
     if (derived->is_with_table_recursive_reference())
     {
@@ -1311,6 +1316,8 @@ bool mysql_derived_fill(THD *thd, LEX *lex, TABLE_LIST *derived)
   {
     if (derived_result->flush())
       res= TRUE;
+    else
+      cache_lookup.store(thd);
     unit->executed= TRUE;
 
     if (derived->field_translation)
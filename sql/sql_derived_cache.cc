@@ -0,0 +1,454 @@
+/* Copyright (c) 2026, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+/*
+  Cache of materialized derived tables
+
+  A prepared statement that is executed many times materializes its
+  non-correlated derived tables and CTEs on every execution. With
+  @@derived_cache_size set, the rows of a materialized derived table are
+  kept in a per-session cache and copied into the temporary table by the
+  next execution that has the same text of the derived table (with the
+  values of the parameters), the same session variables that affect
+  results and unchanged base tables.
+
+  The base tables are checked with the table change sequence numbers of
+  sql_derived_cache.h. A result is stored only when none of its tables was
+  changed after the start of the statement execution, so that the result
+  includes every change that was committed up to the number of the slot
+  of each table. A change that is made or committed later changes the
+  number and invalidates the result.
+
+  Only autocommit SELECT statements use the cache, and only derived tables
+  that do not depend on anything but their base tables and parameters:
+  no stored program variables, no functions that are not safe for the
+  query cache, no locking reads, no temporary, system or remote tables.
+*/
+
+#include "mariadb.h"
+#include "sql_base.h"
+#include "sql_select.h"
+#include "sql_derived_cache.h"
+#include "sql_list.h"
+
+Atomic_counter<ulonglong> table_change_seq;
+Atomic_counter<ulonglong> table_versions[TABLE_VERSION_SLOTS + 1];
+
+
+uint table_version_slot(const TABLE_SHARE *share)
+{
+  return my_crc32c(0, share->table_cache_key.str,
+                   share->table_cache_key.length) % TABLE_VERSION_SLOTS;
+}
+
+
+uint table_version_slot(const char *db, const char *table_name)
+{
+  char key[MAX_DBKEY_LENGTH];
+  uint key_length= tdc_create_key(key, db, table_name);
+  return my_crc32c(0, key, key_length) % TABLE_VERSION_SLOTS;
+}
+
+
+/*
+  Register the first change of a table by a statement
+
+  @param share      a non-temporary table
+  @param fk_parent  whether the table is referenced by a foreign key
+*/
+
+void table_version_bump_changed(THD *thd, const TABLE_SHARE *share,
+                                bool fk_parent)
+{
+  Table_version_set *set= &thd->transaction->changed_table_versions;
+  uint slot= table_version_slot(share);
+  table_version_bump(slot);
+  set->add(slot);
+  if (fk_parent)
+  {
+    /* Cascading actions change the child tables inside of the engine */
+    table_version_bump(TABLE_VERSION_ALL);
+    set->add(TABLE_VERSION_ALL);
+  }
+}
+
+
+struct Derived_cache_entry: public ilink
+{
+  LEX_CSTRING key;
+  Derived_cache_dep *deps;
+  size_t n_deps;
+  uchar *rows;
+  ha_rows n_rows;
+  ulong reclength;
+  uint fields;
+  size_t size;
+
+  ~Derived_cache_entry()
+  {
+    my_free(const_cast<char*>(key.str));
+    my_free(deps);
+    my_free(rows);
+  }
+};
+
+
+static const uchar *derived_cache_get_key(const void *entry, size_t *length,
+                                          my_bool)
+{
+  const Derived_cache_entry *e= static_cast<const Derived_cache_entry*>(entry);
+  *length= e->key.length;
+  return reinterpret_cast<const uchar*>(e->key.str);
+}
+
+
+static void derived_cache_free_entry(void *entry)
+{
+  delete static_cast<Derived_cache_entry*>(entry);
+}
+
+
+class Derived_cache
+{
+  HASH hash;
+  /* least recently used entries first */
+  I_List<Derived_cache_entry> lru;
+  /* total size of the entries */
+  size_t size;
+
+public:
+  Derived_cache(): size(0)
+  {
+    my_hash_init(PSI_INSTRUMENT_ME, &hash, &my_charset_bin, 16, 0, 0,
+                 (my_hash_get_key) derived_cache_get_key,
+                 derived_cache_free_entry, HASH_UNIQUE);
+  }
+
+  ~Derived_cache() { my_hash_free(&hash); }
+
+  Derived_cache_entry *find(const String &key)
+  {
+    Derived_cache_entry *e= (Derived_cache_entry*)
+      my_hash_search(&hash, (const uchar*) key.ptr(), key.length());
+    if (e)
+    {
+      e->unlink();
+      lru.push_back(e);
+    }
+    return e;
+  }
+
+  void remove(Derived_cache_entry *e)
+  {
+    e->unlink();
+    size-= e->size;
+    my_hash_delete(&hash, (uchar*) e);
+  }
+
+  /* Remove the least recently used entries until the size is <= limit */
+  void shrink(size_t limit)
+  {
+    while (size > limit)
+      remove(lru.head());
+  }
+
+  void insert(Derived_cache_entry *e, size_t limit)
+  {
+    if (Derived_cache_entry *old= (Derived_cache_entry*)
+        my_hash_search(&hash, (const uchar*) e->key.str, e->key.length))
+      remove(old);
+    shrink(limit - e->size);
+    if (my_hash_insert(&hash, (uchar*) e))
+    {
+      delete e;
+      return;
+    }
+    lru.push_back(e);
+    size+= e->size;
+  }
+};
+
+
+void free_derived_cache(THD *thd)
+{
+  delete thd->derived_cache;
+  thd->derived_cache= NULL;
+}
+
+
+void shrink_derived_cache(THD *thd)
+{
+  if (!thd->variables.derived_cache_size)
+    free_derived_cache(thd);
+  else if (thd->derived_cache)
+    thd->derived_cache->shrink((size_t) thd->variables.derived_cache_size);
+}
+
+
+static bool collect_unit_tables(SELECT_LEX_UNIT *unit,
+                                Dynamic_array<Derived_cache_dep> *deps);
+
+/*
+  Add the base tables that a table reference reads
+
+  @return true if the result cannot be cached
+*/
+
+static bool collect_table(TABLE_LIST *tl,
+                          Dynamic_array<Derived_cache_dep> *deps)
+{
+  if (tl->is_view_or_derived())
+  {
+    if (tl->is_recursive_with_table() || tl->pushdown_derived)
+      return true;
+    return collect_unit_tables(tl->get_unit(), deps);
+  }
+
+  TABLE *table= tl->table;
+  if (!table || tl->schema_table || tl->table_function || tl->jtbm_subselect ||
+      table->s->tmp_table != NO_TMP_TABLE || table->s->sequence ||
+      table->s->db_type()->db_type == DB_TYPE_MRG_MYISAM ||
+      table->file->table_cache_type() == HA_CACHE_TBL_NOCACHE ||
+      (tl->lock_type != TL_READ && tl->lock_type != TL_READ_HIGH_PRIORITY))
+    return true;
+
+  Derived_cache_dep dep;
+  dep.slot= table_version_slot(table->s);
+  dep.version= 0;
+  memset(dep.tabledef_version, 0, sizeof dep.tabledef_version);
+  memcpy(dep.tabledef_version, table->s->tabledef_version.str,
+         MY_MIN(table->s->tabledef_version.length,
+                sizeof dep.tabledef_version));
+  return deps->append(dep);
+}
+
+
+static bool collect_select_tables(SELECT_LEX *sl,
+                                  Dynamic_array<Derived_cache_dep> *deps)
+{
+  for (TABLE_LIST *tl= sl->table_list.first; tl; tl= tl->next_local)
+    if (collect_table(tl, deps))
+      return true;
+
+  /* Tables of merged semi-join subqueries */
+  List_iterator_fast<TABLE_LIST> li(sl->leaf_tables);
+  while (TABLE_LIST *tl= li++)
+    if (collect_table(tl, deps))
+      return true;
+
+  for (SELECT_LEX_UNIT *u= sl->first_inner_unit(); u; u= u->next_unit())
+    if (collect_unit_tables(u, deps))
+      return true;
+  return false;
+}
+
+
+static bool collect_unit_tables(SELECT_LEX_UNIT *unit,
+                                Dynamic_array<Derived_cache_dep> *deps)
+{
+  for (SELECT_LEX *sl= unit->first_select(); sl; sl= sl->next_select())
+    if (collect_select_tables(sl, deps))
+      return true;
+  return unit->fake_select_lex &&
+         collect_select_tables(unit->fake_select_lex, deps);
+}
+
+
+static bool derived_cache_applicable(THD *thd, TABLE_LIST *derived)
+{
+  SELECT_LEX_UNIT *unit= derived->get_unit();
+  LEX *lex= thd->lex;
+  return thd->variables.derived_cache_size &&
+         thd->stmt_arena->is_stmt_execute() &&
+         !thd->spcont && !thd->in_sub_stmt &&
+         !thd->in_multi_stmt_transaction_mode() &&
+         lex->sql_command == SQLCOM_SELECT &&
+         !lex->describe && !lex->analyze_stmt &&
+         lex->safe_to_cache_query &&
+         !unit->uncacheable && !unit->executed &&
+         !derived->is_recursive_with_table() &&
+         !derived->pushdown_derived &&
+         !derived->table->s->blob_fields;
+}
+
+
+Derived_cache_lookup::Derived_cache_lookup(THD *thd, TABLE_LIST *derived)
+  : derived(derived), deps(PSI_INSTRUMENT_MEM, 4, 4), active(false),
+    hit(false)
+{
+  if (!derived_cache_applicable(thd, derived) ||
+      collect_unit_tables(derived->get_unit(), &deps))
+    return;
+
+  const system_variables &v= thd->variables;
+  const ulonglong env[]=
+  {
+    v.sql_mode, v.collation_connection->number, v.lc_time_names->number,
+    v.div_precincrement, v.default_week_format, v.group_concat_max_len,
+    v.max_sort_length, (ulonglong) (intptr) v.time_zone
+  };
+  key.set_charset(&my_charset_bin);
+  if (key.append(thd->db.str, thd->db.length) || key.append('\0') ||
+      key.append((const char*) env, sizeof env))
+    return;
+  derived->get_unit()->print(&key, QT_ORDINARY);
+  active= !thd->is_error();
+}
+
+
+/*
+  Fill the derived table from the cache
+
+  @param[out] error  set to true on an error
+
+  @return whether the table was filled
+*/
+
+bool Derived_cache_lookup::fill(THD *thd, bool *error)
+{
+  if (!active)
+    return false;
+
+  Derived_cache *cache= thd->derived_cache;
+  Derived_cache_entry *e= cache ? cache->find(key) : NULL;
+  TABLE *table= derived->table;
+
+  if (e)
+  {
+    bool valid= e->n_deps == deps.elements() &&
+                e->reclength == table->s->reclength &&
+                e->fields == table->s->fields &&
+                table_versions[TABLE_VERSION_ALL] == e->deps[0].version;
+    for (size_t i= 0; valid && i < deps.elements(); i++)
+    {
+      const Derived_cache_dep &d= e->deps[i + 1];
+      valid= d.slot == deps.at(i).slot &&
+             table_versions[d.slot] == d.version &&
+             !memcmp(d.tabledef_version, deps.at(i).tabledef_version,
+                     sizeof d.tabledef_version);
+    }
+    if (!valid)
+    {
+      cache->remove(e);
+      e= NULL;
+    }
+  }
+
+  if (!e)
+  {
+    thd->status_var.derived_cache_misses++;
+    return false;
+  }
+
+  select_unit *result= derived->derived_result;
+  const uchar *row= e->rows;
+  for (ha_rows i= 0; i < e->n_rows; i++, row+= e->reclength)
+  {
+    memcpy(table->record[0], row, e->reclength);
+    if (result->write_record() > 0)
+    {
+      *error= true;
+      break;
+    }
+  }
+  thd->status_var.derived_cache_hits++;
+  hit= true;
+  return true;
+}
+
+
+/*
+  Store the rows of the filled derived table in the cache
+*/
+
+void Derived_cache_lookup::store(THD *thd)
+{
+  if (!active || hit)
+    return;
+
+  /*
+    The entry is valid only if the tables were not changed after the
+    execution started: a change that was made in between may or may not
+    be included in the result.
+  */
+  const ulonglong start_seq= thd->derived_cache_start_seq;
+  if (table_versions[TABLE_VERSION_ALL] > start_seq)
+    return;
+  for (size_t i= 0; i < deps.elements(); i++)
+  {
+    Derived_cache_dep &d= deps.at(i);
+    if ((d.version= table_versions[d.slot]) > start_seq)
+      return;
+  }
+
+  TABLE *table= derived->table;
+  handler *file= table->file;
+  const size_t limit= (size_t) thd->variables.derived_cache_size;
+  file->info(HA_STATUS_VARIABLE);
+  const ha_rows n_rows= file->stats.records;
+  const ulong reclength= table->s->reclength;
+  const size_t n_deps= deps.elements() + 1;
+  const size_t size= sizeof(Derived_cache_entry) + key.length() +
+                     n_deps * sizeof(Derived_cache_dep);
+  if (size > limit || n_rows > (limit - size) / reclength)
+    return;
+
+  Derived_cache_entry *e= new Derived_cache_entry;
+  e->key.length= key.length();
+  e->key.str= (char*) my_memdup(PSI_INSTRUMENT_ME, key.ptr(), key.length(),
+                                MYF(0));
+  e->deps= (Derived_cache_dep*)
+    my_malloc(PSI_INSTRUMENT_ME, n_deps * sizeof(Derived_cache_dep), MYF(0));
+  e->rows= (uchar*) my_malloc(PSI_INSTRUMENT_ME,
+                              (size_t) n_rows * reclength + 1, MYF(0));
+  e->n_deps= deps.elements();
+  e->n_rows= 0;
+  e->reclength= reclength;
+  e->fields= table->s->fields;
+  e->size= size + (size_t) n_rows * reclength;
+
+  bool ok= e->key.str && e->deps && e->rows && !file->ha_rnd_init(1);
+  if (ok)
+  {
+    e->deps[0].slot= TABLE_VERSION_ALL;
+    e->deps[0].version= table_versions[TABLE_VERSION_ALL];
+    for (size_t i= 0; i < deps.elements(); i++)
+      e->deps[i + 1]= deps.at(i);
+
+    int err;
+    while ((err= file->ha_rnd_next(table->record[0])) != HA_ERR_END_OF_FILE)
+    {
+      if (err == HA_ERR_RECORD_DELETED)
+        continue;
+      if (err || e->n_rows == n_rows)
+      {
+        ok= false;
+        break;
+      }
+      memcpy(e->rows + e->n_rows++ * reclength, table->record[0], reclength);
+    }
+    file->ha_rnd_end();
+  }
+
+  if (!ok)
+  {
+    delete e;
+    return;
+  }
+
+  if (!thd->derived_cache)
+    thd->derived_cache= new Derived_cache;
+  thd->derived_cache->insert(e, limit);
+}
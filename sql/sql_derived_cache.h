@@ -0,0 +1,127 @@
+#ifndef SQL_DERIVED_CACHE_INCLUDED
+#define SQL_DERIVED_CACHE_INCLUDED
+
+/* Copyright (c) 2026, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+#include "my_counter.h"
+#include "sql_string.h"
+#include "sql_array.h"
+#include <my_bit.h>
+#include <string.h>
+
+class THD;
+class Derived_cache;
+struct TABLE_LIST;
+struct TABLE_SHARE;
+
+/*
+  Table change sequence numbers
+
+  A change of the rows of a table stores a new number from the global
+  sequence table_change_seq into one of TABLE_VERSION_SLOTS slots, chosen
+  by a hash of the table name. A result that was computed from a table
+  stays valid while the slot of the table keeps its number. Tables that
+  share a slot invalidate each other's results, which only costs a cache
+  miss.
+
+  The slot of a table is changed on the first change of the table by a
+  statement, at the end of the statement and at the end of the transaction,
+  so that a result that was read in between is invalidated when the change
+  becomes visible.
+
+  The slot TABLE_VERSION_ALL is changed by the changes that are not done
+  through a handler of the changed table, like cascading foreign key
+  actions and the commit of a detached XA transaction; every result
+  depends on it. DDL that replaces the rows of a table but keeps its
+  definition, like TRUNCATE by recreating the table and EXCHANGE
+  PARTITION, changes the slot of the table by its name.
+*/
+static constexpr uint TABLE_VERSION_SLOTS= 1024;
+static constexpr uint TABLE_VERSION_ALL= TABLE_VERSION_SLOTS;
+
+extern Atomic_counter<ulonglong> table_change_seq;
+extern Atomic_counter<ulonglong> table_versions[TABLE_VERSION_SLOTS + 1];
+
+uint table_version_slot(const TABLE_SHARE *share);
+uint table_version_slot(const char *db, const char *table_name);
+
+static inline void table_version_bump(uint slot)
+{
+  table_versions[slot]= ++table_change_seq;
+}
+
+void table_version_bump_changed(THD *thd, const TABLE_SHARE *share,
+                                bool fk_parent);
+
+
+/* The table version slots that were changed in a transaction */
+class Table_version_set
+{
+  ulonglong bits[(TABLE_VERSION_SLOTS + 1 + 63) / 64];
+  bool changed;
+public:
+  void add(uint slot)
+  {
+    bits[slot / 64]|= 1ULL << (slot % 64);
+    changed= true;
+  }
+  /* Change the slots of the set, at the end of the transaction */
+  void bump()
+  {
+    if (!changed)
+      return;
+    for (uint i= 0; i < array_elements(bits); i++)
+      for (ulonglong b= bits[i]; b; b&= b - 1)
+        table_version_bump(i * 64 + my_find_first_bit(b));
+    memset(bits, 0, sizeof bits);
+    changed= false;
+  }
+};
+
+
+/* A table that a cached result was computed from */
+struct Derived_cache_dep
+{
+  uint slot;
+  ulonglong version;
+  uchar tabledef_version[MY_UUID_SIZE];
+};
+
+void free_derived_cache(THD *thd);
+/* Reduce the cache of the session to @@derived_cache_size */
+void shrink_derived_cache(THD *thd);
+
+/*
+  Lookup of a materialized derived table or CTE of a prepared statement
+  in the per-session cache, see sql_derived_cache.cc
+*/
+class Derived_cache_lookup
+{
+  TABLE_LIST *derived;
+  /* the session variables the result depends on and the query text */
+  String key;
+  Dynamic_array<Derived_cache_dep> deps;
+  bool active;
+  bool hit;
+public:
+  Derived_cache_lookup(THD *thd, TABLE_LIST *derived);
+  /* Fill the table from the cache; return true if the table was filled */
+  bool fill(THD *thd, bool *error);
+  /* Store the rows of the filled table in the cache */
+  void store(THD *thd);
+};
+
+#endif /* SQL_DERIVED_CACHE_INCLUDED */
@@ -842,6 +842,8 @@ bool Explain_node::print_explain_json_cache(Json_writer *writer,
       writer->add_member("state").
         add_str(Expression_cache_tracker::state_str[cache_tracker->state]);
     }
+    if (cache_tracker->hash)
+      writer->add_member("backend").add_str("hash");
 
     if (is_analyze)
     {
@@ -852,6 +854,8 @@ bool Explain_node::print_explain_json_cache(Json_writer *writer,
         double hit_ratio= double(cache_tracker->hit) / cache_reads * 100.0;
         writer->add_member("r_hit_ratio").add_double(hit_ratio);
       }
+      if (cache_tracker->hash)
+        writer->add_member("r_evictions").add_ll(cache_tracker->evictions);
     }
     return true;
   }
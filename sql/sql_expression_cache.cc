@@ -33,6 +33,17 @@
   impact in the case when the cache is not applicable)
 */
 #define EXPCACHE_CHECK_HIT_RATIO_AFTER 200
+/**
+  Maximum lengths of the key (the parameters with their NULL flags) and of
+  the result (with its NULL flag) for the in-memory hash table
+*/
+#define EXPCACHE_HASH_MAX_KEY_LENGTH 128
+#define EXPCACHE_HASH_MAX_RESULT_LENGTH 65
+/**
+  Maximum number of lookups that a hash table cache with a bad hit rate
+  skips before it is tried again
+*/
+#define EXPCACHE_MAX_PAUSE (64 * 1024)
 
 /*
   Expression cache is used only for caching subqueries now, so its statistic
@@ -40,10 +51,219 @@
 */
 ulong subquery_cache_miss, subquery_cache_hit;
 
+
+/**
+  Open addressing hash table of the expression cache
+
+  @details
+  The entries have a fixed length: the key is the image of the parameter
+  fields and the result is the image of the result field, each prefixed
+  with a NULL flag. Collisions are resolved by linear probing, and entries
+  are removed by shifting the following entries of the probe sequence
+  back. The entries are also linked into a list in the order of their
+  use; when the table has reached its maximal size, the least recently
+  used entry is evicted for a new one.
+*/
+
+class Expression_cache_hash
+{
+  struct entry_header
+  {
+    uint32 hash;
+    /* the previous and the next entry in the LRU list */
+    uint32 prev, next;
+    uint32 used;
+  };
+  static const uint32 NIL= UINT_MAX32;
+
+  const uint key_length, result_length, entry_length;
+  const size_t max_size;
+  uchar *entries;
+  uint32 mask;
+  uint32 records, max_records;
+  /* the least and the most recently used entries */
+  uint32 lru_first, lru_last;
+
+  entry_header *header(uint32 i) const
+  { return (entry_header*) (entries + (size_t) i * entry_length); }
+  uchar *key(uint32 i) const { return (uchar*) (header(i) + 1); }
+
+  void lru_unlink(uint32 i)
+  {
+    entry_header *h= header(i);
+    if (h->prev == NIL)
+      lru_first= h->next;
+    else
+      header(h->prev)->next= h->next;
+    if (h->next == NIL)
+      lru_last= h->prev;
+    else
+      header(h->next)->prev= h->prev;
+  }
+
+  void lru_append(uint32 i)
+  {
+    entry_header *h= header(i);
+    h->prev= lru_last;
+    h->next= NIL;
+    if (lru_last == NIL)
+      lru_first= i;
+    else
+      header(lru_last)->next= i;
+    lru_last= i;
+  }
+
+  /* Move entry from to the free position to */
+  void move(uint32 from, uint32 to)
+  {
+    memcpy(header(to), header(from), entry_length);
+    entry_header *h= header(to);
+    if (h->prev == NIL)
+      lru_first= to;
+    else
+      header(h->prev)->next= to;
+    if (h->next == NIL)
+      lru_last= to;
+    else
+      header(h->next)->prev= to;
+    header(from)->used= 0;
+  }
+
+  void remove(uint32 i)
+  {
+    lru_unlink(i);
+    header(i)->used= 0;
+    records--;
+    /* Shift back the entries that cannot be found past the hole */
+    for (uint32 j= (i + 1) & mask; header(j)->used; j= (j + 1) & mask)
+    {
+      uint32 home= header(j)->hash & mask;
+      if (i <= j ? (home <= i || home > j) : (home <= i && home > j))
+      {
+        move(j, i);
+        i= j;
+      }
+    }
+  }
+
+  uint32 insert_position(uint32 hash) const
+  {
+    uint32 i= hash & mask;
+    while (header(i)->used)
+      i= (i + 1) & mask;
+    return i;
+  }
+
+  bool resize(uint32 capacity)
+  {
+    uchar *old= entries;
+    uint32 i= lru_first;
+    if (!(entries= (uchar*) my_malloc(PSI_INSTRUMENT_ME,
+                                      (size_t) capacity * entry_length,
+                                      MYF(MY_THREAD_SPECIFIC | MY_ZEROFILL))))
+    {
+      entries= old;
+      return true;
+    }
+    uchar *new_entries= entries;
+    mask= capacity - 1;
+    max_records= capacity / 4 * 3;
+    lru_first= lru_last= NIL;
+    /* Reinsert the old entries in the LRU order */
+    while (i != NIL)
+    {
+      entry_header *h= (entry_header*) (old + (size_t) i * entry_length);
+      uint32 pos= insert_position(h->hash);
+      memcpy(new_entries + (size_t) pos * entry_length, h, entry_length);
+      lru_append(pos);
+      i= h->next;
+    }
+    my_free(old);
+    return false;
+  }
+
+public:
+  /** Number of entries that were evicted */
+  ulong evictions;
+
+  static const uint INITIAL_CAPACITY= 64;
+
+  Expression_cache_hash(uint key_len, uint result_len, size_t size)
+    :key_length(key_len), result_length(result_len),
+     entry_length(MY_ALIGN(sizeof(entry_header) + key_len + result_len, 8)),
+     max_size(size), entries(NULL), mask(0), records(0), max_records(0),
+     lru_first(NIL), lru_last(NIL), evictions(0), lookup_missed(false)
+  {}
+  ~Expression_cache_hash() { my_free(entries); }
+
+  bool init()
+  {
+    return (size_t) INITIAL_CAPACITY * entry_length > max_size ||
+           resize(INITIAL_CAPACITY);
+  }
+
+  static uint32 hash_key(const uchar *key, uint length)
+  { return my_crc32c(0, key, length); }
+
+  /**
+    Find the result for a key
+
+    @return the result image, or NULL if the key is not in the table
+  */
+  const uchar *find(const uchar *k, uint32 hash)
+  {
+    for (uint32 i= hash & mask; header(i)->used; i= (i + 1) & mask)
+    {
+      if (header(i)->hash == hash && !memcmp(key(i), k, key_length))
+      {
+        lru_unlink(i);
+        lru_append(i);
+        return key(i) + key_length;
+      }
+    }
+    return NULL;
+  }
+
+  /**
+    Add a key that is not in the table, with its result
+  */
+  void insert(const uchar *k, uint32 hash, const uchar *result)
+  {
+    if (records == max_records)
+    {
+      size_t capacity= (size_t) mask + 1;
+      if (capacity * 2 * entry_length > max_size || capacity >= UINT_MAX32 / 2 ||
+          resize((uint32) capacity * 2))
+      {
+        remove(lru_first);
+        evictions++;
+      }
+    }
+    uint32 i= insert_position(hash);
+    entry_header *h= header(i);
+    h->hash= hash;
+    h->used= 1;
+    memcpy(key(i), k, key_length);
+    memcpy(key(i) + key_length, result, result_length);
+    lru_append(i);
+    records++;
+  }
+
+  /** The key of the last lookup and its hash value */
+  uchar lookup_key[EXPCACHE_HASH_MAX_KEY_LENGTH];
+  uint32 lookup_hash;
+  /** Whether the last lookup was a miss that put_value() may add */
+  bool lookup_missed;
+  uchar result[EXPCACHE_HASH_MAX_RESULT_LENGTH];
+};
+
+
 Expression_cache_tmptable::Expression_cache_tmptable(THD *thd,
                                                      List<Item> &dependants,
                                                      Item *value)
-  :cache_table(NULL), table_thd(thd), tracker(NULL), items(dependants), val(value),
+  :cache_table(NULL), table_thd(thd), tracker(NULL), hash(NULL),
+   paused_lookups(0), pause_length(EXPCACHE_CHECK_HIT_RATIO_AFTER),
+   window_hit(0), window_miss(0), items(dependants), val(value),
    hit(0), miss(0), inited (0)
 {
   DBUG_ENTER("Expression_cache_tmptable::Expression_cache_tmptable");
@@ -62,11 +282,119 @@ void Expression_cache_tmptable::disable_cache()
   free_tmp_table(table_thd, cache_table);
   cache_table= NULL;
   update_tracker();
+  delete hash;
+  hash= NULL;
   if (tracker)
     tracker->detach_from_cache();
 }
 
 
+void Expression_cache_tmptable::update_tracker()
+{
+  if (tracker)
+  {
+    tracker->set(hit, miss, (inited ? (cache_table ?
+                                       (paused_lookups ?
+                                        Expression_cache_tracker::PAUSED :
+                                        Expression_cache_tracker::OK) :
+                                       Expression_cache_tracker::STOPPED) :
+                             Expression_cache_tracker::UNINITED));
+    if (hash)
+      tracker->set_hash(hash->evictions);
+  }
+}
+
+
+/**
+  Set up the in-memory hash table instead of the temporary table index
+
+  @details
+  The hash table is used if @@subquery_cache_hash_size is set and the
+  parameters and the result have short images without BLOB parts.
+  Fields that keep a part of their value outside of Field::ptr (BIT
+  fields of a table with uneven bits) cannot be copied as an image and
+  also use the temporary table.
+
+  @retval TRUE  the hash table is used
+  @retval FALSE the temporary table should be used
+*/
+
+bool Expression_cache_tmptable::init_hash()
+{
+  const ulonglong size= table_thd->variables.subquery_cache_hash_size;
+  uint key_length= 0;
+
+  if (!size)
+    return FALSE;
+  for (uint i= 0; i < cache_table->s->fields; i++)
+  {
+    Field *field= cache_table->field[i];
+    if ((field->flags & BLOB_FLAG) ||
+        field->type() == MYSQL_TYPE_BIT ||
+        field->pack_length() != field->pack_length_in_rec())
+      return FALSE;
+    if (i)
+      key_length+= 1 + field->pack_length();
+  }
+  Field *result= cache_table->field[0];
+  if (key_length > EXPCACHE_HASH_MAX_KEY_LENGTH ||
+      1 + result->pack_length() > EXPCACHE_HASH_MAX_RESULT_LENGTH)
+    return FALSE;
+
+  if (!(hash= new Expression_cache_hash(key_length, 1 + result->pack_length(),
+                                        (size_t) size)) ||
+      hash->init())
+  {
+    delete hash;
+    hash= NULL;
+    return FALSE;
+  }
+  return TRUE;
+}
+
+
+/**
+  Store the current parameter values in the fields and build the hash key
+
+  @details
+  The key consists of the NULL flag and the image of each parameter field.
+  Only the used part of a VARCHAR image is copied, so that equal values
+  have equal keys.
+
+  @retval FALSE OK
+  @retval TRUE  Error
+*/
+
+bool Expression_cache_tmptable::make_hash_key()
+{
+  List_iterator<Item> li(items);
+  uchar *pos= hash->lookup_key;
+  Item *item;
+
+  li++;  // skip result field
+  for (uint i= 1; (item= li++); i++)
+  {
+    Field *field= cache_table->field[i];
+    const uint length= field->pack_length();
+    item->save_in_field(field, TRUE);
+    if ((*pos++= (uchar) field->is_null()))
+      bzero(pos, length);
+    else if (field->real_type() == MYSQL_TYPE_VARCHAR)
+    {
+      uint used= ((Field_varstring*) field)->length_bytes + field->data_length();
+      memcpy(pos, field->ptr, used);
+      bzero(pos + used, length - used);
+    }
+    else
+      memcpy(pos, field->ptr, length);
+    pos+= length;
+  }
+  hash->lookup_hash= Expression_cache_hash::hash_key(hash->lookup_key,
+                                                     (uint) (pos - hash->lookup_key));
+  return table_thd->is_error();
+}
+
+
 /**
   Field enumerator for TABLE::add_tmp_key
 
@@ -132,6 +460,16 @@ void Expression_cache_tmptable::init()
     DBUG_VOID_RETURN;
   }
 
+  if (init_hash())
+  {
+    /* The table is not created; only its fields are used */
+    if (!(cached_result= new (table_thd->mem_root)
+          Item_field(table_thd, cache_table->field[0])))
+      goto error;
+    update_tracker();
+    DBUG_VOID_RETURN;
+  }
+
   if (cache_table->s->db_type() != heap_hton)
   {
     DBUG_PRINT("error", ("we need only heap table"));
@@ -216,6 +554,58 @@ Expression_cache::result Expression_cache_tmptable::check_value(Item **value)
   int res;
   DBUG_ENTER("Expression_cache_tmptable::check_value");
 
+  if (hash)
+  {
+    hash->lookup_missed= FALSE;
+    if (paused_lookups)
+    {
+      if (!--paused_lookups)
+        update_tracker();
+      DBUG_RETURN(MISS);
+    }
+    if (make_hash_key())
+      DBUG_RETURN(ERROR);
+
+    if (const uchar *found= hash->find(hash->lookup_key, hash->lookup_hash))
+    {
+      Field *field= cache_table->field[0];
+      if (found[0])
+        field->set_null();
+      else
+      {
+        field->set_notnull();
+        memcpy(field->ptr, found + 1, field->pack_length());
+      }
+      hit++;
+      window_hit++;
+      *value= cached_result;
+      DBUG_RETURN(Expression_cache::HIT);
+    }
+
+    miss++;
+    hash->lookup_missed= TRUE;
+    if (++window_miss == EXPCACHE_CHECK_HIT_RATIO_AFTER)
+    {
+      /*
+        Instead of switching the cache off, skip a growing number of
+        lookups while the hit rate is bad, and try again after that
+      */
+      if ((double) window_hit / ((double) window_hit + window_miss) <
+          EXPCACHE_MIN_HIT_RATE_FOR_MEM_TABLE)
+      {
+        DBUG_PRINT("info", ("hit rate is not so good, pausing the cache"));
+        paused_lookups= pause_length;
+        pause_length= MY_MIN(pause_length * 2, EXPCACHE_MAX_PAUSE);
+        hash->lookup_missed= FALSE;
+        update_tracker();
+      }
+      else
+        pause_length= EXPCACHE_CHECK_HIT_RATIO_AFTER;
+      window_hit= window_miss= 0;
+    }
+    DBUG_RETURN(MISS);
+  }
+
   if (cache_table)
   {
     DBUG_PRINT("info", ("status: %u  has_record %u",
@@ -270,6 +660,23 @@ my_bool Expression_cache_tmptable::put_value(Item *value)
     DBUG_RETURN(FALSE);
   }
 
+  if (hash)
+  {
+    Field *field= cache_table->field[0];
+    if (!hash->lookup_missed)
+      DBUG_RETURN(FALSE);
+    hash->lookup_missed= FALSE;
+    value->save_in_field(field, TRUE);
+    if (unlikely(table_thd->is_error()))
+      goto err;
+    if ((hash->result[0]= (uchar) field->is_null()))
+      bzero(hash->result + 1, field->pack_length());
+    else
+      memcpy(hash->result + 1, field->ptr, field->pack_length());
+    hash->insert(hash->lookup_key, hash->lookup_hash, hash->result);
+    DBUG_RETURN(FALSE);
+  }
+
   *(items.head_ref())= value;
   fill_record(table_thd, cache_table, cache_table->field, items, TRUE, TRUE);
   if (unlikely(table_thd->is_error()))
@@ -339,5 +746,5 @@ void Expression_cache_tmptable::print(String *str, enum_query_type query_type)
 }
 
 
-const char *Expression_cache_tracker::state_str[3]=
-{"uninitialized", "disabled", "enabled"};
+const char *Expression_cache_tracker::state_str[4]=
+{"uninitialized", "disabled", "enabled", "paused"};
@@ -73,14 +73,15 @@ class Expression_cache :public Sql_alloc
 struct st_table_ref;
 struct st_join_table;
 class Item_field;
+class Expression_cache_hash;
 
 
 class Expression_cache_tracker :public Sql_alloc
 {
 public:
-  enum expr_cache_state {UNINITED, STOPPED, OK};
+  enum expr_cache_state {UNINITED, STOPPED, OK, PAUSED};
   Expression_cache_tracker(Expression_cache *c) :
-    cache(c), hit(0), miss(0), state(UNINITED)
+    cache(c), hit(0), miss(0), state(UNINITED), hash(false), evictions(0)
   {}
 
 private:
@@ -90,10 +91,15 @@ class Expression_cache_tracker :public Sql_alloc
 public:
   ulong hit, miss;
   enum expr_cache_state state;
+  /* The cache uses an in-memory hash table instead of a temporary table */
+  bool hash;
+  /* Entries that were removed from the full hash table */
+  ulong evictions;
 
-  static const char* state_str[3];
+  static const char* state_str[4];
   void set(ulong h, ulong m, enum expr_cache_state s)
   {hit= h; miss= m; state= s;}
+  void set_hash(ulong e) { hash= true; evictions= e; }
 
   void detach_from_cache() { cache= NULL; }
   void fetch_current_stats()
@@ -125,19 +131,12 @@ class Expression_cache_tmptable :public Expression_cache
     tracker= st;
     update_tracker();
   }
-  virtual void update_tracker()
-  {
-    if (tracker)
-    {
-      tracker->set(hit, miss, (inited ? (cache_table ?
-                                         Expression_cache_tracker::OK :
-                                         Expression_cache_tracker::STOPPED) :
-                               Expression_cache_tracker::UNINITED));
-    }
-  }
+  virtual void update_tracker();
 
 private:
   void disable_cache();
+  bool init_hash();
+  bool make_hash_key();
 
   /* tmp table parameters */
   TMP_TABLE_PARAM cache_table_param;
@@ -149,6 +148,17 @@ class Expression_cache_tmptable :public Expression_cache
   Expression_cache_tracker *tracker;
   /* TABLE_REF for index lookup */
   struct st_table_ref ref;
+  /*
+    In-memory hash table used instead of the temporary table for short
+    keys and results; the table then only provides the record buffer
+  */
+  Expression_cache_hash *hash;
+  /* Lookups left to be skipped while the hash table is paused */
+  ulong paused_lookups;
+  /* Length of the next pause */
+  ulong pause_length;
+  /* hits/misses since the last check of the hit rate */
+  ulong window_hit, window_miss;
   /* Cached result */
   Item_field *cached_result;
   /* List of parameter items */
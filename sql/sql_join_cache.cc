@@ -2329,6 +2329,8 @@ enum_nested_loop_state JOIN_CACHE::join_matching_records(bool skip_last)
   if (join_tab->need_to_build_rowid_filter)
     join_tab->build_range_rowid_filter();
 
+  build_key_filter();
+
   /* Prepare to retrieve all records of the joined table */
   if (unlikely((error= join_tab_scan->open())))
   { 
@@ -2803,7 +2805,7 @@ int JOIN_CACHE_HASHED::init(bool for_explain)
   ref_key_info= join_tab->get_keyinfo_by_key_no(join_tab->ref.key);
   ref_used_key_parts= join_tab->ref.key_parts;
 
-  hash_func= &JOIN_CACHE_HASHED::get_hash_idx_simple;
+  hash_func= &JOIN_CACHE_HASHED::get_hash_value_simple;
   hash_cmp_func= &JOIN_CACHE_HASHED::equal_keys_simple;
 
   KEY_PART_INFO *key_part= ref_key_info->key_part;
@@ -2812,7 +2814,7 @@ int JOIN_CACHE_HASHED::init(bool for_explain)
   {
     if (!key_part->field->eq_cmp_as_binary())
     {
-      hash_func= &JOIN_CACHE_HASHED::get_hash_idx_complex;
+      hash_func= &JOIN_CACHE_HASHED::get_hash_value_complex;
       hash_cmp_func= &JOIN_CACHE_HASHED::equal_keys_complex;
       break;
     }
@@ -3202,7 +3204,7 @@ bool JOIN_CACHE_HASHED::key_search(uchar *key, uint key_len,
                                    uchar **key_ref_ptr) 
 {
   bool is_found= FALSE;
-  uint idx= (this->*hash_func)(key, key_length);
+  uint idx= (uint) ((this->*hash_func)(key, key_length) % hash_entries);
   uchar *ref_ptr= hash_table+size_of_key_ofs*idx;
   while (!is_null_key_ref(ref_ptr))
   {
@@ -3226,21 +3228,22 @@ bool JOIN_CACHE_HASHED::key_search(uchar *key, uint key_len,
   Hash function that considers a key in the hash table as byte array
 
   SYNOPSIS
-    get_hash_idx_simple()
+    get_hash_value_simple()
       key             pointer to the key value
       key_len         key value length
       
   DESCRIPTION
-    The function calculates an index of the hash entry in the hash table
-    of the join buffer for the given key. It considers the key just as
-    a sequence of bytes of the length key_len.
+    The function calculates the hash value of the given key. It considers
+    the key just as a sequence of bytes of the length key_len.
+    The index of the hash entry in the hash table of the join buffer
+    is the hash value modulo the number of hash entries.
 
   RETURN VALUE
-    the calculated index of the hash entry for the given key  
+    the calculated hash value for the given key  
 */
 
 inline
-uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
+ulong JOIN_CACHE_HASHED::get_hash_value_simple(uchar* key, uint key_len)
 {
   ulong nr= 1;
   ulong nr2= 4;
@@ -3251,7 +3254,7 @@ uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
     nr^= (ulong) ((((uint) nr & 63)+nr2)*((uint) *pos))+ (nr << 8);
     nr2+= 3;
   }
-  return nr % hash_entries;
+  return nr;
 }
 
 
@@ -3259,14 +3262,14 @@ uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
   Hash function that takes into account collations of the components of the key  
 
   SYNOPSIS
-    get_hash_idx_complex()
+    get_hash_value_complex()
       key             pointer to the key value
       key_len         key value length
       
   DESCRIPTION
-    The function calculates an index of the hash entry in the hash table
-    of the join buffer for the given key. It takes into account that the
-    components of the key may be of a varchar type with different collations.
+    The function calculates the hash value of the given key. It takes into
+    account that the components of the key may be of a varchar type with
+    different collations.
     The function guarantees that the same hash value for any two equal
     keys that may differ as byte sequences.
     The function takes the info about the components of the key, their
@@ -3275,14 +3278,13 @@ uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
     operation.
 
   RETURN VALUE
-    the calculated index of the hash entry for the given key  
+    the calculated hash value for the given key  
 */
 
 inline
-uint JOIN_CACHE_HASHED::get_hash_idx_complex(uchar *key, uint key_len)
+ulong JOIN_CACHE_HASHED::get_hash_value_complex(uchar *key, uint key_len)
 {
-  return 
-    (uint) (key_hashnr(ref_key_info, ref_used_key_parts, key) % hash_entries);
+  return key_hashnr(ref_key_info, ref_used_key_parts, key);
 }
 
 
@@ -3434,6 +3436,35 @@ uint JOIN_CACHE_HASHED::get_next_key(uchar ** key)
 }
 
 
+/*
+  Add the keys of the hash table of a hashed join cache to a filter
+
+  SYNOPSIS
+    add_keys_to_filter()
+      filter    the filter to add the hash values of the keys to
+
+  DESCRIPTION
+    The function adds the hash value of every key entry in the hash table
+    of the join buffer to the filter. The hash values are calculated with
+    the hash function of the hash table, so a key built for a record of
+    join_tab that is equal to some key in the hash table is always found
+    in the filter.
+
+  RETURN VALUE
+    none
+*/
+
+void JOIN_CACHE_HASHED::add_keys_to_filter(Bloom_filter *filter)
+{
+  for (uchar *entry= hash_table; entry > last_key_entry; )
+  {
+    entry-= key_entry_length;
+    uchar *key= use_emb_key ? get_emb_key(entry) : entry;
+    filter->add((this->*hash_func)(key, key_length));
+  }
+}
+
+
 /* 
   Initiate an iteration process over records in the joined table
 
@@ -3497,14 +3528,22 @@ int JOIN_TAB_SCAN::next()
     join_tab->tracker->r_rows++;
   }
 
-  while (!err && select && (skip_rc= select->skip_record(thd)) <= 0)
+  while (!err)
   {
-    if (unlikely(thd->check_killed()) || skip_rc < 0)
-      return 1;
     /* 
-      Move to the next record if the last retrieved record does not
-      meet the condition pushed to the table join_tab.
+      Move to the next record if the last retrieved record cannot match
+      any record in the join buffer or does not meet the condition pushed
+      to the table join_tab.
     */
+    if (!cache->skip_by_key_filter())
+    {
+      if (!select || (skip_rc= select->skip_record(thd)) > 0)
+        break;
+      if (skip_rc < 0)
+        return 1;
+    }
+    if (unlikely(thd->check_killed()))
+      return 1;
     err= info->read_record();
     if (!err)
     {
@@ -3768,6 +3807,86 @@ uchar *JOIN_CACHE_BNLH::get_matching_chain_by_join_key()
 }
 
 
+/*
+  Build the Bloom filter over the keys in the BNLH join cache buffer
+
+  SYNOPSIS
+    build_key_filter()
+
+  DESCRIPTION
+    The function is called before join_tab is scanned for the records
+    matching the records in the join buffer. If the optimizer switch flag
+    join_cache_bloom_filter is set, the function builds a Bloom filter
+    over the keys in the hash table of the buffer. The records of join_tab
+    whose keys are not in the filter are then skipped by the scan before
+    the condition pushed to join_tab is evaluated for them and before the
+    hash table is probed with their keys.
+
+  RETURN VALUE
+    none
+*/
+
+void JOIN_CACHE_BNLH::build_key_filter()
+{
+  use_key_filter= FALSE;
+  if (!optimizer_flag(join->thd, OPTIMIZER_SWITCH_JOIN_CACHE_BLOOM_FILTER) ||
+      !key_entries ||
+      key_filter.init(key_memory_JOIN_CACHE, key_entries))
+    return;
+  add_keys_to_filter(&key_filter);
+  use_key_filter= TRUE;
+  key_filter_checks= key_filter_rejects= 0;
+}
+
+
+/*
+  Check a record of join_tab against the Bloom filter of the BNLH join cache
+
+  SYNOPSIS
+    skip_by_key_filter()
+
+  DESCRIPTION
+    The function builds the join key out of the record of join_tab in the
+    record buffer and checks whether the key is in the filter built by
+    build_key_filter(). The key is never rejected if the filter is not
+    used for the current scan.
+    When the filter has rejected less than 1/JOIN_CACHE_BLOOM_MIN_REJECT
+    of the records checked after JOIN_CACHE_BLOOM_MIN_CHECKS records of
+    the scan, most keys of join_tab are in the buffer and the filter is
+    not checked for the rest of the scan.
+
+  RETURN VALUE
+    TRUE    the record certainly has no match in the join buffer
+    FALSE   otherwise
+*/
+
+#define JOIN_CACHE_BLOOM_MIN_CHECKS 1024
+#define JOIN_CACHE_BLOOM_MIN_REJECT 8
+
+bool JOIN_CACHE_BNLH::skip_by_key_filter()
+{
+  if (!use_key_filter)
+    return FALSE;
+
+  THD *thd= join->thd;
+  key_copy(key_buff, join_tab->table->record[0], ref_key_info, key_length,
+           TRUE);
+  bool skip= !key_filter.may_contain((this->*hash_func)(key_buff, key_length));
+  key_filter_checks++;
+  status_var_increment(thd->status_var.join_cache_bloom_filter_checks);
+  if (skip)
+  {
+    key_filter_rejects++;
+    status_var_increment(thd->status_var.join_cache_bloom_filter_rejects);
+  }
+  else if (key_filter_checks >= JOIN_CACHE_BLOOM_MIN_CHECKS &&
+           key_filter_rejects <
+             key_filter_checks / JOIN_CACHE_BLOOM_MIN_REJECT)
+    use_key_filter= FALSE;
+  return skip;
+}
+
+
 /*
   Prepare to iterate over the BNLH join cache buffer to look for matches 
 
@@ -19,6 +19,8 @@
   of block based join algorithms
 */
 
+#include "bloom_filter.h"
+
 #define JOIN_CACHE_INCREMENTAL_BIT           1
 #define JOIN_CACHE_HASHED_BIT                2
 #define JOIN_CACHE_BKA_BIT                   4
@@ -669,6 +671,18 @@ class JOIN_CACHE :public Sql_alloc
   { 
     return (curr_rec_link ? curr_rec_link : get_curr_rec());
   }
+
+  /*
+    Shall build a filter over the join keys of the records in the join
+    buffer before join_tab is scanned for the records matching them
+  */
+  virtual void build_key_filter() {}
+
+  /*
+    Shall return TRUE if the record of join_tab in its record buffer
+    certainly has no match among the records in the join buffer
+  */
+  virtual bool skip_by_key_filter() { return FALSE; }
      
   /* Join records from the join buffer with records from the next join table */ 
   enum_nested_loop_state join_records(bool skip_last);
@@ -680,7 +694,7 @@ class JOIN_CACHE :public Sql_alloc
 
   virtual ~JOIN_CACHE() = default;
   void reset_join(JOIN *j) { join= j; }
-  void free()
+  virtual void free()
   { 
     my_free(buff);
     buff= 0;
@@ -775,7 +789,7 @@ class JOIN_CACHE :public Sql_alloc
 class JOIN_CACHE_HASHED: public JOIN_CACHE
 {
 
-  typedef uint (JOIN_CACHE_HASHED::*Hash_func) (uchar *key, uint key_len);
+  typedef ulong (JOIN_CACHE_HASHED::*Hash_func) (uchar *key, uint key_len);
   typedef bool (JOIN_CACHE_HASHED::*Hash_cmp_func) (uchar *key1, uchar *key2,
                                                     uint key_len);
   
@@ -803,8 +817,8 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
   /* The offset of the data fields from the beginning of the record fields */
   uint data_fields_offset;
 
-  inline uint get_hash_idx_simple(uchar *key, uint key_len);
-  inline uint get_hash_idx_complex(uchar *key, uint key_len);
+  inline ulong get_hash_value_simple(uchar *key, uint key_len);
+  inline ulong get_hash_value_complex(uchar *key, uint key_len);
 
   inline bool equal_keys_simple(uchar *key1, uchar *key2, uint key_len);
   inline bool equal_keys_complex(uchar *key1, uchar *key2, uint key_len);
@@ -861,6 +875,9 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
 
   uint get_size_of_key_offset() { return size_of_key_ofs; }
 
+  /* Add the hash values of all keys in the hash table to a filter */
+  void add_keys_to_filter(Bloom_filter *filter);
+
   /* 
     Get the position of the next_key_ptr field pointed to by 
     a linking reference stored at the position key_ref_ptr. 
@@ -1190,6 +1207,21 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
 
   void read_next_candidate_for_match(uchar *rec_ptr);
 
+  /*
+    A filter over the keys in the hash table, checked for the records of
+    join_tab before the hash table is probed with them
+  */
+  Bloom_filter key_filter;
+  /* Whether key_filter is checked in the current scan of join_tab */
+  bool use_key_filter;
+  /* Number of records checked and rejected by key_filter in the scan */
+  ha_rows key_filter_checks;
+  ha_rows key_filter_rejects;
+
+  void build_key_filter();
+
+  bool skip_by_key_filter();
+
 public:
 
   /* 
@@ -1197,7 +1229,8 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
     used to join table 'tab' to the result of joining the previous tables 
     specified by the 'j' parameter.
   */   
-  JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab) : JOIN_CACHE_HASHED(j, tab) {}
+  JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab)
+    : JOIN_CACHE_HASHED(j, tab), use_key_filter(FALSE) {}
 
   /* 
     This constructor creates a linked BNLH join cache. The cache is to be 
@@ -1206,7 +1239,7 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
     cache object to which this cache is linked.
   */   
   JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab, JOIN_CACHE *prev) 
-    : JOIN_CACHE_HASHED(j, tab, prev) {}
+    : JOIN_CACHE_HASHED(j, tab, prev), use_key_filter(FALSE) {}
 
   /* Initialize the BNLH cache */       
   int init(bool for_explain);
@@ -1215,6 +1248,12 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
 
   bool is_key_access() { return TRUE; }
 
+  void free()
+  {
+    key_filter.free();
+    JOIN_CACHE_HASHED::free();
+  }
+
 };
 
 
@@ -1408,6 +1447,9 @@ class JOIN_CACHE_BKAH :public JOIN_CACHE_BNLH
 
   bool prepare_look_for_matches(bool skip_last);
 
+  /* join_tab is only read by the keys in the hash table, there is no scan */
+  void build_key_filter() {}
+
   /*
     The implementations of the methods
     - get_next_candidate_for_match
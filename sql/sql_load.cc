@@ -35,6 +35,7 @@
                         // Execute_load_query_log_event,
                         // LOG_EVENT_UPDATE_TABLE_MAP_VERSION_F
 #include <m_ctype.h>
+#include <my_scan_bytes.h>
 #include "rpl_mi.h"
 #include "sql_repl.h"
 #include "sp_head.h"
@@ -146,6 +147,13 @@ class READ_INFO: public Load_data_param
   Term_string m_line_start;             /* LINES STARTING BY 'string' */
   int	enclosed_char,escape_char;
   int	*stack,*stack_pos;
+  /*
+    The bytes that read_field() must look at one by one; the bytes between
+    them are copied in runs. Set if no byte of the set can be a part of a
+    multi-byte character.
+  */
+  MY_BYTE_SET field_bytes;
+  bool copy_runs;
   bool	found_end_of_line,start_of_line,eof;
   int level; /* for load xml */
 
@@ -1413,6 +1421,17 @@ READ_INFO::READ_INFO(THD *thd, File file_par,
     m_line_term.reset();
   enclosed_char= enclosed_par.length() ? (uchar) enclosed_par[0] : INT_MAX;
 
+  const int field_specials[]= {escape_char, enclosed_char,
+                               m_field_term.initial_byte(),
+                               m_line_term.initial_byte()};
+  my_byte_set_init(&field_bytes, field_specials, array_elements(field_specials));
+  /* utf8 continuation bytes are never ASCII, unlike in e.g. sjis or gbk */
+  copy_runs= !charset()->use_mb() ||
+             ((charset()->state & MY_CS_UNICODE) && charset()->mbminlen == 1 &&
+              field_bytes.bytes[0] < 0x80 &&
+              field_bytes.bytes[1] < 0x80 && field_bytes.bytes[2] < 0x80 &&
+              field_bytes.bytes[3] < 0x80);
+
   /* Set of a stack for unget if long terminators */
   uint length= MY_MAX(charset()->mbmaxlen, MY_MAX(m_field_term.length(),
                                                   m_line_term.length())) + 1;
@@ -1564,6 +1583,23 @@ int READ_INFO::read_field()
     // Make sure we have enough space for the longest multi-byte character.
     while (data.length() + charset()->mbmaxlen <= data.alloced_length())
     {
+      if (copy_runs && stack_pos == stack)
+      {
+        /* Copy the bytes up to the next one that needs a closer look */
+        const uchar *from= cache.read_pos;
+        size_t room= data.alloced_length() - data.length() -
+                     charset()->mbmaxlen;
+        const uchar *to=
+          my_scan_bytes(&field_bytes, from,
+                        (size_t) (cache.read_end - from) > room ?
+                        from + room : cache.read_end);
+        if (to != from)
+        {
+          data.q_append((const char*) from, (size_t) (to - from));
+          cache.read_pos= (uchar*) to;
+          continue;
+        }
+      }
       chr = GET;
       if (chr == my_b_EOF)
 	goto found_eof;
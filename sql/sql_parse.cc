@@ -1192,6 +1192,29 @@ static enum enum_server_command fetch_command(THD *thd, char *packet)
                                   'blocking' is false.
 */
 
+/**
+  Check whether more data from the client is already waiting to be read,
+  in the buffer of the compressed protocol or in the socket.
+*/
+static bool net_input_pending(NET *net)
+{
+  return net->remain_in_buf || (net->vio && vio_pending(net->vio) > 0);
+}
+
+
+/**
+  Check whether the reply to a command may be kept in the NET buffer when
+  the client has already sent the next command. Clients that pipeline
+  statements send many executions without waiting for the replies; their
+  replies are then sent with one write.
+*/
+static bool command_can_defer_flush(enum enum_server_command command)
+{
+  return command == COM_STMT_EXECUTE || command == COM_STMT_BULK_EXECUTE ||
+         command == COM_STMT_FETCH || command == COM_STMT_RESET;
+}
+
+
 dispatch_command_return do_command(THD *thd, bool blocking)
 {
   dispatch_command_return return_value;
@@ -1403,6 +1426,8 @@ dispatch_command_return do_command(THD *thd, bool blocking)
   DBUG_ASSERT(packet_length);
   DBUG_ASSERT(!thd->apc_target.is_enabled());
 
+  thd->defer_net_flush= command_can_defer_flush(command);
+
 resume:
   return_value= dispatch_command(command, thd, packet+1,
                                  (uint) (packet_length-1), blocking);
@@ -1416,6 +1441,19 @@ dispatch_command_return do_command(THD *thd, bool blocking)
 
   DBUG_ASSERT(!thd->apc_target.is_enabled());
 
+  if (thd->defer_net_flush)
+  {
+    thd->defer_net_flush= false;
+    /*
+      Keep the reply only if the client has already sent the next command:
+      never while waiting for the client, so send it if the connection is
+      closing or no more input is waiting. A command that was only partly
+      received is completed by the client without waiting for a reply.
+    */
+    if (return_value != DISPATCH_COMMAND_SUCCESS || !net_input_pending(net))
+      (void) net_flush(net);
+  }
+
 out:
   thd->lex->restore_set_statement_var();
   /* The statement instrumentation must be closed in all cases. */
@@ -768,6 +768,11 @@ bool Sql_cmd_alter_table_exchange_partition::
   table_list->table= NULL;
   table_list->next_local->table= NULL;
   query_cache_invalidate3(thd, table_list, FALSE);
+  /* For the derived table cache: the tables keep their definitions */
+  table_version_bump(table_version_slot(table_list->db.str,
+                                        table_list->table_name.str));
+  table_version_bump(table_version_slot(table_list->next_local->db.str,
+                                        table_list->next_local->table_name.str));
 
   DBUG_RETURN(error);
 }
@@ -197,6 +197,14 @@ class Prepared_statement: public Statement
   bool (*set_params_from_actual_params)(Prepared_statement *stmt,
                                         List<Item> &list,
                                         String *expanded_query);
+  /*
+    The key in the Prepared_statement_cache, set if the statement may be
+    reused after COM_STMT_CLOSE, and the column info of the parameters
+    and of the result set that COM_STMT_PREPARE sent for it
+  */
+  LEX_CSTRING cache_key;
+  Saved_metadata *saved_params;
+  Saved_metadata *saved_columns;
 public:
   Prepared_statement(THD *thd_arg);
   virtual ~Prepared_statement();
@@ -220,6 +228,11 @@ class Prepared_statement: public Statement
   bool bulk_iterations() { return iterations; };
   /* Destroy this statement */
   void deallocate();
+  bool set_cache_key(const String *key);
+  bool is_reusable();
+  /* Move this statement to the Prepared_statement_cache */
+  void deallocate_for_reuse();
+  bool tables_unchanged();
   bool execute_immediate(const char *query, uint query_length);
 private:
   /**
@@ -340,13 +353,23 @@ static bool send_prep_stmt(Prepared_statement *stmt, uint columns)
   error= my_net_write(net, buff, sizeof(buff));
   if (stmt->param_count && likely(!error))
   {
-    /*
-      Force the column info to be written
-      (in this case PS parameter type info).
-    */
-    error= thd->protocol_text.send_result_set_metadata(
-                (List<Item> *)&stmt->lex->param_list,
-                Protocol::SEND_EOF | Protocol::SEND_FORCE_COLUMN_INFO);
+    if (stmt->saved_params)
+      error= thd->protocol_text.send_saved_metadata(stmt->saved_params,
+                                                    Protocol::SEND_EOF);
+    else
+    {
+      /*
+        Force the column info to be written
+        (in this case PS parameter type info).
+      */
+      error= thd->protocol_text.send_result_set_metadata(
+                  (List<Item> *)&stmt->lex->param_list,
+                  Protocol::SEND_EOF | Protocol::SEND_FORCE_COLUMN_INFO);
+      if (likely(!error) && stmt->cache_key.str &&
+          !(stmt->saved_params= Saved_metadata::save(thd, stmt->mem_root,
+                                   (List<Item> *) &stmt->lex->param_list)))
+        error= 1;
+    }
   }
 
   if (likely(!error))
@@ -1580,6 +1603,8 @@ static int mysql_test_select(Prepared_statement *stmt,
   THD *thd= stmt->thd;
   LEX *lex= stmt->lex;
   SELECT_LEX_UNIT *unit= &lex->unit;
+  /* Not SELECT ... INTO */
+  const bool plain_select= !lex->result;
   DBUG_ENTER("mysql_test_select");
 
   lex->first_select_lex()->context.resolve_in_select_list= TRUE;
@@ -1627,6 +1652,11 @@ static int mysql_test_select(Prepared_statement *stmt,
     if (unit->last_procedure && unit->last_procedure->change_columns(thd, fields))
       goto error;
 
+    if (stmt->cache_key.str && plain_select && !unit->last_procedure &&
+        !(stmt->saved_columns= Saved_metadata::save(thd, stmt->mem_root,
+                                                    &fields)))
+      goto error;
+
     /*
       We can use lex->result as it should've been prepared in
       unit->prepare call above.
@@ -2753,6 +2783,207 @@ static bool init_param_array(Prepared_statement *stmt)
 }
 
 
+static const uchar *ps_cache_get_key(const void *stmt, size_t *length,
+                                     my_bool)
+{
+  const Prepared_statement *s= static_cast<const Prepared_statement*>(stmt);
+  *length= s->cache_key.length;
+  return reinterpret_cast<const uchar*>(s->cache_key.str);
+}
+
+
+/**
+  Closed prepared statements of a session
+
+  With @@prepared_stmt_cache_size set, COM_STMT_CLOSE of a DML statement
+  moves the statement here instead of destroying it, and a later
+  COM_STMT_PREPARE of the same text, in the same database and with the
+  same settings that affect parsing, takes it back under a new id without
+  parsing and validating the text again. Applications behind connection
+  pools often prepare, execute and close the same statements for every
+  request.
+
+  A statement is taken back only if the definitions of its tables did not
+  change since it was prepared or last executed. Privileges are checked
+  by every execution, as for any prepared statement.
+
+  The statements here stay counted in prepared_stmt_count, so together
+  with the open ones they are limited by max_prepared_stmt_count.
+*/
+
+class Prepared_statement_cache
+{
+  /* by cache_key; the same key may be there more than once */
+  HASH hash;
+  /* least recently closed statements first */
+  I_List<Prepared_statement> lru;
+
+public:
+  Prepared_statement_cache()
+  {
+    my_hash_init(key_memory_prepared_statement_map, &hash, &my_charset_bin,
+                 16, 0, 0, (my_hash_get_key) ps_cache_get_key,
+                 NULL, MYF(0));
+  }
+
+  ~Prepared_statement_cache()
+  {
+    shrink(0);
+    my_hash_free(&hash);
+  }
+
+  /* Remove the least recently closed statements until at most limit stay */
+  void shrink(ulong limit)
+  {
+    while (hash.records > limit)
+    {
+      Prepared_statement *stmt= lru.get();
+      my_hash_delete(&hash, (uchar*) stmt);
+      Statement_map::release_detached(stmt);
+    }
+  }
+
+  /*
+    Release the least recently closed statements that keep
+    prepared_stmt_count at max_prepared_stmt_count, so that the session
+    can prepare a new statement.
+  */
+  void make_room()
+  {
+    mysql_mutex_lock(&LOCK_prepared_stmt_count);
+    uint over= prepared_stmt_count >= max_prepared_stmt_count ?
+               prepared_stmt_count - max_prepared_stmt_count + 1 : 0;
+    mysql_mutex_unlock(&LOCK_prepared_stmt_count);
+    shrink(hash.records > over ? hash.records - over : 0);
+  }
+
+  void insert(Prepared_statement *stmt, ulong limit)
+  {
+    shrink(limit - 1);
+    if (my_hash_insert(&hash, (uchar*) stmt))
+    {
+      Statement_map::release_detached(stmt);
+      return;
+    }
+    lru.push_back(stmt);
+  }
+
+  /* Remove and return a statement that can be reused */
+  Prepared_statement *take(const String &key)
+  {
+    Prepared_statement *stmt= (Prepared_statement*)
+      my_hash_search(&hash, (const uchar*) key.ptr(), key.length());
+    if (!stmt)
+      return NULL;
+    stmt->unlink();
+    my_hash_delete(&hash, (uchar*) stmt);
+    if (!stmt->tables_unchanged())
+    {
+      Statement_map::release_detached(stmt);
+      return NULL;
+    }
+    return stmt;
+  }
+};
+
+
+void free_prepared_statement_cache(THD *thd)
+{
+  delete thd->ps_cache;
+  thd->ps_cache= NULL;
+}
+
+
+void shrink_prepared_statement_cache(THD *thd)
+{
+  if (!thd->variables.prepared_stmt_cache_size)
+    free_prepared_statement_cache(thd);
+  else if (thd->ps_cache)
+    thd->ps_cache->shrink(thd->variables.prepared_stmt_cache_size);
+}
+
+
+#ifndef EMBEDDED_LIBRARY
+/**
+  Make the key of a statement in the Prepared_statement_cache: the settings
+  that affect parsing and name resolution, the current database and the
+  statement text.
+
+  @retval true  out of memory
+*/
+
+static bool make_ps_cache_key(THD *thd, const char *query, uint length,
+                              String *key)
+{
+  const uint32 numbers[]=
+  {
+    thd->variables.character_set_client->number,
+    thd->variables.collation_connection->number,
+    (uint32) thd->db.length
+  };
+  return key->append((const char *) &thd->variables.sql_mode,
+                     sizeof(sql_mode_t)) ||
+         key->append((const char *) &thd->variables.old_behavior,
+                     sizeof(sql_mode_t)) ||
+         key->append((const char *) numbers, sizeof numbers) ||
+         (thd->db.length && key->append(thd->db.str, thd->db.length)) ||
+         key->append(query, length);
+}
+
+
+/**
+  Answer COM_STMT_PREPARE with a statement from the Prepared_statement_cache.
+
+  @return false if no statement could be reused, true if the statement
+          was reused and the reply was sent, or an error was set in THD
+*/
+
+static bool reuse_prepared_statement(THD *thd, const String &key)
+{
+  Prepared_statement *stmt;
+
+  if (!thd->ps_cache || !(stmt= thd->ps_cache->take(key)))
+  {
+    thd->status_var.prepared_stmt_cache_misses++;
+    return false;
+  }
+  thd->status_var.prepared_stmt_cache_hits++;
+  status_var_increment(thd->status_var.com_stmt_prepare);
+
+  stmt->id= (++thd->statement_id_counter) & STMT_ID_MASK;
+  if (thd->stmt_map.attach(stmt))
+    return true;                          /* the statement was deleted */
+
+  stmt->m_prepared_stmt= MYSQL_CREATE_PS(stmt, stmt->id,
+                                         thd->m_statement_psi,
+                                         stmt->name.str, stmt->name.length);
+  MYSQL_SET_PS_TEXT(stmt->m_prepared_stmt, stmt->query(),
+                    stmt->query_length());
+  thd->set_query(stmt->query_string);
+  /* The client has no column info of the new id */
+  stmt->column_info_state.reset();
+  general_log_write(thd, COM_STMT_PREPARE, stmt->query(),
+                    stmt->query_length());
+
+  Protocol *save_protocol= thd->protocol;
+  thd->protocol= &thd->protocol_binary;
+  Saved_metadata *columns= stmt->saved_columns;
+  if (send_prep_stmt(stmt, columns ? columns->elements() : 0) ||
+      (columns &&
+       thd->protocol->send_saved_metadata(columns, Protocol::SEND_EOF)) ||
+      thd->protocol->flush())
+  {
+    thd->stmt_map.erase(stmt);
+    thd->clear_last_stmt();
+  }
+  else
+    thd->set_last_stmt(stmt);
+  thd->protocol= save_protocol;
+  return true;
+}
+#endif /* EMBEDDED_LIBRARY */
+
+
 /**
   COM_STMT_PREPARE handler.
 
@@ -2783,15 +3014,34 @@ void mysqld_stmt_prepare(THD *thd, const char *packet, uint packet_length)
 {
   Protocol *save_protocol= thd->protocol;
   Prepared_statement *stmt;
+  StringBuffer<256> cache_key;
   DBUG_ENTER("mysqld_stmt_prepare");
   DBUG_PRINT("prep_query", ("%s", packet));
 
   /* First of all clear possible warnings from the previous command */
   thd->reset_for_next_command();
 
+#ifndef EMBEDDED_LIBRARY
+  if (thd->variables.prepared_stmt_cache_size)
+  {
+    if (make_ps_cache_key(thd, packet, packet_length, &cache_key))
+      goto end;
+    if (reuse_prepared_statement(thd, cache_key))
+      goto end;
+  }
+#endif
+  if (thd->ps_cache)
+    thd->ps_cache->make_room();
+
   if (! (stmt= new Prepared_statement(thd)))
     goto end;           /* out of memory: error is set in Sql_alloc */
 
+  if (cache_key.length() && stmt->set_cache_key(&cache_key))
+  {
+    delete stmt;
+    goto end;
+  }
+
   if (thd->stmt_map.insert(thd, stmt))
   {
     /*
@@ -3833,7 +4083,10 @@ void mysqld_stmt_close(THD *thd, char *packet)
     in use is from within Dynamic SQL.
   */
   DBUG_ASSERT(! stmt->is_in_use());
-  stmt->deallocate();
+  if (stmt->is_reusable())
+    stmt->deallocate_for_reuse();
+  else
+    stmt->deallocate();
   general_log_print(thd, thd->get_command(), NullS);
 
   if (thd->last_stmt == stmt)
@@ -4125,6 +4378,9 @@ Prepared_statement::Prepared_statement(THD *thd_arg)
   iterations(0),
   start_param(0),
   read_types(0),
+  cache_key(null_clex_str),
+  saved_params(0),
+  saved_columns(0),
   m_sql_mode(thd->variables.sql_mode)
 {
   init_sql_alloc(key_memory_prepared_statement_main_mem_root,
@@ -5059,6 +5315,10 @@ Prepared_statement::swap_prepared_statement(Prepared_statement *copy)
   swap_variables(LEX_CSTRING, name, copy->name);
   /* Ditto */
   swap_variables(LEX_CSTRING, db, copy->db);
+  /* Ditto; the copy has none, so this statement will not be reused */
+  swap_variables(LEX_CSTRING, cache_key, copy->cache_key);
+  swap_variables(Saved_metadata *, saved_params, copy->saved_params);
+  swap_variables(Saved_metadata *, saved_columns, copy->saved_columns);
 
   DBUG_ASSERT(param_count == copy->param_count);
   DBUG_ASSERT(thd == copy->thd);
@@ -5104,6 +5364,8 @@ bool Prepared_statement::execute(String *expanded_query, bool open_cursor)
   LEX_CSTRING stmt_db_name= db;
 
   status_var_increment(thd->status_var.com_stmt_execute);
+  /* Results read after this point may be stored in the derived cache */
+  thd->derived_cache_start_seq= table_change_seq;
 
   if (flags & (uint) IS_IN_USE)
   {
@@ -5400,6 +5662,119 @@ void Prepared_statement::deallocate()
 }
 
 
+bool Prepared_statement::set_cache_key(const String *key)
+{
+  if (!(cache_key.str= strmake_root(mem_root, key->ptr(), key->length())))
+    return true;
+  cache_key.length= key->length();
+  return false;
+}
+
+
+/**
+  Check if COM_STMT_CLOSE may keep this statement in the
+  Prepared_statement_cache.
+*/
+
+bool Prepared_statement::is_reusable()
+{
+  if (!cache_key.str || !thd->variables.prepared_stmt_cache_size ||
+      (state != Query_arena::STMT_PREPARED &&
+       state != Query_arena::STMT_EXECUTED) ||
+      (param_count && !saved_params) ||
+      lex->describe || lex->analyze_stmt || lex->sroutines.records)
+    return false;
+
+  switch (lex->sql_command) {
+  case SQLCOM_SELECT:
+    return saved_columns != NULL;
+  case SQLCOM_INSERT:
+  case SQLCOM_INSERT_SELECT:
+  case SQLCOM_REPLACE:
+  case SQLCOM_REPLACE_SELECT:
+  case SQLCOM_DELETE:
+  case SQLCOM_DELETE_MULTI:
+    return !lex->has_returning();
+  case SQLCOM_UPDATE:
+  case SQLCOM_UPDATE_MULTI:
+    return true;
+  default:
+    return false;
+  }
+}
+
+
+void Prepared_statement::deallocate_for_reuse()
+{
+  /* We account deallocate in the same manner as mysqld_stmt_close */
+  status_var_increment(thd->status_var.com_stmt_close);
+  close_cursor();
+  MYSQL_DESTROY_PS(m_prepared_stmt);
+  m_prepared_stmt= NULL;
+  thd->stmt_map.detach(this);
+
+  if (!thd->ps_cache && !(thd->ps_cache= new Prepared_statement_cache))
+  {
+    Statement_map::release_detached(this);
+    return;
+  }
+  thd->ps_cache->insert(this, thd->variables.prepared_stmt_cache_size);
+}
+
+
+/**
+  Check that the tables and views of the statement have the definitions
+  that the statement was prepared or last executed with.
+*/
+
+bool Prepared_statement::tables_unchanged()
+{
+  for (TABLE_LIST *tl= lex->query_tables; tl; tl= tl->next_global)
+  {
+    if (!tl->view && (tl->derived || tl->schema_table ||
+                      tl->table_function || tl->with))
+      continue;
+    if (!tl->tabledef_version.length)
+      return false;
+
+    const TABLE_SHARE *tmp_share= thd->find_tmp_table_share(tl);
+    TABLE_SHARE *share= NULL;
+    MDL_request mdl_request;
+    bool same;
+
+    if (!tmp_share)
+    {
+      /* Do not wait for a concurrent DDL, give up instead */
+      MDL_REQUEST_INIT_BY_KEY(&mdl_request, &tl->mdl_request.key,
+                              MDL_SHARED_HIGH_PRIO, MDL_EXPLICIT);
+      if (thd->mdl_context.try_acquire_lock(&mdl_request) ||
+          !mdl_request.ticket)
+      {
+        thd->clear_error();
+        return false;
+      }
+      share= tdc_acquire_share(thd, tl, GTS_TABLE | GTS_VIEW);
+      thd->mdl_context.release_lock(mdl_request.ticket);
+      if (!share)
+      {
+        thd->clear_error();
+        return false;
+      }
+    }
+
+    const LEX_CUSTRING &version= tmp_share ? tmp_share->tabledef_version
+                                           : share->tabledef_version;
+    same= version.length == tl->tabledef_version.length &&
+          !memcmp(version.str, tl->tabledef_version.str, version.length);
+    if (share)
+      tdc_release_share(share);
+    if (!same)
+      return false;
+  }
+  return true;
+}
+
+
 /***************************************************************************
 * Ed_result_set
 ***************************************************************************/
@@ -83,6 +83,9 @@ void mysqld_stmt_fetch(THD *thd, char *packet, uint packet_length);
 void mysqld_stmt_reset(THD *thd, char *packet);
 void mysql_stmt_get_longdata(THD *thd, char *pos, ulong packet_length);
 void reinit_stmt_before_use(THD *thd, LEX *lex);
+void free_prepared_statement_cache(THD *thd);
+/* Reduce the cache of the session to @@prepared_stmt_cache_size */
+void shrink_prepared_statement_cache(THD *thd);
 
 my_bool bulk_parameters_iterations(THD *thd);
 my_bool bulk_parameters_set(THD *thd);
@@ -2672,7 +2672,7 @@ static my_off_t get_binlog_end_pos(binlog_send_info *info,
  *        else NOK
  */
 static int send_events(binlog_send_info *info, IO_CACHE* log, LOG_INFO* linfo,
-                       my_off_t end_pos)
+                       my_off_t start_pos, my_off_t end_pos)
 {
   int error;
   ulong ev_offset;
@@ -2681,11 +2681,26 @@ static int send_events(binlog_send_info *info, IO_CACHE* log, LOG_INFO* linfo,
   linfo->pos= my_b_tell(log);
   info->last_pos= my_b_tell(log);
 
+  /*
+    The events before verified_pos passed the checksum check in another
+    dump thread; the events after it are checked here, and the position
+    up to which they were checked is shared with the other dump threads.
+    This dump thread has read the file from start_pos, so every event
+    from start_pos up to linfo->pos has been checked by some dump thread.
+  */
+  const bool verify_checksum= opt_master_verify_checksum &&
+    info->current_checksum_alg != BINLOG_CHECKSUM_ALG_OFF &&
+    info->current_checksum_alg != BINLOG_CHECKSUM_ALG_UNDEF;
+  my_off_t verified_pos= verify_checksum
+    ? mysql_bin_log.get_binlog_verified_pos(linfo->log_file_name) : 0;
+  /* The emulated corruption must be detected wherever it is injected */
+  DBUG_EXECUTE_IF("corrupt_read_log_event2", verified_pos= 0;);
+
   log->end_of_file= end_pos;
   while (linfo->pos < end_pos)
   {
     if (should_stop(info))
-      return 0;
+      break;
 
     /* reset the transmit packet for the event read from binary log
        file */
@@ -2693,9 +2708,28 @@ static int send_events(binlog_send_info *info, IO_CACHE* log, LOG_INFO* linfo,
       return 1;
 
     info->last_pos= linfo->pos;
+    /* Corrupt the first event whose checksum is verified here */
+    DBUG_EXECUTE_IF("corrupt_read_log_event2_verified",
+                    if (verify_checksum && linfo->pos >= verified_pos)
+                    {
+                      DBUG_SET("-d,corrupt_read_log_event2_verified");
+                      DBUG_SET("+d,corrupt_read_log_event2");
+                    });
+#ifdef ENABLED_DEBUG_SYNC
+    DBUG_EXECUTE_IF("dump_thread_signal_checksum_skipped",
+                    if (verify_checksum && linfo->pos < verified_pos)
+                    {
+                      const char act[]= "now signal checksum_skipped";
+                      DBUG_SET("-d,dump_thread_signal_checksum_skipped");
+                      DBUG_ASSERT(debug_sync_service);
+                      DBUG_ASSERT(!debug_sync_set_action(info->thd,
+                                                         STRING_WITH_LEN(act)));
+                    });
+#endif
     error= Log_event::read_log_event(log, packet, info->fdev,
-                       opt_master_verify_checksum ? info->current_checksum_alg
-                                                  : BINLOG_CHECKSUM_ALG_OFF);
+                       verify_checksum && linfo->pos >= verified_pos
+                       ? info->current_checksum_alg
+                       : BINLOG_CHECKSUM_ALG_OFF);
     linfo->pos= my_b_tell(log);
 
     if (unlikely(error))
@@ -2773,7 +2807,7 @@ static int send_events(binlog_send_info *info, IO_CACHE* log, LOG_INFO* linfo,
         return 1;
       }
       info->should_stop= true;
-      return 0;
+      break;
     }
 
     /* Abort server before it sends the XID_EVENT */
@@ -2787,6 +2821,9 @@ static int send_events(binlog_send_info *info, IO_CACHE* log, LOG_INFO* linfo,
                     });
   }
 
+  if (verify_checksum && linfo->pos > verified_pos)
+    mysql_bin_log.update_binlog_verified_pos(linfo->log_file_name,
+                                             start_pos, linfo->pos);
   return 0;
 }
 
@@ -2826,7 +2863,7 @@ static int send_one_binlog_file(binlog_send_info *info,
     /**
      * send events from current position up to end_pos
      */
-    if (send_events(info, log, linfo, end_pos))
+    if (send_events(info, log, linfo, start_pos, end_pos))
       return 1;
     DBUG_EXECUTE_IF("Notify_binlog_EOF",
                     {
@@ -2865,6 +2902,22 @@ void mysql_binlog_send(THD* thd, char* log_ident, my_off_t pos,
 
   has_transmit_started= true;
 
+  /*
+    The events are collected in the network buffer and written when it is
+    full or when the end of the binlog is reached. Make the buffer as large
+    as a read of the binlog file cache, so that the events of one read are
+    written to the socket together.
+  */
+  if (binlog_file_cache_size > info->net->max_packet &&
+      binlog_file_cache_size < info->net->max_packet_size &&
+      info->net->write_pos == info->net->buff &&
+      net_realloc(info->net, (size_t) binlog_file_cache_size))
+  {
+    info->errmsg= "Failed to allocate the network buffer";
+    info->error= ER_OUTOFMEMORY;
+    goto err;
+  }
+
   /* Check if the dump thread is created by a slave with semisync enabled. */
   thd->semi_sync_slave = is_semi_sync_slave();
 
@@ -135,6 +135,7 @@ static ha_rows get_quick_record_count(THD *thd, SQL_SELECT *select,
 				      TABLE *table,
 				      const key_map *keys,ha_rows limit);
 static void optimize_straight_join(JOIN *join, table_map join_tables);
+static bool optimize_join_order_dp(JOIN *join, table_map join_tables);
 static bool greedy_search(JOIN *join, table_map remaining_tables,
                           uint depth, uint use_cond_selectivity);
 
@@ -9598,7 +9599,10 @@ choose_plan(JOIN *join, table_map join_tables, TABLE_LIST *emb_sjm_nest)
       join->extra_heuristic_pruning= true;
     }
 
-    if (greedy_search(join, join_tables, search_depth, use_cond_selectivity))
+    if ((emb_sjm_nest ||
+         !optimizer_flag(thd, OPTIMIZER_SWITCH_JOIN_ORDER_DP) ||
+         optimize_join_order_dp(join, join_tables)) &&
+        greedy_search(join, join_tables, search_depth, use_cond_selectivity))
       DBUG_RETURN(TRUE);
   }
 
@@ -9961,6 +9965,412 @@ optimize_straight_join(JOIN *join, table_map remaining_tables)
 }
 
 
+/*
+  A plan of optimize_join_order_dp(): the cheapest left-deep join order
+  found for a set of tables
+*/
+struct Join_dp_plan
+{
+  table_map tables;
+  /* The plan for 'tables' without the last table, or NULL */
+  const Join_dp_plan *prefix;
+  /* Row combinations produced by the plan, and its cost */
+  double record_count;
+  double read_time;
+  /* Whether the first table of the plan is join->sort_by_table */
+  bool sort_first;
+  /* Access path of the last table */
+  POSITION position;
+};
+
+
+/* Maximum number of plans memoized by optimize_join_order_dp() */
+static constexpr uint JOIN_DP_MAX_PLANS= 16384;
+
+
+/* State of the dynamic programming search of optimize_join_order_dp() */
+class Join_dp_search
+{
+  JOIN *const join;
+  const table_map join_tables;
+  const bool disable_jbuf;
+  const uint use_cond_selectivity;
+  Join_dp_plan *plans;
+  uint n_plans, max_plans;
+  /* Open addressing hash of 'plans' by the set of tables */
+  Join_dp_plan **slots;
+  uint slot_mask;
+
+  Join_dp_plan **find(table_map tables, bool sort_first)
+  {
+    ulonglong hash= (tables * 2 + sort_first) * 0x9E3779B97F4A7C15ULL;
+    for (uint i= (uint) (hash >> 32) & slot_mask;; i= (i + 1) & slot_mask)
+      if (!slots[i] ||
+          (slots[i]->tables == tables && slots[i]->sort_first == sort_first))
+        return &slots[i];
+  }
+
+public:
+  Join_dp_search(JOIN *join_arg, table_map join_tables_arg)
+    : join(join_arg), join_tables(join_tables_arg),
+      disable_jbuf(join_arg->thd->variables.join_cache_level == 0),
+      use_cond_selectivity(join_arg->thd->variables.
+                           optimizer_use_condition_selectivity),
+      plans(NULL), n_plans(0), max_plans(0), slots(NULL), slot_mask(0)
+  {}
+
+  /* Allocate room for at most max_plans_arg plans */
+  bool init(uint max_plans_arg)
+  {
+    max_plans= max_plans_arg;
+    uint n_slots= my_round_up_to_next_power(max_plans) * 2;
+    slot_mask= n_slots - 1;
+    plans= (Join_dp_plan*) join->thd->alloc(sizeof(Join_dp_plan) * max_plans);
+    slots= (Join_dp_plan**) join->thd->calloc(sizeof(Join_dp_plan*) * n_slots);
+    return !plans || !slots;
+  }
+
+  /* The plans are numbered in the order they were first memoized */
+  uint plan_count() const { return n_plans; }
+  const Join_dp_plan *plan(uint i) const { return plans + i; }
+
+  /* Copy the positions of a plan to join->positions */
+  void load(const Join_dp_plan *plan)
+  {
+    uint idx= join->const_tables + my_count_bits(plan->tables);
+    for (; plan; plan= plan->prefix)
+      join->positions[--idx]= plan->position;
+  }
+
+  /**
+    Extend a plan with a table and memoize the result, if it is the
+    cheapest plan for its set of tables so far
+
+    @param prefix  the plan to extend, loaded into join->positions,
+                   or NULL to start a plan with the table
+    @param s       the table to add
+
+    @retval false  ok
+    @retval true   the plans allocated by init() were all used
+  */
+  bool extend(const Join_dp_plan *prefix, JOIN_TAB *s)
+  {
+    table_map prefix_tables= prefix ? prefix->tables : 0;
+    table_map remaining_tables= join_tables & ~prefix_tables;
+    double prefix_record_count= prefix ? prefix->record_count : 1.0;
+    double read_time= prefix ? prefix->read_time : 0.0;
+    uint idx= join->const_tables + my_count_bits(prefix_tables);
+    POSITION *position= join->positions + idx;
+    POSITION loose_scan_pos;
+    double record_count;
+
+    status_var_increment(join->thd->status_var.
+                         optimizer_join_prefixes_check_calls);
+    best_access_path(join, s, remaining_tables, join->positions, idx,
+                     disable_jbuf, prefix_record_count,
+                     position, &loose_scan_pos);
+    record_count= COST_MULT(prefix_record_count, position->records_out);
+    read_time= COST_ADD(read_time, position->read_time);
+    optimize_semi_joins(join, remaining_tables, idx, &record_count,
+                        &read_time, &loose_scan_pos);
+    DBUG_ASSERT(position->sj_strategy == SJ_OPT_NONE);
+    if (use_cond_selectivity > 1)
+    {
+      position->cond_selectivity=
+        table_after_join_selectivity(join, idx, s,
+                                     remaining_tables & ~s->table->map,
+                                     &position->records_out);
+      record_count= COST_MULT(prefix_record_count, position->records_out);
+    }
+    else
+      position->cond_selectivity= 1.0;
+
+    bool sort_first= prefix ? prefix->sort_first :
+                              s->table == join->sort_by_table;
+    Join_dp_plan **slot= find(prefix_tables | s->table->map, sort_first);
+    Join_dp_plan *plan= *slot;
+    if (plan)
+    {
+      if (plan->read_time <= read_time)
+        return false;
+    }
+    else
+    {
+      if (n_plans == max_plans)
+        return true;
+      *slot= plan= new (plans + n_plans++) Join_dp_plan;
+      plan->tables= prefix_tables | s->table->map;
+      plan->sort_first= sort_first;
+    }
+    plan->prefix= prefix;
+    plan->record_count= record_count;
+    plan->read_time= read_time;
+    plan->position= *position;
+    return false;
+  }
+};
+
+
+/**
+  Count the connected sets of tables that contain 'set' and extend it only
+  with tables not in 'excluded', as EnumerateCsgRec() of DPccp does. Each
+  such set except 'set' itself is counted once.
+
+  @return count plus the number of sets, or a number above limit if the
+          counting was stopped there
+*/
+
+static uint join_dp_count_connected(const table_map *neighbours,
+                                    table_map join_tables, table_map set,
+                                    table_map excluded, uint count,
+                                    uint limit)
+{
+  table_map next= 0;
+  Table_map_iterator it(set);
+  uint tablenr;
+  while ((tablenr= it++) != Table_map_iterator::BITMAP_END)
+    next|= neighbours[tablenr];
+  if (!(next&= join_tables & ~excluded))
+    return count;
+
+  /* The non-empty subsets of 'next' */
+  table_map sub;
+  for (sub= (0 - next) & next; sub; sub= (sub - next) & next)
+    if (++count > limit)
+      return count;
+  for (sub= (0 - next) & next; sub; sub= (sub - next) & next)
+    if ((count= join_dp_count_connected(neighbours, join_tables, set | sub,
+                                        excluded | next, count,
+                                        limit)) > limit)
+      return count;
+  return count;
+}
+
+
+/**
+  Estimate the number of plans optimize_join_order_dp() will memoize
+
+  @detail
+    The sets of tables that get a plan are the connected sets of the join
+    graph, and, when the graph is not connected, their unions with whole
+    other components. The connected sets are counted like DPccp enumerates
+    them, starting from each table and extending only with tables of a
+    higher number, which costs no more than a few bit operations per set.
+    The counting stops above limit, so a star of many dimensions, which
+    has about 2^dimensions connected sets, is rejected before any plan is
+    costed.
+
+  @return an upper bound of the number of plans, or a number above limit
+*/
+
+static uint join_dp_estimate_plans(JOIN *join, const table_map *neighbours,
+                                   table_map join_tables, uint limit)
+{
+  uint count= 0, components= 0;
+  table_map seen= 0;
+  Table_map_iterator it(join_tables);
+  uint tablenr;
+  while ((tablenr= it++) != Table_map_iterator::BITMAP_END)
+  {
+    table_map map= table_map(1) << tablenr;
+    if (++count > limit ||
+        (count= join_dp_count_connected(neighbours, join_tables, map,
+                                        (map << 1) - 1, count,
+                                        limit)) > limit)
+      return limit + 1;
+    if (!(seen & map))
+    {
+      /* Mark the component of the table */
+      table_map component= map, added= map;
+      while (added)
+      {
+        table_map reached= 0;
+        Table_map_iterator add_it(added);
+        uint added_nr;
+        while ((added_nr= add_it++) != Table_map_iterator::BITMAP_END)
+          reached|= neighbours[added_nr];
+        added= reached & join_tables & ~component;
+        component|= added;
+      }
+      seen|= component;
+      components++;
+    }
+  }
+
+  /* Plans with whole other components in front, and by sort_first */
+  ulonglong estimate= count;
+  if (components > 1)
+  {
+    if (components > 15)
+      return limit + 1;
+    estimate= (estimate + 2) << (components - 1);
+  }
+  if (join->sort_by_table)
+    estimate*= 2;
+  return estimate > limit ? limit + 1 : (uint) estimate;
+}
+
+
+/**
+  Find the cheapest left-deep join order by dynamic programming
+
+  @detail
+    The plans are built bottom-up by the number of tables: a plan for a
+    set of tables extends a plan for a subset with one table, and only the
+    cheapest plan of each set is kept. Each extension is costed like in
+    optimize_straight_join(), with the positions of the extended plan in
+    join->positions.
+
+    Like in DPccp, a plan is only extended with the tables that are
+    connected to it by an equality (see JOIN_TAB::key_dependent), so cross
+    products are only considered when the join graph is not connected.
+    When ORDER BY or GROUP BY can be resolved by reading the first table in
+    order, the plans that start with that table are kept separately, as
+    they may avoid the sorting.
+
+    The search is exhaustive over the connected left-deep orders and does
+    not depend on optimizer_search_depth or optimizer_prune_level. It is
+    only done for joins of inner joined tables without semi-joins or other
+    dependencies between the tables, and only when
+    join_dp_estimate_plans() finds that at most JOIN_DP_MAX_PLANS plans
+    will have to be kept.
+
+  @param join         pointer to the structure providing all context info
+                      for the query
+  @param join_tables  set of the tables in the query
+
+  @retval false  The plan was stored in join->best_positions
+  @retval true   The search was not done; greedy_search() should be used
+*/
+
+static bool optimize_join_order_dp(JOIN *join, table_map join_tables)
+{
+  THD *thd= join->thd;
+  const uint first= join->const_tables;
+  const uint n_tables= join->table_count - first;
+  JOIN_TAB *tabs[MAX_TABLES];
+  table_map neighbours[MAX_TABLES];
+  Join_dp_search search(join, join_tables);
+  DBUG_ENTER("optimize_join_order_dp");
+
+  if (!n_tables || join->outer_join ||
+      join->select_lex->have_merged_subqueries)
+    DBUG_RETURN(true);
+
+  bzero(neighbours, sizeof(neighbours));
+  for (JOIN_TAB **pos= join->best_ref + first; *pos; pos++)
+  {
+    JOIN_TAB *s= *pos;
+    if (s->dependent)
+      DBUG_RETURN(true);
+    tabs[s->table->tablenr]= s;
+  }
+  for (JOIN_TAB **pos= join->best_ref + first; *pos; pos++)
+  {
+    JOIN_TAB *s= *pos;
+    table_map deps= s->key_dependent & join_tables & ~s->table->map;
+    neighbours[s->table->tablenr]|= deps;
+    Table_map_iterator it(deps);
+    uint tablenr;
+    while ((tablenr= it++) != Table_map_iterator::BITMAP_END)
+      neighbours[tablenr]|= s->table->map;
+  }
+
+  uint max_plans= join_dp_estimate_plans(join, neighbours, join_tables,
+                                         JOIN_DP_MAX_PLANS);
+  if (max_plans > JOIN_DP_MAX_PLANS)
+  {
+    if (unlikely(thd->trace_started()))
+    {
+      Json_writer_object trace_dp(thd);
+      trace_dp.
+        add("join_order_dp_plans", "too_many").
+        add("chosen", false);
+    }
+    DBUG_RETURN(true);
+  }
+  if (search.init(max_plans))
+    DBUG_RETURN(true);
+
+  bool gave_up= false;
+
+  for (JOIN_TAB **pos= join->best_ref + first; *pos && !gave_up; pos++)
+    gave_up= search.extend(NULL, *pos);
+
+  /* The plans with level - 1 tables are plan(level_start..level_end - 1) */
+  uint level_start= 0;
+  for (uint level= 2; level <= n_tables && !gave_up; level++)
+  {
+    uint level_end= search.plan_count();
+    for (uint i= level_start; i < level_end && !gave_up; i++)
+    {
+      const Join_dp_plan *prefix= search.plan(i);
+      table_map connected= 0;
+      Table_map_iterator it(prefix->tables);
+      uint tablenr;
+      while ((tablenr= it++) != Table_map_iterator::BITMAP_END)
+        connected|= neighbours[tablenr];
+      if (!(connected&= join_tables & ~prefix->tables))
+        connected= join_tables & ~prefix->tables;
+
+      if (unlikely(thd->check_killed()))
+      {
+        gave_up= true;
+        break;
+      }
+      search.load(prefix);
+      Table_map_iterator next(connected);
+      while (!gave_up &&
+             (tablenr= next++) != Table_map_iterator::BITMAP_END)
+        gave_up= search.extend(prefix, tabs[tablenr]);
+    }
+    level_start= level_end;
+  }
+
+  if (unlikely(thd->trace_started()))
+  {
+    Json_writer_object trace_dp(thd);
+    trace_dp.
+      add("join_order_dp_plans", search.plan_count()).
+      add("chosen", !gave_up);
+  }
+  if (gave_up)
+    DBUG_RETURN(true);
+
+  /* Pick the cheapest of the complete plans, with the cost of sorting */
+  const Join_dp_plan *best= NULL;
+  double best_read= DBL_MAX;
+  for (uint i= level_start; i < search.plan_count(); i++)
+  {
+    const Join_dp_plan *plan= search.plan(i);
+    double read_time= plan->read_time;
+    if (join->sort_by_table && !plan->sort_first)
+    {
+      /* See the comment in optimize_straight_join() */
+      double sort_cost;
+      sort_cost= (get_qsort_sort_cost((ha_rows) plan->record_count, 0) +
+                  plan->record_count * DISK_TEMPTABLE_LOOKUP_COST(thd));
+      read_time= COST_ADD(read_time, sort_cost);
+    }
+    if (read_time < best_read)
+    {
+      best= plan;
+      best_read= read_time;
+    }
+  }
+  DBUG_ASSERT(best && best->tables == join_tables);
+
+  search.load(best);
+  memcpy((uchar*) join->best_positions, (uchar*) join->positions,
+         sizeof(POSITION) * join->table_count);
+  join->join_record_count= best->record_count;
+  join->best_read= best_read;
+  DBUG_EXECUTE("opt", print_plan(join, join->table_count, best->record_count,
+                                 best_read, best_read, "optimal"););
+  DBUG_RETURN(false);
+}
+
+
 /**
   Find a good, possibly optimal, query execution plan (QEP) by a greedy search.
 
@@ -15016,6 +15426,33 @@ void JOIN_TAB::remove_redundant_bnl_scan_conds()
 }
 
 
+/*
+  Check whether the full table scan of tab may be done by several threads
+
+  DESCRIPTION
+    A parallel scan returns the rows in no particular order. This is only
+    allowed for the single table of a top-level SELECT that groups or
+    aggregates the rows anyway, reads the table without locking and has
+    no window functions. The rows are still filtered and aggregated by
+    the thread executing the query.
+*/
+
+static bool can_scan_in_parallel(JOIN *join, JOIN_TAB *tab)
+{
+  THD *thd= join->thd;
+  return thd->variables.parallel_scan_threads &&
+         thd->lex->sql_command == SQLCOM_SELECT &&
+         !thd->lex->describe &&
+         join->select_lex == thd->lex->first_select_lex() &&
+         !thd->lex->unit.is_unit_op() &&
+         join->table_count == 1 && !join->const_tables &&
+         (join->group || join->tmp_table_param.sum_func_count) &&
+         !join->select_lex->have_window_funcs() &&
+         tab->type == JT_ALL && !(tab->select && tab->select->quick) &&
+         tab->table->reginfo.lock_type == TL_READ;
+}
+
+
 /*
   Plan refinement stage: do various setup things for the executor
 
@@ -15262,6 +15699,9 @@ make_join_readinfo(JOIN *join, ulonglong options, uint no_jbuf_after)
             tab->select->quick->index != MAX_KEY &&
             !tab->table->covering_keys.is_set(tab->select->quick->index))
           push_index_cond(tab, tab->select->quick->index);
+        if (can_scan_in_parallel(join, tab))
+          table->file->parallel_scan_threads=
+            join->thd->variables.parallel_scan_threads;
       }
       break;
     }
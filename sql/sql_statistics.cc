@@ -31,6 +31,7 @@
 #include "opt_histogram_json.h"
 #include "opt_range.h"
 #include "uniques.h"
+#include "hyperloglog.h"
 #include "sql_show.h"
 #include "sql_partition.h"
 
@@ -1741,7 +1742,7 @@ class Count_distinct_field: public Sql_alloc
     @brief
     Check whether the Unique object tree has been successfully created
   */
-  bool exists()
+  virtual bool exists()
   {
     return (tree != NULL);
   }
@@ -1760,7 +1761,7 @@ class Count_distinct_field: public Sql_alloc
     @brief
     Calculate the number of elements accumulated in the container of 'tree'
   */
-  void walk_tree()
+  virtual void walk_tree()
   {
     Basic_stats_collector stats_collector;
     tree->walk(table_field->table, basic_stats_collector_walk,
@@ -1793,6 +1794,12 @@ class Count_distinct_field: public Sql_alloc
     return false;
   }
 
+  /* Whether walk_tree_with_histogram() can be used */
+  virtual bool can_build_histogram()
+  {
+    return true;
+  }
+
   ulonglong get_count_distinct()
   {
     return distincts;
@@ -1852,6 +1859,76 @@ class Count_distinct_field_bit: public Count_distinct_field
 };
 
 
+/*
+  The class Count_distinct_field_hll is derived from the class
+  Count_distinct_field to be used when analyze_ndv_method=HYPERLOGLOG.
+  Instead of collecting all values in a Unique object it only feeds their
+  hashes to a Hyperloglog sketch: the memory used is fixed and nothing has
+  to be sorted or merged, but the result is an estimate and no histogram
+  can be built from it.
+*/
+
+class Count_distinct_field_hll: public Count_distinct_field
+{
+  Hyperloglog *sketch;
+
+public:
+
+  Count_distinct_field_hll(Field *field)
+  {
+    table_field= field;
+    tree= NULL;
+    tree_key_length= 0;
+    sketch= new Hyperloglog;
+  }
+
+  ~Count_distinct_field_hll()
+  {
+    delete sketch;
+  }
+
+  bool exists() override
+  {
+    return (sketch != NULL);
+  }
+
+  bool add() override
+  {
+    uint length= table_field->pack_length();
+    if (table_field->cmp_type() != STRING_RESULT &&
+        table_field->type() != MYSQL_TYPE_BIT &&
+        table_field->binary() && length <= sizeof(ulonglong))
+    {
+      /*
+        Short numbers and temporals are compared by their image, which is
+        a better hash than what Hasher would make of it.
+      */
+      ulonglong image= 0;
+      memcpy(&image, table_field->ptr, length);
+      sketch->add(image);
+    }
+    else
+    {
+      Hasher hasher;
+      table_field->hash_not_null(&hasher);
+      sketch->add(hasher.finalize_ulonglong());
+    }
+    return false;
+  }
+
+  void walk_tree() override
+  {
+    distincts= sketch->estimate();
+    distincts_single_occurence= 0;
+  }
+
+  bool can_build_histogram() override
+  {
+    return false;
+  }
+};
+
+
 /* 
   The class Index_prefix_calc is a helper class used to calculate the values
   for the column 'avg_frequency' of the statistical table index_stats.
@@ -2416,7 +2493,9 @@ void Column_statistics_collected::init(THD *thd, Field *table_field)
   column_total_length= 0;
   if (is_single_pk_col)
     count_distinct= NULL;
-  if (table_field->flags & BLOB_FLAG)
+  if (thd->variables.analyze_ndv_method == ANALYZE_NDV_HYPERLOGLOG)
+    count_distinct= new Count_distinct_field_hll(table_field);
+  else if (table_field->flags & BLOB_FLAG)
     count_distinct= NULL;
   else
   {
@@ -2493,7 +2572,8 @@ bool Column_statistics_collected::finish(MEM_ROOT *mem_root, ha_rows rows,
     Histogram_type hist_type= 
       (Histogram_type) (current_thd->variables.histogram_type);
     bool have_histogram= false;
-    if (hist_size != 0 && hist_type != INVALID_HISTOGRAM)
+    if (hist_size != 0 && hist_type != INVALID_HISTOGRAM &&
+        count_distinct->can_build_histogram())
     {
       have_histogram= true;
       histogram= create_histogram(mem_root, hist_type, current_thd);
@@ -2707,6 +2787,9 @@ int collect_statistics_for_index(THD *thd, TABLE *table, uint index)
   (or its derivation). Currently this class cannot count the number of
   distinct values for blob columns. So the value of 'avg_frequency' for
   blob columns is always null.
+  When only a sample of the rows is needed and the engine supports block
+  sampling (see handler::sample_init()) only the sampled pages are read
+  instead of the whole table.
   After the full table scan the function calls collect_statistics_for_index
   for each table index. The latter performs full index scan for each index.
 
@@ -2763,12 +2846,21 @@ int collect_statistics_for_table(THD *thd, TABLE *table)
 
   restore_record(table, s->default_values);
 
-  /* Perform a full table scan to collect statistics on 'table's columns */
-  if (!(rc= file->ha_rnd_init(TRUE)))
+  /*
+    When sampling, let the engine read only the sampled pages if it can.
+    Otherwise perform a full table scan and skip the rows not sampled.
+  */
+  bool block_sampling= sample_fraction < 1 &&
+                       !file->ha_sample_init(sample_fraction);
+
+  /* Perform a table scan to collect statistics on 'table's columns */
+  if (block_sampling || !(rc= file->ha_rnd_init(TRUE)))
   {
     DEBUG_SYNC(table->in_use, "statistics_collection_start");
 
-    while ((rc= file->ha_rnd_next(table->record[0])) != HA_ERR_END_OF_FILE)
+    while ((rc= block_sampling ? file->ha_sample_next(table->record[0]) :
+                                 file->ha_rnd_next(table->record[0])) !=
+           HA_ERR_END_OF_FILE)
     {
       if (thd->killed)
         break;
@@ -2776,7 +2868,7 @@ int collect_statistics_for_table(THD *thd, TABLE *table)
       if (rc)
         break;
 
-      if (thd_rnd(thd) <= sample_fraction)
+      if (block_sampling || thd_rnd(thd) <= sample_fraction)
       {
         for (field_ptr= table->field; *field_ptr; field_ptr++)
         {
@@ -2791,7 +2883,10 @@ int collect_statistics_for_table(THD *thd, TABLE *table)
         rows++;
       }
     }
-    file->ha_rnd_end();
+    if (block_sampling)
+      file->ha_sample_end();
+    else
+      file->ha_rnd_end();
   }
   rc= (rc == HA_ERR_END_OF_FILE && !thd->killed) ? 0 : 1;
 
@@ -50,6 +50,13 @@ enum enum_histogram_type
   INVALID_HISTOGRAM
 } Histogram_type;
 
+/* Values of @@analyze_ndv_method */
+enum enum_analyze_ndv_method
+{
+  ANALYZE_NDV_EXACT,
+  ANALYZE_NDV_HYPERLOGLOG
+};
+
 enum enum_stat_tables
 {
   TABLE_STAT,
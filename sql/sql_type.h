@@ -147,6 +147,11 @@ class Hasher
   {
     return (uint32) m_nr1;
   }
+  /* All the accumulated state, for consumers such as Hyperloglog */
+  ulonglong finalize_ulonglong() const
+  {
+    return (ulonglong) m_nr1 ^ ((ulonglong) m_nr2 << 32);
+  }
 };
 
 
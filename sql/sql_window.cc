@@ -2277,6 +2277,242 @@ class Frame_scan_cursor : public Frame_cursor
   }
 };
 
+/*
+  A cursor that computes MIN() or MAX() over a frame without rescanning the
+  frame for every row. It is used instead of Frame_scan_cursor.
+
+  @detail
+    The frame bounds never move backwards within a partition. The cursor
+    keeps a "monotonic deque" of the rows in the frame that may still become
+    the result: for MIN(), the values in the deque are non-decreasing from
+    front to back (non-increasing for MAX()). A new row at the bottom of the
+    frame removes all the rows with a worse value from the back of the deque,
+    and rows that leave the frame at the top are removed from the front.
+    The front row holds the result, which is computed by adding only that
+    row to the sum function.
+
+    Every row is added to and removed from the deque at most once, so the
+    computation is O(n) instead of O(n * frame_size).
+*/
+class Frame_min_max_cursor : public Frame_cursor
+{
+public:
+  Frame_min_max_cursor(const Frame_cursor &top_bound,
+                       const Frame_cursor &bottom_bound) :
+    top_bound(top_bound), bottom_bound(bottom_bound),
+    curr_rownum(0), next_rownum(0), rows(PSI_INSTRUMENT_MEM), first(0),
+    free_values(PSI_INSTRUMENT_MEM), cmp_proto(NULL) {}
+
+  ~Frame_min_max_cursor()
+  {
+    reset(0);
+    for (size_t i= 0; i < free_values.elements(); i++)
+      delete free_values.at(i);
+    delete cmp_proto;
+  }
+
+  /*
+    Check if the cursor can compute a window function. This requires
+    cmp_item::compare() to compare the values like Item_sum_min_max does.
+  */
+  static bool can_compute(Item_sum *item)
+  {
+    if (item->sum_func() != Item_sum::MIN_FUNC &&
+        item->sum_func() != Item_sum::MAX_FUNC)
+      return false;
+    Item *arg= item->get_arg(0);
+    const Type_handler *handler=
+      arg->type_handler()->type_handler_for_comparison();
+    if (handler == &type_handler_slonglong)
+      return !arg->unsigned_flag; /* cmp_item_int is for signed values */
+    return handler == &type_handler_double ||
+           handler == &type_handler_newdecimal ||
+           handler == &type_handler_long_blob ||
+           handler == &type_handler_time ||
+           handler == &type_handler_newdate ||
+           handler == &type_handler_datetime ||
+           handler == &type_handler_timestamp;
+  }
+
+  void init(READ_RECORD *info)
+  {
+    cursor.init(info);
+    Item_sum *item= sum_functions.head();
+    DBUG_ASSERT(can_compute(item));
+    arg= item->get_arg(0);
+    is_min= item->sum_func() == Item_sum::MIN_FUNC;
+    if (!cmp_proto)
+      cmp_proto= arg->type_handler()->type_handler_for_comparison()->
+        make_cmp_item(info->thd, arg->collation.collation);
+    thd= info->thd;
+  }
+
+  void pre_next_partition(ha_rows rownum)
+  {
+    curr_rownum= rownum;
+    reset(rownum);
+    clear_sum_functions();
+  }
+
+  void next_partition(ha_rows rownum)
+  {
+    compute_values_for_current_row();
+  }
+
+  void pre_next_row()
+  {
+    clear_sum_functions();
+  }
+
+  void next_row()
+  {
+    curr_rownum++;
+    compute_values_for_current_row();
+  }
+
+  ha_rows get_curr_rownum() const
+  {
+    return curr_rownum;
+  }
+
+private:
+  /* A row that may become the result, and its value */
+  struct Min_max_row
+  {
+    ha_rows rownum;
+    cmp_item *value;
+  };
+
+  const Frame_cursor &top_bound;
+  const Frame_cursor &bottom_bound;
+  Table_read_cursor cursor;
+  ha_rows curr_rownum;
+  /* The first row that has not been considered for the deque yet */
+  ha_rows next_rownum;
+  /* The deque, starting at rows.at(first) */
+  Dynamic_array<Min_max_row> rows;
+  size_t first;
+  /* Values of rows that have been removed from the deque, for reuse */
+  Dynamic_array<cmp_item*> free_values;
+  cmp_item *cmp_proto;
+  Item *arg;
+  bool is_min;
+  THD *thd;
+
+  /* Empty the deque; the next row to consider is rownum. */
+  void reset(ha_rows rownum)
+  {
+    for (size_t i= first; i < rows.elements(); i++)
+      if (free_values.append(rows.at(i).value))
+        delete rows.at(i).value;
+    rows.clear();
+    first= 0;
+    next_rownum= rownum;
+  }
+
+  void pop_front()
+  {
+    if (free_values.append(rows.at(first).value))
+      delete rows.at(first).value;
+    if (++first == rows.elements())
+    {
+      rows.clear();
+      first= 0;
+    }
+  }
+
+  void pop_back()
+  {
+    if (free_values.append(rows.back()->value))
+      delete rows.back()->value;
+    rows.pop();
+    if (first == rows.elements())
+    {
+      rows.clear();
+      first= 0;
+    }
+  }
+
+  /* Whether the deque should keep a row with the value a over the later
+     row with the value b. The earlier row wins ties, like in
+     Item_sum_min_max::add(). */
+  bool is_better(cmp_item *a, cmp_item *b) const
+  {
+    int res= a->compare(b);
+    return is_min ? res <= 0 : res >= 0;
+  }
+
+  /* Add the row that cursor points to at the back of the deque. */
+  bool push_back(ha_rows rownum)
+  {
+    cmp_item *value;
+    if (free_values.elements())
+      value= free_values.pop();
+    else if (!(value= cmp_proto->make_same(thd)))
+      return true;
+    value->store_value(arg);
+    if (arg->null_value)
+    {
+      /* NULL values are ignored by MIN() and MAX(). */
+      if (free_values.append(value))
+        delete value;
+      return false;
+    }
+    while (first != rows.elements() && !is_better(rows.back()->value, value))
+      pop_back();
+    if (first >= 64 && first * 2 >= rows.elements())
+    {
+      /* Reclaim the space at the start of the array. */
+      for (size_t i= first; i < rows.elements(); i++)
+        rows.at(i - first)= rows.at(i);
+      rows.elements(rows.elements() - first);
+      first= 0;
+    }
+    Min_max_row row= {rownum, value};
+    return rows.append(row);
+  }
+
+  void compute_values_for_current_row()
+  {
+    if (top_bound.is_outside_computation_bounds() ||
+        bottom_bound.is_outside_computation_bounds())
+      return;
+
+    ha_rows top_rownum= top_bound.get_curr_rownum();
+    ha_rows bottom_rownum= bottom_bound.get_curr_rownum();
+    DBUG_PRINT("info", ("COMPUTING (%llu %llu)", top_rownum, bottom_rownum));
+
+    /* Add the rows that entered the frame at the bottom. */
+    ha_rows rownum= MY_MAX(next_rownum, top_rownum);
+    if (rownum <= bottom_rownum)
+    {
+      cursor.move_to(rownum);
+      for (; rownum <= bottom_rownum; rownum++)
+      {
+        if (cursor.fetch() || push_back(rownum)) //EOF
+          break;
+        if (cursor.next()) // EOF
+        {
+          rownum++;
+          break;
+        }
+      }
+      next_rownum= rownum;
+    }
+
+    /* Remove the rows that left the frame at the top. */
+    while (first != rows.elements() && rows.at(first).rownum < top_rownum)
+      pop_front();
+
+    if (first != rows.elements())
+    {
+      cursor.move_to(rows.at(first).rownum);
+      if (!cursor.fetch())
+        add_value_to_items();
+    }
+  }
+};
+
 /* A cursor that follows a target cursor. Each time a new row is added,
    the window functions are cleared and only have the row at which the target
    is point at added to them.
@@ -2749,8 +2985,11 @@ void get_window_functions_required_cursors(
     {
       frame_bottom->set_no_action();
       frame_top->set_no_action();
-      Frame_cursor *scan_cursor= new Frame_scan_cursor(*frame_top,
-                                                       *frame_bottom);
+      Frame_cursor *scan_cursor;
+      if (Frame_min_max_cursor::can_compute(sum_func))
+        scan_cursor= new Frame_min_max_cursor(*frame_top, *frame_bottom);
+      else
+        scan_cursor= new Frame_scan_cursor(*frame_top, *frame_bottom);
       scan_cursor->add_sum_func(sum_func);
       cursor_manager->add_cursor(scan_cursor);
 
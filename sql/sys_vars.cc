@@ -51,6 +51,7 @@
 #include "hostname.h"                           // host_cache_size
 #include <myisam.h>
 #include "debug_sync.h"                         // DEBUG_SYNC
+#include "sql_prepare.h"                        // shrink_prepared_statement_cache
 #include "sql_show.h"
 #include "opt_trace_context.h"
 #include "log_event.h"
@@ -446,6 +447,16 @@ static Sys_var_double Sys_analyze_sample_percentage(
        CMD_LINE(REQUIRED_ARG), VALID_RANGE(0, 100),
        DEFAULT(100));
 
+static const char *analyze_ndv_method_names[]= {"EXACT", "HYPERLOGLOG", 0};
+static Sys_var_enum Sys_analyze_ndv_method(
+       "analyze_ndv_method",
+       "How ANALYZE TABLE computes the number of distinct values of a "
+       "column. EXACT - sort all values, also needed to build histograms; "
+       "HYPERLOGLOG - estimate with a fixed size sketch, about 1% error, "
+       "no histograms are built.",
+       SESSION_VAR(analyze_ndv_method), CMD_LINE(REQUIRED_ARG),
+       analyze_ndv_method_names, DEFAULT(ANALYZE_NDV_EXACT));
+
 static Sys_var_ulong Sys_auto_increment_increment(
        "auto_increment_increment",
        "Auto-increment columns are incremented by this",
@@ -2568,6 +2579,26 @@ static Sys_var_uint Sys_max_prepared_stmt_count(
        VALID_RANGE(0, UINT_MAX32), DEFAULT(16382), BLOCK_SIZE(1),
        &PLock_prepared_stmt_count);
 
+static bool fix_prepared_stmt_cache_size(sys_var *, THD *thd,
+                                         enum_var_type type)
+{
+  if (type == OPT_SESSION)
+    shrink_prepared_statement_cache(thd);
+  return false;
+}
+
+static Sys_var_ulong Sys_prepared_stmt_cache_size(
+       "prepared_stmt_cache_size",
+       "Number of closed prepared statements that a connection keeps for "
+       "reuse. A prepare of the same statement text takes a kept statement "
+       "back without parsing it again, if the definitions of its tables did "
+       "not change. Only DML statements are kept. The kept statements count "
+       "against max_prepared_stmt_count. 0 disables the cache.",
+       SESSION_VAR(prepared_stmt_cache_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 65536), DEFAULT(0), BLOCK_SIZE(1),
+       NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
+       ON_UPDATE(fix_prepared_stmt_cache_size));
+
 static Sys_var_ulong Sys_max_recursive_iterations(
        "max_recursive_iterations",
        "Maximum number of iterations when executing recursive queries",
@@ -2715,6 +2746,14 @@ static Sys_var_ulong Sys_net_retry_count(
        BLOCK_SIZE(1), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
        ON_UPDATE(fix_net_retry_count));
 
+static Sys_var_uint Sys_protocol_compression_level(
+       "protocol_compression_level",
+       "zlib compression level of the compressed client/server protocol, "
+       "for the connections that keep a compression stream for the life of "
+       "the connection (1 gives best speed, 9 gives best compression)",
+       GLOBAL_VAR(opt_protocol_compression_level), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 9), DEFAULT(6), BLOCK_SIZE(1));
+
 static bool set_old_mode (sys_var *self, THD *thd, enum_var_type type)
 {
   if (thd->variables.old_mode)
@@ -2878,6 +2917,8 @@ export const char *optimizer_switch_names[]=
   "rowid_filter",
   "condition_pushdown_from_having",
   "not_null_range_scan",
+  "join_order_dp",
+  "join_cache_bloom_filter",
   "default", 
   NullS
 };
@@ -3094,6 +3135,44 @@ static Sys_var_uint Sys_eq_range_index_dive_limit(
        VALID_RANGE(0, UINT_MAX32), DEFAULT(200),
        BLOCK_SIZE(1));
 
+static Sys_var_uint Sys_parallel_scan_threads(
+       "parallel_scan_threads",
+       "Number of worker threads that read the table of a single-table "
+       "SELECT with GROUP BY or aggregate functions when it is accessed "
+       "by a full table scan, if the storage engine supports it. "
+       "The rows are returned in no particular order. 0 disables "
+       "parallel scans.",
+       SESSION_VAR(parallel_scan_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 64), DEFAULT(0), BLOCK_SIZE(1));
+
+static bool fix_derived_cache_size(sys_var *, THD *thd, enum_var_type type)
+{
+  if (type == OPT_SESSION)
+    shrink_derived_cache(thd);
+  return false;
+}
+
+static Sys_var_ulonglong Sys_derived_cache_size(
+       "derived_cache_size",
+       "Memory in bytes for keeping the rows of materialized derived tables "
+       "and CTEs of prepared statements between executions. A derived "
+       "table is filled from the cache if its text, the values of the "
+       "parameters and the tables it reads did not change. 0 disables "
+       "the cache.",
+       SESSION_VAR(derived_cache_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, SIZE_T_MAX), DEFAULT(0), BLOCK_SIZE(1024),
+       NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
+       ON_UPDATE(fix_derived_cache_size));
+
+static Sys_var_ulonglong Sys_subquery_cache_hash_size(
+       "subquery_cache_hash_size",
+       "Maximum size in bytes of the in-memory hash table that a subquery "
+       "cache uses when its parameters and result are short. When the "
+       "table is full, the least recently used entries are evicted. "
+       "0 keeps all subquery caches in temporary tables.",
+       SESSION_VAR(subquery_cache_hash_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, SIZE_T_MAX), DEFAULT(0), BLOCK_SIZE(1024));
+
 static Sys_var_ulong Sys_range_alloc_block_size(
        "range_alloc_block_size",
        "Allocation block size for storing ranges during optimization",
@@ -5374,6 +5453,24 @@ static Sys_var_set Sys_log_output(
        ON_CHECK(check_not_empty_set), ON_UPDATE(fix_log_output));
 
 #ifdef HAVE_REPLICATION
+static const char *slave_rows_search_algorithms_names[]=
+  {"TABLE_SCAN", "INDEX_SCAN", "HASH_SCAN", 0};
+static Sys_var_on_access_global<Sys_var_set,
+                      PRIV_SET_SYSTEM_GLOBAL_VAR_SLAVE_ROWS_SEARCH_ALGORITHMS>
+Sys_slave_rows_search_algorithms(
+       "slave_rows_search_algorithms",
+       "How the slave finds the rows of row-based UPDATE and DELETE events. "
+       "INDEX_SCAN looks the rows up by the primary key, a unique key or "
+       "else another index of the table. Without an index, HASH_SCAN finds "
+       "all the rows of an event in one scan of the table, while TABLE_SCAN "
+       "scans the table for each row. HASH_SCAN is preferred if both are "
+       "given",
+       GLOBAL_VAR(slave_rows_search_algorithms_options), CMD_LINE(REQUIRED_ARG),
+       slave_rows_search_algorithms_names,
+       DEFAULT((1ULL << SLAVE_ROWS_TABLE_SCAN) |
+               (1ULL << SLAVE_ROWS_INDEX_SCAN)),
+       NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(check_not_empty_set));
+
 static Sys_var_mybool Sys_log_slave_updates(
        "log_slave_updates", "Tells the slave to log the updates from "
        "the slave thread to the binary log. You will need to turn it on if "
@@ -5441,6 +5538,17 @@ Sys_relay_log_recovery(
        "processed.",
        GLOBAL_VAR(relay_log_recovery), CMD_LINE(OPT_ARG), DEFAULT(FALSE));
 
+static Sys_var_on_access_global<Sys_var_mybool,
+                                PRIV_SET_SYSTEM_GLOBAL_VAR_RELAY_LOG_BUFFERED>
+Sys_relay_log_buffered(
+       "relay_log_buffered", "For the connections that use GTID, keep the "
+       "received events in the memory buffer of the relay log, from which "
+       "the SQL thread applies them, and write the buffer to the relay log "
+       "file only when it is full, on relay log rotation and when the IO "
+       "thread stops. Such relay logs are not synced to disk, as they are "
+       "discarded when replication restarts from the GTID position",
+       GLOBAL_VAR(relay_log_buffered), CMD_LINE(OPT_ARG), DEFAULT(FALSE));
+
 
 bool Sys_var_rpl_filter::global_update(THD *thd, set_var *var)
 {
@@ -59,6 +59,7 @@
 #endif   // ZIP_SUPPORT
 #include "tabfmt.h"
 #include "tabmul.h"
+#include "my_scan_bytes.h"
 #define  NO_FUNC
 #include "plgcnx.h"                       // For DB types
 #include "resource.h"
@@ -909,9 +910,10 @@ bool TDBCSV::SkipHeader(PGLOBAL g)
 int TDBCSV::ReadBuffer(PGLOBAL g)
   {
   //char *p1, *p2, *p = NULL;
-	char *p2, *p = NULL;
+	char *p2, *p = NULL, *end = NULL;
 	int   i, n, len, rc = Txfp->ReadBuffer(g);
   bool  bad = false;
+	MY_BYTE_SET qbytes;
 
   if (trace(2))
     htrc("CSV: Row is '%s' rc=%d\n", To_Line, rc);
@@ -931,13 +933,27 @@ int TDBCSV::ReadBuffer(PGLOBAL g)
         //  else
         //    break;                            // Final quote
 
-				for (n = 0, p = ++p2; p; p++)
-					if (*p == Qot || *p == '\\') {
-						if (*(++p) == Qot)
-							n++;														// Escaped internal quotes
-						else if (*(p - 1) == Qot)
-							break;													// Final quote
-					}	// endif *p
+				if (!end) {
+					int qb[] = {(uchar)Qot, '\\'};
+
+					my_byte_set_init(&qbytes, qb, 2);
+					end = To_Line + strlen(To_Line);
+				}	// endif end
+
+				for (n = 0, p = ++p2; ; p++) {
+					// Skip to the next quote or escape
+					if ((p = (char*)my_scan_bytes(&qbytes, (uchar*)p,
+					                              (uchar*)end)) == end) {
+						p = NULL;												// No final quote
+						break;
+					}	// endif p
+
+					if (*(++p) == Qot)
+						n++;														// Escaped internal quotes
+					else if (*(p - 1) == Qot)
+						break;													// Final quote
+
+				}	// endfor p
 
         if (p) {
           //len = p++ - p2;
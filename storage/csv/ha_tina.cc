@@ -481,25 +481,34 @@ static int free_share(TINA_SHARE *share)
 my_off_t find_eoln_buff(Transparent_file *data_buff, my_off_t begin,
                      my_off_t end, int *eoln_len)
 {
+  static const MY_BYTE_SET eoln_bytes= {{'\n', '\r', '\n', '\n'}, 2};
   *eoln_len= 0;
 
-  for (my_off_t x= begin; x < end; x++)
+  for (my_off_t x= begin; x < end; )
   {
+    my_off_t window_end;
+    const uchar *from= data_buff->window(x, &window_end);
+    if (!from)
+      break;
+    window_end= MY_MIN(window_end, end);
+    const uchar *found= my_scan_bytes(&eoln_bytes, from,
+                                      from + (window_end - x));
+    x+= found - from;
+    if (x == window_end)
+      continue;
+
     /* Unix (includes Mac OS X) */
-    if (data_buff->get_value(x) == '\n')
+    if (*found == '\n')
       *eoln_len= 1;
-    else
-      if (data_buff->get_value(x) == '\r') // Mac or Dos
-      {
-        /* old Mac line ending */
-        if (x + 1 == end || (data_buff->get_value(x + 1) != '\n'))
-          *eoln_len= 1;
-        else // DOS style ending
-          *eoln_len= 2;
-      }
-
-    if (*eoln_len)  // end of line was found
-      return x;
+    else // Mac or Dos
+    {
+      /* old Mac line ending */
+      if (x + 1 == end || (data_buff->get_value(x + 1) != '\n'))
+        *eoln_len= 1;
+      else // DOS style ending
+        *eoln_len= 2;
+    }
+    return x;
   }
 
   return 0;
@@ -671,8 +680,36 @@ int ha_tina::chain_append()
 /*
   Scans for a row.
 */
+/*
+  Append to buffer the bytes of the data file from offset up to the first
+  byte of a set or up to end.
+
+  @return the offset of the first byte that was not appended
+*/
+my_off_t ha_tina::copy_field_bytes(my_off_t offset, my_off_t end,
+                                   const MY_BYTE_SET *stop)
+{
+  while (offset < end)
+  {
+    my_off_t window_end;
+    const uchar *from= file_buff->window(offset, &window_end);
+    if (!from)
+      break;
+    window_end= MY_MIN(window_end, end);
+    const uchar *to= my_scan_bytes(stop, from, from + (window_end - offset));
+    buffer.append((const char*) from, (size_t) (to - from));
+    offset+= to - from;
+    if (offset < window_end)
+      break;
+  }
+  return offset;
+}
+
+
 int ha_tina::find_current_row(uchar *buf)
 {
+  static const MY_BYTE_SET quoted_bytes= {{'"', '\\', '"', '"'}, 2};
+  static const MY_BYTE_SET unquoted_bytes= {{',', '\\', ',', ','}, 2};
   my_off_t end_offset, curr_offset= current_position;
   int eoln_len;
   int error;
@@ -745,6 +782,9 @@ int ha_tina::find_current_row(uchar *buf)
       /* Loop through the row to extract the values for the current field */
       for ( ; curr_offset < end_offset; curr_offset++)
       {
+        /* Copy the ordinary symbols, up to the last one of the line */
+        curr_offset= copy_field_bytes(curr_offset, end_offset - 1,
+                                      &quoted_bytes);
         curr_char= file_buff->get_value(curr_offset);
         /* check for end of the current field */
         if (curr_char == '"' &&
@@ -797,6 +837,8 @@ int ha_tina::find_current_row(uchar *buf)
     {
       for ( ; curr_offset < end_offset; curr_offset++)
       {
+        curr_offset= copy_field_bytes(curr_offset, end_offset - 1,
+                                      &unquoted_bytes);
         curr_char= file_buff->get_value(curr_offset);
         /* Move past the ,*/
         if (curr_char == ',')
@@ -16,6 +16,7 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <my_dir.h>
+#include <my_scan_bytes.h>
 #include "transparent_file.h"
 
 #define DEFAULT_CHAIN_LENGTH 512
@@ -88,6 +89,8 @@ class ha_tina final : public handler
   int curr_lock_type;
 
   bool get_write_pos(my_off_t *end_pos, tina_set *closest_hole);
+  my_off_t copy_field_bytes(my_off_t offset, my_off_t end,
+                            const MY_BYTE_SET *stop);
   int open_update_temp_file_if_needed();
   int init_tina_writer();
   int init_data_file();
@@ -107,3 +107,17 @@ char Transparent_file::get_value(my_off_t offset)
 
   return buff[0];
 }
+
+
+/*
+  Return the bytes of the window that contains offset, reading the window
+  if needed, from offset up to window_end; NULL at the end of the file
+*/
+const uchar *Transparent_file::window(my_off_t offset, my_off_t *window_end)
+{
+  get_value(offset);
+  if (offset < lower_bound || offset >= upper_bound)
+    return NULL;
+  *window_end= upper_bound;
+  return buff + (offset - lower_bound);
+}
@@ -39,5 +39,6 @@ class Transparent_file
   my_off_t start();
   my_off_t end();
   char get_value (my_off_t offset);
+  const uchar *window(my_off_t offset, my_off_t *window_end);
   my_off_t read_next();
 };
@@ -1286,10 +1286,19 @@ inline bool buf_pool_t::realloc(buf_block_t *block)
 
 void buf_pool_t::io_buf_t::create(ulint n_slots)
 {
+  ut_ad(n_slots < FIL_NULL);
+  DBUG_EXECUTE_IF("ib_io_buf_one_slot", n_slots= 1;);
   this->n_slots= n_slots;
   slots= static_cast<buf_tmp_buffer_t*>
     (ut_malloc_nokey(n_slots * sizeof *slots));
   memset((void*) slots, 0, n_slots * sizeof *slots);
+  for (ulint i= 0; i < n_slots; i++)
+    slots[i].next_free.store(uint32_t(i + 1 == n_slots ? FIL_NULL : i + 1),
+                             std::memory_order_relaxed);
+  free_head.store(n_slots ? 0 : FIL_NULL, std::memory_order_relaxed);
+  n_waiting.store(0, std::memory_order_relaxed);
+  mysql_mutex_init(PSI_NOT_INSTRUMENTED, &mutex, nullptr);
+  pthread_cond_init(&released, nullptr);
 }
 
 void buf_pool_t::io_buf_t::close()
@@ -1302,20 +1311,64 @@ void buf_pool_t::io_buf_t::close()
   ut_free(slots);
   slots= nullptr;
   n_slots= 0;
+  mysql_mutex_destroy(&mutex);
+  pthread_cond_destroy(&released);
 }
 
-buf_tmp_buffer_t *buf_pool_t::io_buf_t::reserve()
+buf_tmp_buffer_t *buf_pool_t::io_buf_t::pop()
 {
+  uint64_t head= free_head.load();
   for (;;)
   {
-    for (buf_tmp_buffer_t *s= slots, *e= slots + n_slots; s != e; s++)
-      if (s->acquire())
-        return s;
-    os_aio_wait_until_no_pending_writes();
-    for (buf_tmp_buffer_t *s= slots, *e= slots + n_slots; s != e; s++)
-      if (s->acquire())
-        return s;
-    os_aio_wait_until_no_pending_reads();
+    const uint32_t i= uint32_t(head);
+    if (i == FIL_NULL)
+      return nullptr;
+    ut_ad(i < n_slots);
+    /* If another thread pops and pushes slots[i] meanwhile, the
+    counter in the high 32 bits will make the exchange fail. */
+    const uint64_t next= ((head >> 32) + 1) << 32 |
+      slots[i].next_free.load(std::memory_order_relaxed);
+    if (free_head.compare_exchange_weak(head, next))
+      return &slots[i];
+  }
+}
+
+buf_tmp_buffer_t *buf_pool_t::io_buf_t::reserve()
+{
+  if (buf_tmp_buffer_t *s= pop())
+    return s;
+  mysql_mutex_lock(&mutex);
+  n_waiting++;
+  buf_tmp_buffer_t *s;
+  if (!(s= pop()))
+  {
+    /* This may be a task of srv_thread_pool that would release a slot
+    only after another task has run. */
+    tpool::tpool_wait_begin();
+    while (!(s= pop()))
+      my_cond_wait(&released, &mutex.m_mutex);
+    tpool::tpool_wait_end();
+  }
+  n_waiting--;
+  mysql_mutex_unlock(&mutex);
+  return s;
+}
+
+void buf_pool_t::io_buf_t::release(buf_tmp_buffer_t *slot)
+{
+  ut_ad(slot >= slots);
+  ut_ad(slot < slots + n_slots);
+  const uint32_t i= uint32_t(slot - slots);
+  uint64_t head= free_head.load(std::memory_order_relaxed);
+  do
+    slot->next_free.store(uint32_t(head), std::memory_order_relaxed);
+  while (!free_head.compare_exchange_weak(head,
+                                          ((head >> 32) + 1) << 32 | i));
+  if (n_waiting)
+  {
+    mysql_mutex_lock(&mutex);
+    pthread_cond_broadcast(&released);
+    mysql_mutex_unlock(&mutex);
   }
 }
 
@@ -26,6 +26,7 @@ Created 2011/12/19
 
 #include "buf0dblwr.h"
 #include "buf0buf.h"
+#include "buf0flu.h"
 #include "buf0checksum.h"
 #include "srv0start.h"
 #include "srv0srv.h"
@@ -34,11 +35,28 @@ Created 2011/12/19
 #include "fil0crypt.h"
 #include "fil0pagecompress.h"
 
+#include <algorithm>
+
 using st_::span;
 
 /** The doublewrite buffer */
 buf_dblwr_t buf_dblwr;
 
+/** Tasks for writing batches to the doublewrite files */
+static tpool::task buf_dblwr_file_tasks[buf_dblwr_t::MAX_FILES];
+
+/** Generate the path of a doublewrite file.
+@param path  generated path, of FN_REFLEN bytes
+@param i     file number */
+static void buf_dblwr_file_path(char *path, uint i)
+{
+  /* Like the system tablespace, the files reside in innodb_data_home_dir. */
+  const char *dir= *srv_data_home ? srv_data_home : fil_path_to_mysql_datadir;
+  const size_t len= strlen(dir);
+  snprintf(path, FN_REFLEN, len && dir[len - 1] == '/'
+           ? "%sib_doublewrite%u" : "%s/ib_doublewrite%u", dir, i);
+}
+
 /** @return the TRX_SYS page */
 inline buf_block_t *buf_dblwr_trx_sys_get(mtr_t *mtr)
 {
@@ -62,22 +80,149 @@ inline void buf_dblwr_t::init(const byte *header)
 {
   ut_ad(!active_slot->first_free);
   ut_ad(!active_slot->reserved);
-  ut_ad(!batch_running);
+  ut_ad(!batches_running);
 
   block1= page_id_t(0, mach_read_from_4(header + TRX_SYS_DOUBLEWRITE_BLOCK1));
   block2= page_id_t(0, mach_read_from_4(header + TRX_SYS_DOUBLEWRITE_BLOCK2));
 
+  for (uint i= 0; i < MAX_FILES; i++)
+    slots[i].file= OS_FILE_CLOSED;
+
+  n_slots= 2;
+  n_files= 0;
+  if (srv_doublewrite_files && srv_use_doublewrite_buf &&
+      !srv_read_only_mode && !open_files())
+    ib::warn() << "Using the doublewrite buffer in the system tablespace"
+               << " instead of innodb_doublewrite_files";
+
   const uint32_t buf_size= 2 * block_size();
-  for (int i= 0; i < 2; i++)
+  for (uint i= 0; i < n_slots; i++)
   {
     slots[i].write_buf= static_cast<byte*>
       (aligned_malloc(buf_size << srv_page_size_shift, srv_page_size));
     slots[i].buf_block_arr= static_cast<element*>
       (ut_zalloc_nokey(buf_size * sizeof(element)));
+    slots[i].bpages= static_cast<page_write*>
+      (ut_zalloc_nokey(buf_size * sizeof(page_write)));
   }
   active_slot= &slots[0];
 }
 
+/** Open or create the doublewrite files.
+@return whether innodb_doublewrite_files are being used */
+bool buf_dblwr_t::open_files()
+{
+  const uint n= srv_doublewrite_files;
+  const os_offset_t size= os_offset_t{2 * block_size()} << srv_page_size_shift;
+
+  for (uint i= 0; i < n; i++)
+  {
+    char path[FN_REFLEN];
+    buf_dblwr_file_path(path, i);
+    bool success;
+    slots[i].file= os_file_create(innodb_data_file_key, path,
+                                  OS_FILE_OPEN | OS_FILE_ON_ERROR_NO_EXIT |
+                                  OS_FILE_ON_ERROR_SILENT,
+                                  OS_FILE_NORMAL, OS_DATA_FILE, false,
+                                  &success);
+    if (!success)
+    {
+      slots[i].file= os_file_create(innodb_data_file_key, path,
+                                    OS_FILE_CREATE | OS_FILE_ON_ERROR_NO_EXIT,
+                                    OS_FILE_NORMAL, OS_DATA_FILE, false,
+                                    &success);
+      if (success)
+        ib::info() << "Created doublewrite file " << path;
+    }
+
+    if (success && os_file_get_size(slots[i].file) < size &&
+        !os_file_set_size(path, slots[i].file, size))
+    {
+      os_file_close(slots[i].file);
+      success= false;
+    }
+
+    if (!success)
+    {
+      ib::error() << "Cannot open or create the doublewrite file " << path;
+      slots[i].file= OS_FILE_CLOSED;
+      while (i--)
+      {
+        os_file_close(slots[i].file);
+        slots[i].file= OS_FILE_CLOSED;
+      }
+      return false;
+    }
+  }
+
+  /* One slot is being filled while the others are in flight. With a
+  single file, both slots use it, and only one batch is in flight. */
+  n_files= n;
+  n_slots= std::max(n, 2U);
+  for (uint i= 0; i < n_slots; i++)
+  {
+    slots[i].file= slots[i % n].file;
+    buf_dblwr_file_tasks[i]= tpool::task(write_file, &slots[i]);
+  }
+  return true;
+}
+
+/** Read the doublewrite files for recovery. */
+void buf_dblwr_t::load_files()
+{
+  ut_ad(!recv_buf);
+  const ulint size= ulint{2 * block_size()} << srv_page_size_shift;
+  uint n;
+
+  for (n= 0; n < MAX_FILES; n++)
+  {
+    char path[FN_REFLEN];
+    buf_dblwr_file_path(path, n);
+    bool exists;
+    os_file_type_t type;
+    if (!os_file_status(path, &exists, &type) || !exists)
+      break;
+  }
+
+  if (!n)
+    return;
+
+  recv_buf= static_cast<byte*>(aligned_malloc(n * size, srv_page_size));
+
+  for (uint i= 0; i < n; i++)
+  {
+    char path[FN_REFLEN];
+    buf_dblwr_file_path(path, i);
+    bool success;
+    pfs_os_file_t file=
+      os_file_create_simple_no_error_handling(innodb_data_file_key, path,
+                                              OS_FILE_OPEN, OS_FILE_READ_ONLY,
+                                              true, &success);
+    if (!success)
+    {
+      ib::warn() << "Cannot open the doublewrite file " << path;
+      continue;
+    }
+
+    byte *buf= recv_buf + i * size;
+    const os_offset_t file_size= os_file_get_size(file);
+    const ulint len= file_size == os_offset_t(-1)
+      ? 0 : ulint(std::min(file_size, os_offset_t{size})) &
+      ~ulint{srv_page_size - 1};
+
+    if (len &&
+        os_file_read(IORequestRead, file, buf, 0, len, nullptr) != DB_SUCCESS)
+      ib::warn() << "Failed to read the doublewrite file " << path;
+    else
+      for (const byte *end= buf + len; buf < end; buf+= srv_page_size)
+        if (mach_read_from_8(my_assume_aligned<8>(buf + FIL_PAGE_LSN)))
+          /* Each valid page header must contain a nonzero FIL_PAGE_LSN. */
+          recv_sys.dblwr.add(buf);
+
+    os_file_close(file);
+  }
+}
+
 /** Create or restore the doublewrite buffer in the TRX_SYS page.
 @return whether the operation succeeded */
 bool buf_dblwr_t::create()
@@ -341,6 +486,10 @@ dberr_t buf_dblwr_t::init_or_load_pages(pfs_os_file_t file, const char *path)
         /* Each valid page header must contain a nonzero FIL_PAGE_LSN field. */
         recv_sys.dblwr.add(page);
 
+  /* The doublewrite files may exist even if innodb_doublewrite_files=0
+  now, so we always look for them. */
+  load_files();
+
   err= DB_SUCCESS;
   goto func_exit;
 }
@@ -453,6 +602,8 @@ void buf_dblwr_t::recover()
   recv_sys.dblwr.pages.clear();
   fil_flush_file_spaces();
   aligned_free(read_buf);
+  aligned_free(recv_buf);
+  recv_buf= nullptr;
 }
 
 /** Free the doublewrite buffer. */
@@ -463,21 +614,28 @@ void buf_dblwr_t::close()
 
   ut_ad(!active_slot->reserved);
   ut_ad(!active_slot->first_free);
-  ut_ad(!batch_running);
+  ut_ad(!batches_running);
 
   pthread_cond_destroy(&cond);
-  for (int i= 0; i < 2; i++)
+  for (uint i= 0; i < n_slots; i++)
   {
     aligned_free(slots[i].write_buf);
     ut_free(slots[i].buf_block_arr);
+    ut_free(slots[i].bpages);
+    if (i < n_files)
+      os_file_close(slots[i].file);
   }
+  aligned_free(recv_buf);
   mysql_mutex_destroy(&mutex);
 
   memset((void*) this, 0, sizeof *this);
 }
 
-/** Update the doublewrite buffer on write completion. */
-void buf_dblwr_t::write_completed(bool with_doublewrite)
+/** Update the doublewrite buffer on data page write completion.
+@param bpage             the page that was written
+@param with_doublewrite  whether the page was written via add_to_batch() */
+void buf_dblwr_t::write_completed(const buf_page_t *bpage,
+                                  bool with_doublewrite)
 {
   ut_ad(this == &buf_dblwr);
   ut_ad(!srv_read_only_mode);
@@ -492,21 +650,42 @@ void buf_dblwr_t::write_completed(bool with_doublewrite)
   {
     ut_ad(is_created());
     ut_ad(srv_use_doublewrite_buf);
-    ut_ad(batch_running);
-    slot *flush_slot= active_slot == &slots[0] ? &slots[1] : &slots[0];
+    ut_ad(batches_running);
+    slot *flush_slot= nullptr;
+    for (uint i= 0; i < n_slots; i++)
+    {
+      if (!slots[i].writing)
+        continue;
+      page_write *end= slots[i].bpages + slots[i].first_free;
+      page_write *w=
+        std::lower_bound(slots[i].bpages, end, bpage,
+                         [](const page_write &w, const buf_page_t *b)
+                         { return w.bpage < b; });
+      /* The page may also be in an earlier batch whose write of it
+      has completed, but it is in at most one unfinished write. */
+      if (w != end && w->bpage == bpage && !w->done)
+      {
+        w->done= true;
+        flush_slot= &slots[i];
+        break;
+      }
+    }
+    ut_a(flush_slot);
     ut_ad(flush_slot->reserved);
     ut_ad(flush_slot->reserved <= flush_slot->first_free);
 
     if (!--flush_slot->reserved)
     {
       mysql_mutex_unlock(&mutex);
+      DBUG_EXECUTE_IF("ib_dblwr_delay_batch_end", my_sleep(100000););
       /* This will finish the batch. Sync data files to the disk. */
       fil_flush_file_spaces();
       mysql_mutex_lock(&mutex);
 
       /* We can now reuse the doublewrite memory buffer: */
       flush_slot->first_free= 0;
-      batch_running= false;
+      flush_slot->writing= false;
+      batches_running--;
       pthread_cond_broadcast(&cond);
     }
   }
@@ -580,29 +759,38 @@ bool buf_dblwr_t::flush_buffered_writes(const ulint size)
   mysql_mutex_assert_owner(&mutex);
   ut_ad(size == block_size());
 
+  slot *next_slot;
+
   for (;;)
   {
     if (!active_slot->first_free)
       return false;
-    if (!batch_running)
+    if ((next_slot= find_free_slot()))
       break;
     my_cond_wait(&cond, &mutex.m_mutex);
   }
 
   ut_ad(active_slot->reserved == active_slot->first_free);
-  ut_ad(!flushing_buffered_writes);
 
   /* Disallow anyone else to start another batch of flushing. */
   slot *flush_slot= active_slot;
   /* Switch the active slot */
-  active_slot= active_slot == &slots[0] ? &slots[1] : &slots[0];
+  active_slot= next_slot;
   ut_a(active_slot->first_free == 0);
-  batch_running= true;
+  flush_slot->flushing= true;
+  batches_running++;
   const ulint old_first_free= flush_slot->first_free;
   auto write_buf= flush_slot->write_buf;
-  const bool multi_batch= block1 + static_cast<uint32_t>(size) != block2 &&
-    old_first_free > size;
-  flushing_buffered_writes= 1 + multi_batch;
+  const bool to_file= flush_slot->file != OS_FILE_CLOSED;
+  const bool multi_batch= !to_file &&
+    block1 + static_cast<uint32_t>(size) != block2 && old_first_free > size;
+  if (!to_file)
+  {
+    /* There is only one doublewrite area in the system tablespace. */
+    ut_ad(batches_running == 1);
+    ut_ad(!flushing_buffered_writes);
+    flushing_buffered_writes= 1 + multi_batch;
+  }
   pages_submitted+= old_first_free;
   /* Now safe to release the mutex. */
   mysql_mutex_unlock(&mutex);
@@ -621,6 +809,12 @@ bool buf_dblwr_t::flush_buffered_writes(const ulint size)
     ut_d(buf_dblwr_check_page_lsn(*bpage, write_buf + len2));
   }
 #endif /* UNIV_DEBUG */
+  if (to_file)
+  {
+    srv_thread_pool->submit_task(&buf_dblwr_file_tasks[flush_slot - slots]);
+    return true;
+  }
+
   const IORequest request{nullptr, nullptr, fil_system.sys_space->chain.start,
                           IORequest::DBLWR_BATCH};
   ut_a(fil_system.sys_space->acquire());
@@ -641,6 +835,30 @@ bool buf_dblwr_t::flush_buffered_writes(const ulint size)
   return true;
 }
 
+/** Write a batch to its doublewrite file and then write the pages.
+@param flush_slot  the batch */
+void buf_dblwr_t::write_file(void *flush_slot)
+{
+  slot *const s= static_cast<slot*>(flush_slot);
+  ut_ad(s->flushing);
+  ut_ad(s->file != OS_FILE_CLOSED);
+  const ulint n= s->first_free;
+  char path[FN_REFLEN];
+  buf_dblwr_file_path(path, uint(s - buf_dblwr.slots) % buf_dblwr.n_files);
+
+  if (os_file_write(IORequestWrite, path, s->file, s->write_buf, 0,
+                    n << srv_page_size_shift) != DB_SUCCESS ||
+      !os_file_flush(s->file))
+    ib::fatal() << "Cannot write to the doublewrite file " << path;
+
+  mysql_mutex_lock(&buf_dblwr.mutex);
+  buf_dblwr.writes_completed++;
+  buf_dblwr.pages_written+= n;
+  mysql_mutex_unlock(&buf_dblwr.mutex);
+
+  buf_dblwr.write_pages(s);
+}
+
 static void *get_frame(const IORequest &request)
 {
   if (request.slot)
@@ -659,7 +877,7 @@ void buf_dblwr_t::flush_buffered_writes_completed(const IORequest &request)
   ut_ad(request.node == fil_system.sys_space->chain.start);
   ut_ad(request.type == IORequest::DBLWR_BATCH);
   mysql_mutex_lock(&mutex);
-  ut_ad(batch_running);
+  ut_ad(batches_running == 1);
   ut_ad(flushing_buffered_writes);
   ut_ad(flushing_buffered_writes <= 2);
   writes_completed++;
@@ -669,7 +887,9 @@ void buf_dblwr_t::flush_buffered_writes_completed(const IORequest &request)
     return;
   }
 
-  slot *const flush_slot= active_slot == &slots[0] ? &slots[1] : &slots[0];
+  ut_ad(n_slots == 2);
+  slot *const flush_slot= slots[0].flushing ? &slots[0] : &slots[1];
+  ut_ad(flush_slot->flushing);
   ut_ad(flush_slot->reserved == flush_slot->first_free);
   /* increment the doublewrite flushed pages counter */
   pages_written+= flush_slot->first_free;
@@ -678,9 +898,32 @@ void buf_dblwr_t::flush_buffered_writes_completed(const IORequest &request)
   /* Now flush the doublewrite buffer data to disk */
   fil_system.sys_space->flush<false>();
 
+  write_pages(flush_slot);
+}
+
+/** Write the pages of a batch whose doublewrite copies are durable.
+@param flush_slot  the batch */
+void buf_dblwr_t::write_pages(slot *flush_slot)
+{
+  const ulint first_free= flush_slot->first_free;
+
+  /* Allow write_completed() to find the batch of a page. */
+  for (ulint i= 0; i < first_free; i++)
+    flush_slot->bpages[i]= {flush_slot->buf_block_arr[i].request.bpage, false};
+  std::sort(flush_slot->bpages, flush_slot->bpages + first_free,
+            [](const page_write &a, const page_write &b)
+            { return a.bpage < b.bpage; });
+
+  mysql_mutex_lock(&mutex);
+  ut_ad(flush_slot->flushing);
+  ut_ad(flush_slot->reserved == first_free);
+  flush_slot->flushing= false;
+  flush_slot->writing= true;
+  mysql_mutex_unlock(&mutex);
+
   /* The writes have been flushed to disk now and in recovery we will
   find them in the doublewrite buffer blocks. Next, write the data pages. */
-  for (ulint i= 0, first_free= flush_slot->first_free; i < first_free; i++)
+  for (ulint i= 0; i < first_free; i++)
   {
     auto e= flush_slot->buf_block_arr[i];
     buf_page_t* bpage= e.request.bpage;
@@ -719,6 +962,8 @@ posted, and also when we may have to wait for a page latch!
 Otherwise a deadlock of threads can occur. */
 void buf_dblwr_t::flush_buffered_writes()
 {
+  buf_flush_wait_encrypted();
+
   if (!is_created() || !srv_use_doublewrite_buf)
   {
     fil_flush_file_spaces();
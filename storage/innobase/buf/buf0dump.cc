@@ -33,6 +33,7 @@ Created April 08, 2011 Vasil Dimov
 
 #include "buf0buf.h"
 #include "buf0dump.h"
+#include "buf0rea.h"
 #include "dict0dict.h"
 #include "os0file.h"
 #include "srv0srv.h"
@@ -40,6 +41,7 @@ Created April 08, 2011 Vasil Dimov
 #include "ut0byte.h"
 
 #include <algorithm>
+#include <map>
 
 #include "mysql/service_wsrep.h" /* wsrep_recovery */
 #include <my_service_manager.h>
@@ -47,6 +49,7 @@ Created April 08, 2011 Vasil Dimov
 static void buf_do_load_dump();
 
 enum status_severity {
+	STATUS_VERBOSE,
 	STATUS_INFO,
 	STATUS_ERR
 };
@@ -102,6 +105,9 @@ buf_dump_status(
 		fmt, ap);
 
 	switch (severity) {
+	case STATUS_VERBOSE:
+		break;
+
 	case STATUS_INFO:
 		ib::info() << export_vars.innodb_buffer_pool_dump_status;
 		break;
@@ -141,6 +147,9 @@ buf_load_status(
 		fmt, ap);
 
 	switch (severity) {
+	case STATUS_VERBOSE:
+		break;
+
 	case STATUS_INFO:
 		ib::info() << export_vars.innodb_buffer_pool_load_status;
 		break;
@@ -326,22 +335,38 @@ buf_dump(
 		return;
 	}
 
-	for (bpage = UT_LIST_GET_FIRST(buf_pool.LRU), j = 0;
-	     bpage != NULL && j < n_pages;
-	     bpage = UT_LIST_GET_NEXT(LRU, bpage)) {
-		const auto status = bpage->state();
-		if (status < buf_page_t::UNFIXED) {
-			ut_a(status >= buf_page_t::FREED);
-			continue;
-		}
-		const page_id_t id{bpage->id()};
+	/* The dump file records the access heat of each page by its
+	position: the pages are written from the hottest to the coldest,
+	so that buf_load() can read the hottest pages first. Pages that
+	have been accessed are written in LRU order, most recently used
+	first. Pages that were never accessed since they were read
+	(typically by read-ahead) are the coldest ones and are written
+	last, if innodb_buffer_pool_dump_pct leaves room for them. */
+	j = 0;
+
+	for (ulint accessed = 2; accessed--; ) {
+		for (bpage = UT_LIST_GET_FIRST(buf_pool.LRU);
+		     bpage != NULL && j < n_pages;
+		     bpage = UT_LIST_GET_NEXT(LRU, bpage)) {
+			const auto status = bpage->state();
+			if (status < buf_page_t::UNFIXED) {
+				ut_a(status >= buf_page_t::FREED);
+				continue;
+			}
 
-		if (id.space() == SRV_TMP_SPACE_ID) {
-			/* Ignore the innodb_temporary tablespace. */
-			continue;
-		}
+			if (!bpage->is_accessed() != !accessed) {
+				continue;
+			}
+
+			const page_id_t id{bpage->id()};
+
+			if (id.space() == SRV_TMP_SPACE_ID) {
+				/* Ignore the innodb_temporary tablespace. */
+				continue;
+			}
 
-		dump[j++] = id;
+			dump[j++] = id;
+		}
 	}
 
 	mysql_mutex_unlock(&buf_pool.mutex);
@@ -415,6 +440,40 @@ buf_dump(
 	export_vars.innodb_buffer_pool_load_incomplete = 0;
 }
 
+/** Number of heat tiers that buf_load() divides the dump file into.
+The dump file lists the pages from the hottest to the coldest (see
+buf_dump()), and the pages of each tier are read in (space, page) order
+before any page of the next, colder tier. */
+static constexpr uint32_t BUF_LOAD_HEAT_TIERS = 4;
+
+/** Maximum number of consecutive pages that buf_load() submits
+in one buf_read_pages_background() call */
+static constexpr uint32_t BUF_LOAD_MAX_RUN = 64;
+
+/** Interval, in pages, for updating innodb_buffer_pool_load_status */
+static constexpr ulint BUF_LOAD_STATUS_INTERVAL = 1024;
+
+/** A page to be read by buf_load() */
+struct buf_load_entry_t {
+	/** heat tier; 0 is the hottest */
+	uint32_t	tier;
+	/** page identifier */
+	page_id_t	id;
+
+	bool operator<(const buf_load_entry_t& rhs) const
+	{
+		return tier < rhs.tier || (tier == rhs.tier && id < rhs.id);
+	}
+};
+
+/** Progress of buf_load() within a tablespace */
+struct buf_load_space_progress_t {
+	/** number of pages of the tablespace in the dump file */
+	ulint	total;
+	/** number of those pages that have been processed */
+	ulint	done;
+};
+
 /*****************************************************************//**
 Perform a buffer pool load from the file specified by
 innodb_buffer_pool_filename. If any errors occur then the value of
@@ -429,9 +488,10 @@ buf_load()
 	char		full_filename[OS_FILE_MAX_PATH];
 	char		now[32];
 	FILE*		f;
-	page_id_t*	dump;
+	buf_load_entry_t* dump;
 	ulint		dump_n;
 	ulint		i;
+	uint32_t	run;
 	uint32_t	space_id;
 	uint32_t	page_no;
 	int		fscanf_ret;
@@ -479,11 +539,12 @@ buf_load()
 
 	/* If dump is larger than the buffer pool(s), then we ignore the
 	extra trailing. This could happen if a dump is made, then buffer
-	pool is shrunk and then load is attempted. */
+	pool is shrunk and then load is attempted. Because the dump file
+	lists the hottest pages first, the coldest ones will be ignored. */
 	dump_n = std::min(dump_n, buf_pool.get_n_pages());
 
 	if (dump_n != 0) {
-		dump = static_cast<page_id_t*>(ut_malloc_nokey(
+		dump = static_cast<buf_load_entry_t*>(ut_malloc_nokey(
 				dump_n * sizeof(*dump)));
 	} else {
 		fclose(f);
@@ -541,7 +602,9 @@ buf_load()
 			return;
 		}
 
-		dump[i] = page_id_t(space_id, page_no);
+		dump[i].tier = static_cast<uint32_t>(
+			i * BUF_LOAD_HEAT_TIERS / dump_n);
+		dump[i].id = page_id_t(space_id, page_no);
 	}
 
 	/* Set dump_n to the actual number of initialized elements,
@@ -560,49 +623,88 @@ buf_load()
 		return;
 	}
 
+	/* Read the hottest pages first. Within each tier, sort by
+	(space, page) so that the pages of a tablespace are consecutive
+	and adjacent pages can be submitted as one run. */
 	if (!SHUTTING_DOWN()) {
 		std::sort(dump, dump + dump_n);
 	}
 
+	std::map<uint32_t, buf_load_space_progress_t>	progress;
+
+	for (i = 0; i < dump_n; i++) {
+		progress[dump[i].id.space()].total++;
+	}
+
 	/* Avoid calling the expensive fil_space_t::get() for each
-	page within the same tablespace. dump[] is sorted by (space, page),
-	so all pages from a given tablespace are consecutive. */
-	uint32_t	cur_space_id = dump[0].space();
+	page within the same tablespace. Within a tier, dump[] is sorted
+	by (space, page), so all pages from a given tablespace are
+	consecutive. */
+	uint32_t	cur_space_id = dump[0].id.space();
 	fil_space_t*	space = fil_space_t::get(cur_space_id);
 	ulint		zip_size = space ? space->zip_size() : 0;
+	buf_load_space_progress_t* space_progress = &progress[cur_space_id];
+	ulint		last_report = 0;
 
 	PSI_stage_progress*	pfs_stage_progress __attribute__((unused))
 		= mysql_set_stage(srv_stage_buffer_pool_load.m_key);
 	mysql_stage_set_work_estimated(pfs_stage_progress, dump_n);
 	mysql_stage_set_work_completed(pfs_stage_progress, 0);
 
-	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
+	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i += run) {
+		const page_id_t	id = dump[i].id;
 
-		/* space_id for this iteration of the loop */
-		const uint32_t this_space_id = dump[i].space();
+		/* Coalesce adjacent pages of the same tier into a run. */
+		for (run = 1; run < BUF_LOAD_MAX_RUN && i + run < dump_n
+			     && dump[i + run].tier == dump[i].tier
+			     && dump[i + run].id.space() == id.space()
+			     && dump[i + run].id.page_no()
+			     == id.page_no() + run;
+		     run++) {
+		}
 
-		if (this_space_id >= SRV_SPACE_ID_UPPER_BOUND) {
-			continue;
+#ifdef UNIV_DEBUG
+		/* Stop the run at innodb_buffer_pool_load_pages_abort,
+		so that the load is aborted after exactly that many pages. */
+		if (i < srv_buf_pool_load_pages_abort) {
+			run = static_cast<uint32_t>(std::min<ulint>(
+				run, srv_buf_pool_load_pages_abort - i));
 		}
+#endif
 
-		if (this_space_id != cur_space_id) {
+		if (id.space() != cur_space_id) {
 			if (space) {
 				space->release();
 			}
 
-			cur_space_id = this_space_id;
-			space = fil_space_t::get(cur_space_id);
-
-			if (!space) {
-				continue;
-			}
+			cur_space_id = id.space();
+			space = cur_space_id < SRV_SPACE_ID_UPPER_BOUND
+				? fil_space_t::get(cur_space_id)
+				: nullptr;
+			zip_size = space ? space->zip_size() : 0;
+			space_progress = &progress[cur_space_id];
+		}
 
-			zip_size = space->zip_size();
+		space_progress->done += run;
+
+		if (i + run - last_report >= BUF_LOAD_STATUS_INTERVAL
+		    || space_progress->done == space_progress->total) {
+			last_report = i + run;
+			buf_load_status(STATUS_VERBOSE,
+					"Loaded " ULINTPF "/" ULINTPF
+					" pages (heat tier %u/%u);"
+					" tablespace %u: " ULINTPF "/" ULINTPF,
+					i + run, dump_n,
+					dump[i].tier + 1, BUF_LOAD_HEAT_TIERS,
+					cur_space_id, space_progress->done,
+					space_progress->total);
+			mysql_stage_set_work_completed(pfs_stage_progress,
+						       i + run);
 		}
 
 		/* JAN: TODO: As we use background page read below,
 		if tablespace is encrypted we cant use it. */
-		if (!space || dump[i].page_no() >= space->get_size() ||
+		if (!space || id.page_no() >= space->get_size() ||
 		    (space->crypt_data &&
 		     space->crypt_data->encryption != FIL_ENCRYPTION_OFF &&
 		     space->crypt_data->type != CRYPT_SCHEME_UNENCRYPTED)) {
@@ -615,8 +717,10 @@ buf_load()
 			continue;
 		}
 
-		space->reacquire();
-		buf_read_page_background(space, dump[i], zip_size);
+		buf_read_pages_background(
+			space, id,
+			std::min(run, space->get_size() - id.page_no()),
+			zip_size);
 
 		if (buf_load_abort_flag) {
 			if (space) {
@@ -630,15 +734,17 @@ buf_load()
 			/* Premature end, set estimated = completed = i and
 			end the current stage event. */
 
-			mysql_stage_set_work_estimated(pfs_stage_progress, i);
-			mysql_stage_set_work_completed(pfs_stage_progress, i);
+			mysql_stage_set_work_estimated(pfs_stage_progress,
+						       i + run);
+			mysql_stage_set_work_completed(pfs_stage_progress,
+						       i + run);
 
 			mysql_end_stage();
 			return;
 		}
 
 #ifdef UNIV_DEBUG
-		if ((i+1) >= srv_buf_pool_load_pages_abort) {
+		if ((i + run) >= srv_buf_pool_load_pages_abort) {
 			buf_load_abort_flag = true;
 		}
 #endif
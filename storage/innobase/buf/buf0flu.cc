@@ -42,6 +42,9 @@ Created 11/11/1995 Heikki Tuuri
 #include "fil0pagecompress.h"
 #include "lzo/lzo1x.h"
 #include "snappy-c.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 
 /** Number of pages flushed via LRU. Protected by buf_pool.mutex.
 Also included in buf_pool.stat.n_pages_written. */
@@ -340,7 +343,8 @@ void buf_page_write_complete(const IORequest &request)
   {
     const bool temp= bpage->oldest_modification() == 2;
     if (!temp)
-      buf_dblwr.write_completed(state < buf_page_t::WRITE_FIX_REINIT &&
+      buf_dblwr.write_completed(bpage,
+                                state < buf_page_t::WRITE_FIX_REINIT &&
                                 request.node->space->use_doublewrite());
     /* We must hold buf_pool.mutex while releasing the block, so that
     no other thread can access it before we have freed it. */
@@ -353,7 +357,8 @@ void buf_page_write_complete(const IORequest &request)
   }
   else
   {
-    buf_dblwr.write_completed(state < buf_page_t::WRITE_FIX_REINIT &&
+    buf_dblwr.write_completed(bpage,
+                              state < buf_page_t::WRITE_FIX_REINIT &&
                               request.node->space->use_doublewrite());
     bpage->write_complete(false);
   }
@@ -569,6 +574,36 @@ static byte* buf_tmp_page_encrypt(ulint offset, const byte* s, byte* d)
   return d;
 }
 
+/** @return whether the pages of a tablespace are to be encrypted */
+static bool buf_space_encrypted(const fil_space_t &space)
+{
+  if (space.purpose == FIL_TYPE_TEMPORARY)
+  {
+    ut_ad(!space.crypt_data);
+    return innodb_encrypt_temporary_tables;
+  }
+  const fil_space_crypt_t *crypt_data= space.crypt_data;
+  return crypt_data && !crypt_data->not_encrypted() &&
+    crypt_data->type != CRYPT_SCHEME_UNENCRYPTED &&
+    (!crypt_data->is_default_encryption() || srv_encrypt_tables);
+}
+
+/** @return whether a page is to be encrypted or page_compressed
+by buf_page_encrypt() */
+static bool buf_page_needs_encrypt(const fil_space_t &space, page_id_t id)
+{
+  switch (id.page_no()) {
+  case TRX_SYS_PAGE_NO:
+    if (id.space() != TRX_SYS_SPACE)
+      break;
+    /* fall through */
+  case 0:
+    return false;
+  }
+  return buf_space_encrypted(space) ||
+    (space.purpose != FIL_TYPE_TEMPORARY && space.is_compressed());
+}
+
 /** Encryption and page_compression hook that is called just before
 a page is written to disk.
 @param[in,out]  space   tablespace
@@ -598,21 +633,9 @@ static byte *buf_page_encrypt(fil_space_t* space, buf_page_t* bpage, byte* s,
     return s;
   }
 
-  fil_space_crypt_t *crypt_data= space->crypt_data;
-  bool encrypted, page_compressed;
-  if (space->purpose == FIL_TYPE_TEMPORARY)
-  {
-    ut_ad(!crypt_data);
-    encrypted= innodb_encrypt_temporary_tables;
-    page_compressed= false;
-  }
-  else
-  {
-    encrypted= crypt_data && !crypt_data->not_encrypted() &&
-      crypt_data->type != CRYPT_SCHEME_UNENCRYPTED &&
-      (!crypt_data->is_default_encryption() || srv_encrypt_tables);
-    page_compressed= space->is_compressed();
-  }
+  const bool encrypted= buf_space_encrypted(*space);
+  const bool page_compressed= space->purpose != FIL_TYPE_TEMPORARY &&
+    space->is_compressed();
 
   const bool full_crc32= space->full_crc32();
 
@@ -698,6 +721,192 @@ static byte *buf_page_encrypt(fil_space_t* space, buf_page_t* bpage, byte* s,
   return d;
 }
 
+/** Encrypt or compress a write-fixed page if needed, and submit
+the write.
+@param bpage   write-fixed page
+@param space   tablespace, with a reference held until write completion
+@param type    type of the write
+@param s       bpage->state() before the page was write-fixed */
+static void buf_flush_write(buf_page_t *bpage, fil_space_t *space,
+                            IORequest::Type type, uint32_t s)
+{
+  buf_block_t *block= reinterpret_cast<buf_block_t*>(bpage);
+  page_t *write_frame= bpage->zip.data;
+  size_t size;
+#if defined HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE || defined _WIN32
+  size_t orig_size;
+#endif
+  buf_tmp_buffer_t *slot= nullptr;
+
+  if (UNIV_UNLIKELY(!bpage->frame)) /* ROW_FORMAT=COMPRESSED */
+  {
+    ut_ad(!space->full_crc32());
+    ut_ad(!space->is_compressed()); /* not page_compressed */
+    size= bpage->zip_size();
+#if defined HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE || defined _WIN32
+    orig_size= size;
+#endif
+    buf_flush_update_zip_checksum(write_frame, size);
+    write_frame= buf_page_encrypt(space, bpage, write_frame, &slot, &size);
+    ut_ad(size == bpage->zip_size());
+  }
+  else
+  {
+    byte *page= bpage->frame;
+    size= block->physical_size();
+#if defined HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE || defined _WIN32
+    orig_size= size;
+#endif
+
+    if (space->full_crc32())
+    {
+      /* innodb_checksum_algorithm=full_crc32 is not implemented for
+      ROW_FORMAT=COMPRESSED pages. */
+      ut_ad(!write_frame);
+      page= buf_page_encrypt(space, bpage, page, &slot, &size);
+      buf_flush_init_for_writing(block, page, nullptr, true);
+    }
+    else
+    {
+      buf_flush_init_for_writing(block, page,
+                                 write_frame ? &bpage->zip : nullptr, false);
+      page= buf_page_encrypt(space, bpage, write_frame ? write_frame : page,
+                             &slot, &size);
+    }
+
+#if defined HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE || defined _WIN32
+    if (size != orig_size)
+    {
+      switch (space->chain.start->punch_hole) {
+      case 1:
+        static_assert(IORequest::PUNCH_LRU - IORequest::PUNCH ==
+                      IORequest::WRITE_LRU - IORequest::WRITE_ASYNC, "");
+        type=
+          IORequest::Type(type + (IORequest::PUNCH - IORequest::WRITE_ASYNC));
+        break;
+      case 2:
+        size= orig_size;
+      }
+    }
+#endif
+    write_frame= page;
+  }
+
+  if ((s & buf_page_t::LRU_MASK) == buf_page_t::REINIT ||
+      !space->use_doublewrite())
+  {
+    if (UNIV_LIKELY(space->purpose == FIL_TYPE_TABLESPACE))
+    {
+      const lsn_t lsn=
+        mach_read_from_8(my_assume_aligned<8>(FIL_PAGE_LSN +
+                                              (write_frame ? write_frame
+                                               : bpage->frame)));
+      ut_ad(lsn >= bpage->oldest_modification());
+      log_write_up_to(lsn, true);
+    }
+    if (UNIV_LIKELY(space->purpose != FIL_TYPE_TEMPORARY))
+      buf_dblwr.add_unbuffered();
+    space->io(IORequest{type, bpage, slot}, bpage->physical_offset(), size,
+              write_frame, bpage);
+  }
+  else
+    buf_dblwr.add_to_batch(IORequest{bpage, slot, space->chain.start, type},
+                           size);
+}
+
+/** Offloading of page encryption and page_compressed compression
+from the flushing threads to srv_thread_pool. The write of each page
+is submitted as soon as the page has been processed. */
+static struct buf_flush_crypt_t
+{
+  /** A page write that is waiting for encryption or compression */
+  struct request
+  {
+    /** write-fixed page */
+    buf_page_t *bpage;
+    /** tablespace, with a reference held */
+    fil_space_t *space;
+    /** type of the write */
+    IORequest::Type type;
+    /** bpage->state() before the page was write-fixed */
+    uint32_t state;
+  };
+
+  /** maximum number of pages that a task processes at a time */
+  static constexpr size_t BATCH= 16;
+
+  /** protects all members */
+  std::mutex mutex;
+  /** signalled when n_pending reaches 0 */
+  std::condition_variable done;
+  /** requests that have not been picked up by a task */
+  std::deque<request> queue;
+  /** number of queued or unfinished requests */
+  size_t n_pending;
+  /** number of tasks submitted to srv_thread_pool */
+  ulint n_tasks;
+
+  /** Hand over a write-fixed page for encryption or compression
+  @param r   the page write */
+  void submit(const request &r)
+  {
+    std::unique_lock<std::mutex> lk(mutex);
+    queue.push_back(r);
+    n_pending++;
+    if (n_tasks >= std::max<ulint>(srv_n_write_io_threads, 1))
+      return;
+    n_tasks++;
+    lk.unlock();
+    srv_thread_pool->submit_task(&task);
+  }
+
+  /** Wait for all submitted pages to be handed over for writing */
+  void wait()
+  {
+    std::unique_lock<std::mutex> lk(mutex);
+    if (!n_pending)
+      return;
+    tpool::tpool_wait_begin();
+    done.wait(lk, [this]{ return !n_pending; });
+    tpool::tpool_wait_end();
+  }
+
+  /** Process batches of queued requests until the queue is empty */
+  static void process(void*);
+
+  /** the task that invokes process() */
+  static tpool::task task;
+} buf_flush_crypt;
+
+tpool::task buf_flush_crypt_t::task{buf_flush_crypt_t::process, nullptr};
+
+void buf_flush_crypt_t::process(void*)
+{
+  buf_flush_crypt_t &c= buf_flush_crypt;
+  request batch[BATCH];
+  std::unique_lock<std::mutex> lk(c.mutex);
+  while (const size_t n= std::min(c.queue.size(), size_t{BATCH}))
+  {
+    std::copy_n(c.queue.begin(), n, batch);
+    c.queue.erase(c.queue.begin(), c.queue.begin() + n);
+    lk.unlock();
+    for (size_t i= 0; i < n; i++)
+      buf_flush_write(batch[i].bpage, batch[i].space, batch[i].type,
+                      batch[i].state);
+    lk.lock();
+    if (!(c.n_pending-= n))
+      c.done.notify_all();
+  }
+  c.n_tasks--;
+}
+
+/** Wait for the pages that are being encrypted or page_compressed
+in the background to be submitted for writing. */
+void buf_flush_wait_encrypted()
+{
+  buf_flush_crypt.wait();
+}
+
 /** Free a page whose underlying file page has been freed. */
 ATTRIBUTE_COLD void buf_pool_t::release_freed_page(buf_page_t *bpage) noexcept
 {
@@ -772,89 +981,12 @@ bool buf_page_t::flush(bool evict, fil_space_t *space)
                         evict ? "LRU" : "flush_list",
                         id().space(), id().page_no()));
 
-  buf_block_t *block= reinterpret_cast<buf_block_t*>(this);
-  page_t *write_frame= zip.data;
-
   space->reacquire();
-  size_t size;
-#if defined HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE || defined _WIN32
-  size_t orig_size;
-#endif
-  buf_tmp_buffer_t *slot= nullptr;
-
-  if (UNIV_UNLIKELY(!frame)) /* ROW_FORMAT=COMPRESSED */
-  {
-    ut_ad(!space->full_crc32());
-    ut_ad(!space->is_compressed()); /* not page_compressed */
-    size= zip_size();
-#if defined HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE || defined _WIN32
-    orig_size= size;
-#endif
-    buf_flush_update_zip_checksum(write_frame, size);
-    write_frame= buf_page_encrypt(space, this, write_frame, &slot, &size);
-    ut_ad(size == zip_size());
-  }
-  else
-  {
-    byte *page= frame;
-    size= block->physical_size();
-#if defined HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE || defined _WIN32
-    orig_size= size;
-#endif
-
-    if (space->full_crc32())
-    {
-      /* innodb_checksum_algorithm=full_crc32 is not implemented for
-      ROW_FORMAT=COMPRESSED pages. */
-      ut_ad(!write_frame);
-      page= buf_page_encrypt(space, this, page, &slot, &size);
-      buf_flush_init_for_writing(block, page, nullptr, true);
-    }
-    else
-    {
-      buf_flush_init_for_writing(block, page, write_frame ? &zip : nullptr,
-                                 false);
-      page= buf_page_encrypt(space, this, write_frame ? write_frame : page,
-                             &slot, &size);
-    }
 
-#if defined HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE || defined _WIN32
-    if (size != orig_size)
-    {
-      switch (space->chain.start->punch_hole) {
-      case 1:
-        static_assert(IORequest::PUNCH_LRU - IORequest::PUNCH ==
-                      IORequest::WRITE_LRU - IORequest::WRITE_ASYNC, "");
-        type=
-          IORequest::Type(type + (IORequest::PUNCH - IORequest::WRITE_ASYNC));
-        break;
-      case 2:
-        size= orig_size;
-      }
-    }
-#endif
-    write_frame= page;
-  }
-
-  if ((s & LRU_MASK) == REINIT || !space->use_doublewrite())
-  {
-    if (UNIV_LIKELY(space->purpose == FIL_TYPE_TABLESPACE))
-    {
-      const lsn_t lsn=
-        mach_read_from_8(my_assume_aligned<8>(FIL_PAGE_LSN +
-                                              (write_frame ? write_frame
-                                               : frame)));
-      ut_ad(lsn >= oldest_modification());
-      log_write_up_to(lsn, true);
-    }
-    if (UNIV_LIKELY(space->purpose != FIL_TYPE_TEMPORARY))
-      buf_dblwr.add_unbuffered();
-    space->io(IORequest{type, this, slot}, physical_offset(), size,
-              write_frame, this);
-  }
+  if (buf_page_needs_encrypt(*space, id()))
+    buf_flush_crypt.submit({this, space, type, s});
   else
-    buf_dblwr.add_to_batch(IORequest{this, slot, space->chain.start, type},
-                           size);
+    buf_flush_write(this, space, type, s);
   return true;
 }
 
@@ -478,6 +478,55 @@ void buf_read_page_background(fil_space_t *space, const page_id_t page_id,
   can ignore these in our heuristics. */
 }
 
+/** Issue asynchronous read requests for a run of consecutive pages,
+skipping those that already exist in the buffer pool. This is used by
+the buffer pool load, which submits the sorted dump in runs so that
+adjacent requests reach the I/O subsystem back to back.
+@param space     tablespace; the caller must hold a reference
+@param first     first page of the run
+@param n         number of consecutive pages
+@param zip_size  ROW_FORMAT=COMPRESSED page size, or 0
+@return number of page read requests issued */
+ulint buf_read_pages_background(fil_space_t *space, page_id_t first,
+                                uint32_t n, ulint zip_size)
+{
+  buf_block_t *block= nullptr;
+  if (UNIV_LIKELY(!zip_size))
+  {
+  allocate_block:
+    if (UNIV_UNLIKELY(!(block= buf_read_acquire())))
+      return 0;
+  }
+  else if (recv_recovery_is_on())
+  {
+    zip_size|= 1;
+    goto allocate_block;
+  }
+
+  ulint count= 0;
+
+  for (const page_id_t end= first + n; first < end; ++first)
+  {
+    if (space->is_stopping())
+      break;
+    buf_pool_t::hash_chain &chain= buf_pool.page_hash.cell_get(first.fold());
+    if (buf_pool.page_hash_contains(first, chain))
+      continue;
+    space->reacquire();
+    if (buf_read_page_low(first, zip_size, chain, space, block) == DB_SUCCESS)
+      count++;
+    if (!block && (UNIV_LIKELY(!zip_size) || (zip_size & 1)) &&
+        UNIV_UNLIKELY(!(block= buf_read_acquire())))
+      break;
+  }
+
+  buf_read_release(block);
+
+  /* Like buf_read_page_background(), we do not invoke
+  buf_LRU_stat_inc_io() for these deliberate reads. */
+  return count;
+}
+
 /** Applies linear read-ahead if in the buf_pool the page is a border page of
 a linear read-ahead area and all the pages in the area have been accessed.
 Does not read any page if the read-ahead mechanism is not activated. Note
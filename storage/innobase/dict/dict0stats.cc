@@ -1072,7 +1072,7 @@ btr_record_not_null_field_in_rec(
 	}
 }
 
-inline dberr_t
+dberr_t
 btr_cur_t::open_random_leaf(rec_offs *&offsets, mem_heap_t *&heap, mtr_t &mtr)
 {
   ut_ad(!index()->is_spatial());
@@ -38,8 +38,29 @@ Full Text Search interface
 #include "dict0stats.h"
 #include "btr0pcur.h"
 
+/** The words of one FTS index that are being written by a SYNC */
+struct fts_sync_index_t {
+        /** The FTS index */
+        dict_index_t    *index;
+        /** The charset of the index */
+        CHARSET_INFO    *charset;
+        /** The words, sorted by text */
+        fts_tokenizer_word_t *words;
+        /** Number of elements in words */
+        ulint           n_words;
+        /** Insert query graphs */
+        que_t           *ins_graph[FTS_NUM_AUX_INDEX];
+};
+
 /** The SYNC state of the cache. There is one instance of this struct
-associated with each ADD thread. */
+associated with each ADD thread.
+
+A SYNC freezes the contents of the cache into sorted arrays of words
+(one fts_sync_index_t for each index) while holding fts_cache_t::lock,
+and then releases the lock while writing the frozen words to the FTS
+auxiliary INDEX tables. Meanwhile, new documents are added to a fresh
+cache. If the SYNC fails, the frozen words will be written by the next
+SYNC. */
 struct fts_sync_t {
         /** Transaction used for SYNCing the cache to disk */
         trx_t   *trx;
@@ -52,6 +73,23 @@ struct fts_sync_t {
         doc_id_t        max_doc_id;
         /** SYNC start time; only used if fts_enable_diag_print */
         time_t          start_time;
+        /** Whether a SYNC is writing the frozen words;
+        protected by fts_cache_t::lock */
+        bool            in_progress;
+        /** Signalled when in_progress is reset */
+        pthread_cond_t  cond;
+        /** Memory heap of the frozen words and deleted_doc_ids,
+        or NULL if nothing is frozen; protected by fts_cache_t::lock */
+        mem_heap_t      *heap;
+        /** The frozen words of each FTS index, allocated from heap */
+        fts_sync_index_t *indexes;
+        /** Number of elements in indexes */
+        ulint           n_indexes;
+        /** The frozen deleted doc ids, or NULL;
+        protected by fts_cache_t::deleted_lock */
+        ib_vector_t     *deleted_doc_ids;
+        /** max_doc_id at the time the words were frozen */
+        doc_id_t        sync_doc_id;
 };
 
 static const ulint FTS_MAX_ID_LEN = 32;
@@ -201,8 +239,9 @@ struct fts_tokenize_param_t {
 /** Run SYNC on the table, i.e., write out data from the cache to the
 FTS auxiliary INDEX table and clear the cache at the end.
 @param[in,out]	sync		sync state
+@param[in]	wait		whether wait when a sync is in progress
 @return DB_SUCCESS if all OK */
-static dberr_t fts_sync(fts_sync_t *sync);
+static dberr_t fts_sync(fts_sync_t *sync, bool wait);
 
 /****************************************************************//**
 Release all resources help by the words rb tree e.g., the node ilist. */
@@ -275,6 +314,7 @@ fts_cache_destroy(fts_cache_t* cache)
 	mysql_mutex_destroy(&cache->init_lock);
 	mysql_mutex_destroy(&cache->deleted_lock);
 	mysql_mutex_destroy(&cache->doc_id_lock);
+	pthread_cond_destroy(&cache->sync->cond);
 
 	if (cache->stopword_info.cached_stopword) {
 		rbt_free(cache->stopword_info.cached_stopword);
@@ -559,8 +599,6 @@ fts_index_cache_init(
 	ib_alloc_t*		allocator,	/*!< in: the allocator to use */
 	fts_index_cache_t*	index_cache)	/*!< in: index cache */
 {
-	ulint			i;
-
 	ut_a(index_cache->words == NULL);
 
 	index_cache->words = rbt_create_arg_cmp(
@@ -571,10 +609,6 @@ fts_index_cache_init(
 
 	index_cache->doc_stats = ib_vector_create(
 		allocator, sizeof(fts_doc_stats_t), 4);
-
-	for (i = 0; i < FTS_NUM_AUX_INDEX; ++i) {
-		ut_a(index_cache->ins_graph[i] == NULL);
-	}
 }
 
 /*********************************************************************//**
@@ -643,6 +677,7 @@ fts_cache_create(
 		mem_heap_zalloc(heap, sizeof(fts_sync_t)));
 
 	cache->sync->table = table;
+	pthread_cond_init(&cache->sync->cond, nullptr);
 
 	/* Create the index cache vector that will hold the inverted indexes. */
 	cache->indexes = ib_vector_create(
@@ -830,6 +865,47 @@ void fts_clear_all(dict_table_t *table)
   DICT_TF2_FLAG_UNSET(table, DICT_TF2_FTS);
 }
 
+/** Discard the frozen words of an index that is being dropped,
+so that a SYNC that retries a failed one does not access the index.
+@param[in,out]	cache	fts cache
+@param[in]	index	FTS index */
+static
+void
+fts_sync_drop_index(
+	fts_cache_t*		cache,
+	const dict_index_t*	index)
+{
+	fts_sync_t*	sync = cache->sync;
+
+	mysql_mutex_assert_owner(&cache->lock);
+	ut_ad(!sync->in_progress);
+
+	for (ulint i = 0; i < sync->n_indexes; ++i) {
+		fts_sync_index_t*	s = &sync->indexes[i];
+
+		if (s->index != index) {
+			continue;
+		}
+
+		for (ulint w = 0; w < s->n_words; ++w) {
+			ib_vector_t*	nodes = s->words[w].nodes;
+
+			for (ulint j = 0; j < ib_vector_size(nodes); ++j) {
+				ut_free(static_cast<fts_node_t*>(
+						ib_vector_get(nodes, j))->ilist);
+			}
+		}
+
+		ut_ad(!s->ins_graph[0]);
+
+		/* The words were allocated from sync->heap, which is
+		freed by fts_sync_free(). */
+		memmove(s, s + 1, (sync->n_indexes - i - 1) * sizeof *s);
+		sync->n_indexes--;
+		return;
+	}
+}
+
 /*******************************************************************//**
 Drop auxiliary tables related to an FTS index
 @return DB_SUCCESS or error number */
@@ -884,6 +960,14 @@ fts_drop_index(
 		}
 
 		mysql_mutex_unlock(&cache->init_lock);
+
+		mysql_mutex_lock(&cache->lock);
+		while (cache->sync->in_progress) {
+			my_cond_wait(&cache->sync->cond,
+				     &cache->lock.m_mutex);
+		}
+		fts_sync_drop_index(cache, index);
+		mysql_mutex_unlock(&cache->lock);
 	}
 
 	err = fts_drop_index_tables(trx, *index);
@@ -941,7 +1025,6 @@ fts_cache_index_cache_create(
 	dict_table_t*		table,		/*!< in: table with FTS index */
 	dict_index_t*		index)		/*!< in: FTS index */
 {
-	ulint			n_bytes;
 	fts_index_cache_t*	index_cache;
 	fts_cache_t*		cache = table->fts->cache;
 
@@ -961,12 +1044,6 @@ fts_cache_index_cache_create(
 
 	index_cache->charset = fts_index_get_charset(index);
 
-	n_bytes = sizeof(que_t*) * FTS_NUM_AUX_INDEX;
-
-	index_cache->ins_graph = static_cast<que_t**>(
-		mem_heap_zalloc(static_cast<mem_heap_t*>(
-			cache->self_heap->arg), n_bytes));
-
 	fts_index_cache_init(cache->sync_heap, index_cache);
 
 	if (cache->get_docs) {
@@ -1011,6 +1088,56 @@ fts_words_free(
 	}
 }
 
+/** Free the words that were frozen by a SYNC.
+@param[in,out]	cache	fts cache */
+static
+void
+fts_sync_free(
+	fts_cache_t*	cache)
+{
+	fts_sync_t*	sync = cache->sync;
+
+	ut_ad(!sync->in_progress);
+
+	if (!sync->heap) {
+		return;
+	}
+
+	for (ulint i = 0; i < sync->n_indexes; ++i) {
+		const fts_sync_index_t*	s = &sync->indexes[i];
+
+		for (ulint w = 0; w < s->n_words; ++w) {
+			ib_vector_t*	nodes = s->words[w].nodes;
+
+			for (ulint j = 0; j < ib_vector_size(nodes); ++j) {
+				ut_free(static_cast<fts_node_t*>(
+						ib_vector_get(nodes, j))->ilist);
+			}
+		}
+
+		ut_ad(!s->ins_graph[0]);
+	}
+
+	for (ulint i = 0; i < ib_vector_size(cache->indexes); ++i) {
+		fts_index_cache_t*	index_cache;
+
+		index_cache = static_cast<fts_index_cache_t*>(
+			ib_vector_get(cache->indexes, i));
+
+		index_cache->sync_words = NULL;
+		index_cache->n_sync_words = 0;
+	}
+
+	mysql_mutex_lock(&cache->deleted_lock);
+	sync->deleted_doc_ids = NULL;
+	mysql_mutex_unlock(&cache->deleted_lock);
+
+	mem_heap_free(sync->heap);
+	sync->heap = NULL;
+	sync->indexes = NULL;
+	sync->n_indexes = 0;
+}
+
 /** Clear cache.
 @param[in,out]	cache	fts cache */
 void
@@ -1019,8 +1146,9 @@ fts_cache_clear(
 {
 	ulint		i;
 
+	ut_ad(!cache->sync->in_progress);
+
 	for (i = 0; i < ib_vector_size(cache->indexes); ++i) {
-		ulint			j;
 		fts_index_cache_t*	index_cache;
 
 		index_cache = static_cast<fts_index_cache_t*>(
@@ -1032,19 +1160,11 @@ fts_cache_clear(
 
 		index_cache->words = NULL;
 
-		for (j = 0; j < FTS_NUM_AUX_INDEX; ++j) {
-
-			if (index_cache->ins_graph[j] != NULL) {
-
-				que_graph_free(index_cache->ins_graph[j]);
-
-				index_cache->ins_graph[j] = NULL;
-			}
-		}
-
 		index_cache->doc_stats = NULL;
 	}
 
+	fts_sync_free(cache);
+
 	fts_need_sync = false;
 
 	cache->total_size = 0;
@@ -1150,8 +1270,10 @@ fts_tokenizer_word_get(
 
 		heap = static_cast<mem_heap_t*>(cache->sync_heap->arg);
 
+		/* Most words will only get one node before the next
+		SYNC; the vector will grow on demand. */
 		new_word.nodes = ib_vector_create(
-			cache->sync_heap, sizeof(fts_node_t), 4);
+			cache->sync_heap, sizeof(fts_node_t), 1);
 
 		fts_string_dup(&new_word.text, text, heap);
 
@@ -1162,7 +1284,7 @@ fts_tokenizer_word_get(
 		cache->total_size += sizeof(new_word)
 			+ sizeof(ib_rbt_node_t)
 			+ text->f_len
-			+ (sizeof(fts_node_t) * 4)
+			+ sizeof(fts_node_t)
 			+ sizeof(*new_word.nodes);
 
 		ut_ad(rbt_validate(index_cache->words));
@@ -3319,7 +3441,7 @@ fts_add_doc_from_tuple(
 
                        if (cache->total_size > fts_max_cache_size / 5
                            || fts_need_sync) {
-                               fts_sync(cache->sync);
+                               fts_sync(cache->sync, false);
                        }
 
                        mtr_start(&mtr);
@@ -3512,7 +3634,7 @@ fts_add_doc_by_id(
 
 				DBUG_EXECUTE_IF(
 					"fts_instrument_sync_debug",
-					fts_sync(cache->sync);
+					fts_sync(cache->sync, true);
 				);
 
 				DEBUG_SYNC_C("fts_instrument_sync_request");
@@ -3548,7 +3670,7 @@ fts_add_doc_by_id(
 	mem_heap_free(heap);
 
 	if (need_sync) {
-		fts_sync_table(table);
+		fts_sync_table(table, false);
 	}
 }
 
@@ -3852,7 +3974,8 @@ dberr_t
 fts_sync_add_deleted_cache(
 /*=======================*/
 	fts_sync_t*	sync,			/*!< in: sync state */
-	ib_vector_t*	doc_ids)		/*!< in: doc ids to add */
+	const ib_vector_t*
+			doc_ids)		/*!< in: sorted doc ids to add */
 {
 	ulint		i;
 	pars_info_t*	info;
@@ -3865,8 +3988,6 @@ fts_sync_add_deleted_cache(
 
 	ut_a(ib_vector_size(doc_ids) > 0);
 
-	ib_vector_sort(doc_ids, fts_doc_id_cmp);
-
 	info = pars_info_create();
 
 	fts_bind_doc_id(info, "doc_id", &dummy);
@@ -3883,10 +4004,11 @@ fts_sync_add_deleted_cache(
 		"BEGIN INSERT INTO $table_name VALUES (:doc_id);");
 
 	for (i = 0; i < n_elems && error == DB_SUCCESS; ++i) {
-		doc_id_t*	update;
+		const doc_id_t*	update;
 		doc_id_t	write_doc_id;
 
-		update = static_cast<doc_id_t*>(ib_vector_get(doc_ids, i));
+		update = static_cast<const doc_id_t*>(
+			ib_vector_get_const(doc_ids, i));
 
 		/* Convert to "storage" byte order. */
 		fts_write_doc_id((byte*) &write_doc_id, *update);
@@ -3900,40 +4022,25 @@ fts_sync_add_deleted_cache(
 	return(error);
 }
 
-/** Write the words and ilist to disk.
+/** Write the frozen words and ilist of an index to disk.
 @param[in,out]	trx		transaction
-@param[in]	index_cache	index cache
-@param[in]	unlock_cache	whether unlock cache when write node
+@param[in,out]	s		frozen words of the index
 @return DB_SUCCESS if all went well else error code */
 static MY_ATTRIBUTE((nonnull, warn_unused_result))
 dberr_t
 fts_sync_write_words(
 	trx_t*			trx,
-	fts_index_cache_t*	index_cache)
+	fts_sync_index_t*	s)
 {
 	fts_table_t	fts_table;
 	ulint		n_nodes = 0;
-	ulint		n_words = 0;
-	const ib_rbt_node_t* rbt_node;
 	dberr_t		error = DB_SUCCESS;
-	dict_table_t*	table = index_cache->index->table;
-
-	FTS_INIT_INDEX_TABLE(
-		&fts_table, NULL, FTS_INDEX_TABLE, index_cache->index);
-
-	n_words = rbt_size(index_cache->words);
 
-	/* We iterate over the entire tree, even if there is an error,
-	since we want to free the memory used during caching. */
-	for (rbt_node = rbt_first(index_cache->words);
-	     rbt_node;
-	     rbt_node = rbt_next(index_cache->words, rbt_node)) {
+	FTS_INIT_INDEX_TABLE(&fts_table, NULL, FTS_INDEX_TABLE, s->index);
 
-		ulint			i;
+	for (ulint w = 0; w < s->n_words; ++w) {
 		ulint			selected;
-		fts_tokenizer_word_t*	word;
-
-		word = rbt_value(fts_tokenizer_word_t, rbt_node);
+		fts_tokenizer_word_t*	word = &s->words[w];
 
 		DBUG_EXECUTE_IF(
 			"fts_instrument_write_words_before_select_index",
@@ -3941,18 +4048,17 @@ fts_sync_write_words(
 				std::chrono::milliseconds(300)););
 
 		selected = fts_select_index(
-			index_cache->charset, word->text.f_str,
-			word->text.f_len);
+			s->charset, word->text.f_str, word->text.f_len);
 
 		fts_table.suffix = fts_get_suffix(selected);
 
-		for (i = 0; i < ib_vector_size(word->nodes); ++i) {
+		for (ulint i = 0; i < ib_vector_size(word->nodes); ++i) {
 
 			fts_node_t* fts_node = static_cast<fts_node_t*>(
 				ib_vector_get(word->nodes, i));
 
 			error = fts_write_node(
-				trx, &index_cache->ins_graph[selected],
+				trx, &s->ins_graph[selected],
 				&fts_table, &word->text, fts_node);
 
 			DEBUG_SYNC_C("fts_write_node");
@@ -3974,19 +4080,89 @@ fts_sync_write_words(
 err_exit:
 			ib::error() << "(" << error << ") writing"
 				" word node to FTS auxiliary index table "
-				<< table->name;
+				<< s->index->table->name;
 			break;
 		}
 	}
 
 	if (UNIV_UNLIKELY(fts_enable_diag_print)) {
 		printf("Avg number of nodes: %lf\n",
-		       (double) n_nodes / (double) (n_words > 1 ? n_words : 1));
+		       (double) n_nodes
+		       / (double) (s->n_words > 1 ? s->n_words : 1));
 	}
 
 	return(error);
 }
 
+/** Freeze the contents of the cache for writing by a SYNC, and start
+an empty cache for the documents that are added meanwhile.
+@param[in,out]	cache	fts cache */
+static
+void
+fts_sync_freeze(
+	fts_cache_t*	cache)
+{
+	fts_sync_t*	sync = cache->sync;
+	mem_heap_t*	heap = static_cast<mem_heap_t*>(cache->sync_heap->arg);
+
+	mysql_mutex_assert_owner(&cache->lock);
+	ut_ad(!sync->heap);
+	ut_ad(!sync->in_progress);
+
+	sync->n_indexes = ib_vector_size(cache->indexes);
+	sync->indexes = static_cast<fts_sync_index_t*>(
+		mem_heap_zalloc(heap, (sync->n_indexes + 1)
+				* sizeof *sync->indexes));
+
+	for (ulint i = 0; i < sync->n_indexes; ++i) {
+		fts_index_cache_t*	index_cache;
+		fts_sync_index_t*	s = &sync->indexes[i];
+
+		index_cache = static_cast<fts_index_cache_t*>(
+			ib_vector_get(cache->indexes, i));
+
+		s->index = index_cache->index;
+		s->charset = index_cache->charset;
+		s->n_words = rbt_size(index_cache->words);
+		s->words = static_cast<fts_tokenizer_word_t*>(
+			mem_heap_alloc(heap, (s->n_words + 1)
+				       * sizeof *s->words));
+
+		fts_tokenizer_word_t*	word = s->words;
+
+		for (const ib_rbt_node_t* node
+			     = rbt_first(index_cache->words);
+		     node; node = rbt_next(index_cache->words, node)) {
+			*word++ = *rbt_value(fts_tokenizer_word_t, node);
+		}
+
+		ut_ad(word == s->words + s->n_words);
+
+		/* The text and the nodes of the words were allocated
+		from heap; only the tree itself is to be freed here. */
+		rbt_free(index_cache->words);
+		index_cache->words = NULL;
+		index_cache->doc_stats = NULL;
+
+		index_cache->sync_words = s->words;
+		index_cache->n_sync_words = s->n_words;
+	}
+
+	sync->heap = heap;
+	sync->sync_doc_id = sync->max_doc_id;
+	cache->sync_heap->arg = NULL;
+
+	mysql_mutex_lock(&cache->deleted_lock);
+	sync->deleted_doc_ids = cache->deleted_doc_ids;
+	cache->deleted_doc_ids = NULL;
+	ib_vector_sort(sync->deleted_doc_ids, fts_doc_id_cmp);
+	mysql_mutex_unlock(&cache->deleted_lock);
+
+	fts_need_sync = false;
+
+	fts_cache_init(cache);
+}
+
 /*********************************************************************//**
 Begin Sync, create transaction, acquire locks, etc. */
 static
@@ -4014,57 +4190,65 @@ fts_sync_begin(
 }
 
 /*********************************************************************//**
-Run SYNC on the table, i.e., write out data from the index specific
-cache to the FTS aux INDEX table and FTS aux doc id stats table.
+Run SYNC on the table, i.e., write out the frozen words of an index
+to the FTS aux INDEX table.
 @return DB_SUCCESS if all OK */
 static MY_ATTRIBUTE((nonnull, warn_unused_result))
 dberr_t
 fts_sync_index(
 /*===========*/
 	fts_sync_t*		sync,		/*!< in: sync state */
-	fts_index_cache_t*	index_cache)	/*!< in: index cache */
+	fts_sync_index_t*	s)		/*!< in/out: frozen words */
 {
 	trx_t*		trx = sync->trx;
 
 	trx->op_info = "doing SYNC index";
 
 	if (UNIV_UNLIKELY(fts_enable_diag_print)) {
-		ib::info() << "SYNC words: " << rbt_size(index_cache->words);
+		ib::info() << "SYNC words: " << s->n_words;
 	}
 
-	ut_ad(rbt_validate(index_cache->words));
-
-	return(fts_sync_write_words(trx, index_cache));
+	return(fts_sync_write_words(trx, s));
 }
 
-/** Rollback a sync operation
+/** Mark the end of writing the frozen words.
 @param[in,out]	sync	sync state */
 static
 void
-fts_sync_rollback(
+fts_sync_end(
 	fts_sync_t*	sync)
 {
-	trx_t*		trx = sync->trx;
-	fts_cache_t*	cache = sync->table->fts->cache;
-
-	for (ulint i = 0; i < ib_vector_size(cache->indexes); ++i) {
-		ulint			j;
-		fts_index_cache_t*	index_cache;
+	mysql_mutex_assert_owner(&sync->table->fts->cache->lock);
+	ut_ad(sync->in_progress);
 
-		index_cache = static_cast<fts_index_cache_t*>(
-			ib_vector_get(cache->indexes, i));
-
-		for (j = 0; fts_index_selector[j].value; ++j) {
+	for (ulint i = 0; i < sync->n_indexes; ++i) {
+		fts_sync_index_t*	s = &sync->indexes[i];
 
-			if (index_cache->ins_graph[j] != NULL) {
-
-				que_graph_free(index_cache->ins_graph[j]);
-
-				index_cache->ins_graph[j] = NULL;
+		for (ulint j = 0; j < FTS_NUM_AUX_INDEX; ++j) {
+			if (s->ins_graph[j] != NULL) {
+				que_graph_free(s->ins_graph[j]);
+				s->ins_graph[j] = NULL;
 			}
 		}
 	}
 
+	sync->in_progress = false;
+	pthread_cond_broadcast(&sync->cond);
+}
+
+/** Rollback a sync operation. The frozen words will be written
+by the next SYNC.
+@param[in,out]	sync	sync state */
+static
+void
+fts_sync_rollback(
+	fts_sync_t*	sync)
+{
+	trx_t*		trx = sync->trx;
+	fts_cache_t*	cache = sync->table->fts->cache;
+
+	mysql_mutex_lock(&cache->lock);
+	fts_sync_end(sync);
 	mysql_mutex_unlock(&cache->lock);
 
 	fts_sql_rollback(trx);
@@ -4091,26 +4275,25 @@ fts_sync_commit(
 
 	/* After each Sync, update the CONFIG table about the max doc id
 	we just sync-ed to index table */
-	error = fts_cmp_set_sync_doc_id(sync->table, sync->max_doc_id, FALSE,
+	error = fts_cmp_set_sync_doc_id(sync->table, sync->sync_doc_id, FALSE,
 					&last_doc_id);
 
-	/* Get the list of deleted documents that are either in the
-	cache or were headed there but were deleted before the add
-	thread got to them. */
+	/* Get the list of deleted documents that were either in the
+	frozen cache or were headed there but were deleted before the add
+	thread got to them. The vector is not modified after the cache
+	was frozen. */
 
-	if (error == DB_SUCCESS && ib_vector_size(cache->deleted_doc_ids) > 0) {
+	if (error == DB_SUCCESS && ib_vector_size(sync->deleted_doc_ids) > 0) {
 
 		error = fts_sync_add_deleted_cache(
-			sync, cache->deleted_doc_ids);
+			sync, sync->deleted_doc_ids);
 	}
 
 	if (UNIV_LIKELY(error == DB_SUCCESS)) {
-		/* We need to do this within the deleted lock
-		since fts_delete() can attempt to add a deleted
-		doc id to the cache deleted id array. */
-		fts_cache_clear(cache);
+		mysql_mutex_lock(&cache->lock);
+		fts_sync_end(sync);
+		fts_sync_free(cache);
 		DEBUG_SYNC_C("fts_deleted_doc_ids_clear");
-		fts_cache_init(cache);
 		mysql_mutex_unlock(&cache->lock);
 		fts_sql_commit(trx);
 	} else {
@@ -4139,25 +4322,39 @@ fts_sync_commit(
 
 /** Run SYNC on the table, i.e., write out data from the cache to the
 FTS auxiliary INDEX table and clear the cache at the end.
+The cache is frozen under fts_cache_t::lock, but the lock is not held
+while the frozen words are being written, so that documents can be
+added to the cache concurrently.
 @param[in,out]	sync		sync state
-@param[in]	unlock_cache	whether unlock cache lock when write node
 @param[in]	wait		whether wait when a sync is in progress
 @return DB_SUCCESS if all OK */
-static dberr_t fts_sync(fts_sync_t *sync)
+static dberr_t fts_sync(fts_sync_t *sync, bool wait)
 {
 	if (srv_read_only_mode) {
 		return DB_READ_ONLY;
 	}
 
-	ulint		i;
 	dberr_t		error = DB_SUCCESS;
 	fts_cache_t*	cache = sync->table->fts->cache;
+	const size_t	fts_cache_size = fts_max_cache_size;
 
 	mysql_mutex_lock(&cache->lock);
+
+	while (sync->in_progress) {
+		if (!wait && cache->total_size <= fts_cache_size) {
+			/* The cache will be written by a subsequent
+			SYNC. Only wait if the cache is growing beyond
+			its limit. */
+			mysql_mutex_unlock(&cache->lock);
+			return DB_SUCCESS;
+		}
+
+		my_cond_wait(&sync->cond, &cache->lock.m_mutex);
+	}
+
 	DEBUG_SYNC_C("fts_sync_begin");
 	fts_sync_begin(sync);
 
-	const size_t fts_cache_size= fts_max_cache_size;
 	if (cache->total_size > fts_cache_size) {
 		/* Avoid the case: sync never finish when
 		insert/update keeps comming. */
@@ -4168,20 +4365,27 @@ static dberr_t fts_sync(fts_sync_t *sync)
 			<< fts_cache_size;
 	}
 
-	for (i = 0; i < ib_vector_size(cache->indexes); ++i) {
-		fts_index_cache_t*	index_cache;
+	/* If a previous SYNC failed, write its frozen words first. */
+	const bool	pending = sync->heap != NULL;
 
-		index_cache = static_cast<fts_index_cache_t*>(
-			ib_vector_get(cache->indexes, i));
+	if (!pending) {
+		fts_sync_freeze(cache);
+	}
+
+	sync->in_progress = true;
+	mysql_mutex_unlock(&cache->lock);
+
+	for (ulint i = 0; i < sync->n_indexes; ++i) {
+		fts_sync_index_t*	s = &sync->indexes[i];
 
-		if (index_cache->index->to_be_dropped) {
+		if (s->index->to_be_dropped) {
 			continue;
 		}
 
 		DBUG_EXECUTE_IF("fts_instrument_sync_before_syncing",
 				std::this_thread::sleep_for(
 					std::chrono::milliseconds(300)););
-		error = fts_sync_index(sync, index_cache);
+		error = fts_sync_index(sync, s);
 
 		if (error != DB_SUCCESS) {
 			goto err_exit;
@@ -4212,6 +4416,12 @@ static dberr_t fts_sync(fts_sync_t *sync)
 
 	mysql_mutex_unlock(&cache->deleted_lock);
 
+	if (pending) {
+		/* Write the documents that were added after the
+		failed SYNC. */
+		return(fts_sync(sync, wait));
+	}
+
 	DEBUG_SYNC_C("fts_sync_end");
 	return(error);
 }
@@ -4221,12 +4431,12 @@ FTS auxiliary INDEX table and clear the cache at the end.
 @param[in,out]	table		fts table
 @param[in]	wait		whether wait for existing sync to finish
 @return DB_SUCCESS on success, error code on failure. */
-dberr_t fts_sync_table(dict_table_t* table)
+dberr_t fts_sync_table(dict_table_t* table, bool wait)
 {
   ut_ad(table->fts);
 
   return table->space && !table->corrupted && table->fts->cache
-    ? fts_sync(table->fts->cache->sync)
+    ? fts_sync(table->fts->cache->sync, wait)
     : DB_SUCCESS;
 }
 
@@ -5003,22 +5213,70 @@ fts_find_index_cache(
 		fts_get_index_cache((fts_cache_t*) cache, index)));
 }
 
-/*********************************************************************//**
-Search cache for word.
+/** Find the first of the words that are being written by a SYNC
+that is not less than a key.
+@param index_cache	cache to search
+@param text		key to search for
+@param cmp		innobase_fts_text_cmp() or
+			innobase_fts_text_cmp_prefix()
+@return position in index_cache->sync_words
+@retval index_cache->n_sync_words if all words are less than text */
+ulint
+fts_cache_sync_words_lower_bound(
+	const fts_index_cache_t*	index_cache,
+	const fts_string_t*		text,
+	ib_rbt_arg_compare		cmp)
+{
+	ulint	low = 0;
+	ulint	high = index_cache->n_sync_words;
+
+	mysql_mutex_assert_owner(&index_cache->index->table->fts->cache->lock);
+
+	while (low < high) {
+		const ulint	mid = low + (high - low) / 2;
+
+		if (cmp(index_cache->charset, text,
+			&index_cache->sync_words[mid].text) > 0) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	return(low);
+}
+
+/** Search cache for word.
+@param index_cache	cache to search
+@param text		word to search for
+@param sync		whether to search the words that are being written
+			by a SYNC, instead of the words of documents that
+			were added after the SYNC started
 @return the word node vector if found else NULL */
 const ib_vector_t*
 fts_cache_find_word(
-/*================*/
-	const fts_index_cache_t*index_cache,	/*!< in: cache to search */
-	const fts_string_t*	text)		/*!< in: word to search for */
+	const fts_index_cache_t*	index_cache,
+	const fts_string_t*		text,
+	bool				sync)
 {
 	ib_rbt_bound_t		parent;
 	const ib_vector_t*	nodes = NULL;
 
 	mysql_mutex_assert_owner(&index_cache->index->table->fts->cache->lock);
 
-	/* Lookup the word in the rb tree */
-	if (rbt_search(index_cache->words, &parent, text) == 0) {
+	if (sync) {
+		/* Binary search the frozen words */
+		ulint	i = fts_cache_sync_words_lower_bound(
+			index_cache, text, innobase_fts_text_cmp);
+
+		if (i < index_cache->n_sync_words
+		    && !innobase_fts_text_cmp(
+			    index_cache->charset, text,
+			    &index_cache->sync_words[i].text)) {
+			nodes = index_cache->sync_words[i].nodes;
+		}
+	} else if (rbt_search(index_cache->words, &parent, text) == 0) {
+		/* Lookup the word in the rb tree */
 		const fts_tokenizer_word_t*	word;
 
 		word = rbt_value(fts_tokenizer_word_t, parent.last);
@@ -5039,13 +5297,15 @@ fts_cache_append_deleted_doc_ids(
 {
   mysql_mutex_lock(&cache->deleted_lock);
 
-  if (cache->deleted_doc_ids)
-    for (ulint i= 0; i < ib_vector_size(cache->deleted_doc_ids); ++i)
-    {
-      doc_id_t *update= static_cast<doc_id_t*>(
-        ib_vector_get(cache->deleted_doc_ids, i));
-      ib_vector_push(vector, &update);
-    }
+  /* Include the doc ids that are being written by a SYNC */
+  for (ib_vector_t *deleted : {cache->sync->deleted_doc_ids,
+                               cache->deleted_doc_ids})
+    if (deleted)
+      for (ulint i= 0; i < ib_vector_size(deleted); ++i)
+      {
+        doc_id_t *update= static_cast<doc_id_t*>(ib_vector_get(deleted, i));
+        ib_vector_push(vector, &update);
+      }
 
   mysql_mutex_unlock(&cache->deleted_lock);
 }
@@ -1009,6 +1009,76 @@ fts_query_check_node(
 	}
 }
 
+/** Check the cached ilists of a word, both in the words that are being
+written by a SYNC and in the words of documents that were added after
+the SYNC started.
+@param[in,out]	query		query to update
+@param[in]	index_cache	index cache
+@param[in]	token		the token to search */
+static
+void
+fts_query_check_cache_word(
+	fts_query_t*			query,
+	const fts_index_cache_t*	index_cache,
+	const fts_string_t*		token)
+{
+	for (bool sync : {true, false}) {
+		const ib_vector_t*	nodes = fts_cache_find_word(
+			index_cache, token, sync);
+
+		for (ulint i = 0; nodes && i < ib_vector_size(nodes)
+		     && query->error == DB_SUCCESS; ++i) {
+			const fts_node_t*	node;
+
+			node = static_cast<const fts_node_t*>(
+				ib_vector_get_const(nodes, i));
+
+			fts_query_check_node(query, token, node);
+		}
+	}
+}
+
+/** Filter the doc ids of a cached word that matched a wildcard search.
+@param[in,out]	query		query instance
+@param[in]	srch_text	the search prefix
+@param[in]	word		cached word
+@return whether the search can continue */
+static
+bool
+fts_cache_filter_wildcard_word(
+	fts_query_t*			query,
+	const fts_string_t*		srch_text,
+	const fts_tokenizer_word_t*	word)
+{
+	const ib_vector_t*	nodes = word->nodes;
+
+	for (ulint i = 0; nodes && i < ib_vector_size(nodes); ++i) {
+		int                     ret;
+		const fts_node_t*       node;
+		ib_rbt_bound_t          freq_parent;
+		fts_word_freq_t*	word_freqs;
+
+		node = static_cast<const fts_node_t*>(
+			ib_vector_get_const(nodes, i));
+
+		ret = rbt_search(query->word_freqs, &freq_parent, srch_text);
+
+		ut_a(ret == 0);
+
+		word_freqs = rbt_value(fts_word_freq_t, freq_parent.last);
+
+		query->error = fts_query_filter_doc_ids(
+			query, srch_text, word_freqs, node,
+			node->ilist, node->ilist_size, TRUE);
+
+		if (query->error != DB_SUCCESS) {
+			return(false);
+		}
+	}
+
+	return(true);
+}
+
 /*****************************************************************//**
 Search index cache for word with wildcard match.
 @return number of words matched */
@@ -1021,7 +1091,6 @@ fts_cache_find_wildcard(
 	const fts_string_t*	token)		/*!< in: token to search */
 {
 	ib_rbt_bound_t		parent;
-	const ib_vector_t*	nodes = NULL;
 	fts_string_t		srch_text;
 	byte			term[FTS_MAX_WORD_LEN + 1];
 	ulint			num_word = 0;
@@ -1034,11 +1103,26 @@ fts_cache_find_wildcard(
 	term[srch_text.f_len] = '\0';
 	srch_text.f_str = term;
 
+	/* Scan the words that are being written by a SYNC */
+	for (ulint i = fts_cache_sync_words_lower_bound(
+		     index_cache, &srch_text, innobase_fts_text_cmp_prefix);
+	     i < index_cache->n_sync_words
+	     && !innobase_fts_text_cmp_prefix(
+		     index_cache->charset, &srch_text,
+		     &index_cache->sync_words[i].text);
+	     i++) {
+		if (!fts_cache_filter_wildcard_word(
+			    query, &srch_text, &index_cache->sync_words[i])) {
+			return(0);
+		}
+
+		num_word++;
+	}
+
 	/* Lookup the word in the rb tree */
 	if (rbt_search_cmp(index_cache->words, &parent, &srch_text, NULL,
 			   innobase_fts_text_cmp_prefix) == 0) {
 		const fts_tokenizer_word_t*     word;
-		ulint				i;
 		const ib_rbt_node_t*		cur_node;
 		ibool				forward = FALSE;
 
@@ -1048,35 +1132,9 @@ fts_cache_find_wildcard(
 		while (innobase_fts_text_cmp_prefix(
 			index_cache->charset, &srch_text, &word->text) == 0) {
 
-			nodes = word->nodes;
-
-			for (i = 0; nodes && i < ib_vector_size(nodes); ++i) {
-				int                     ret;
-				const fts_node_t*       node;
-				ib_rbt_bound_t          freq_parent;
-				fts_word_freq_t*	word_freqs;
-
-				node = static_cast<const fts_node_t*>(
-					ib_vector_get_const(nodes, i));
-
-				ret = rbt_search(query->word_freqs,
-						 &freq_parent,
-						 &srch_text);
-
-				ut_a(ret == 0);
-
-				word_freqs = rbt_value(
-					fts_word_freq_t,
-					freq_parent.last);
-
-				query->error = fts_query_filter_doc_ids(
-					query, &srch_text,
-					word_freqs, node,
-					node->ilist, node->ilist_size, TRUE);
-
-				if (query->error != DB_SUCCESS) {
-					return(0);
-				}
+			if (!fts_cache_filter_wildcard_word(
+				    query, &srch_text, word)) {
+				return(0);
 			}
 
 			num_word++;
@@ -1138,9 +1196,7 @@ fts_query_difference(
 
 	/* There is nothing we can substract from an empty set. */
 	if (query->doc_ids && !rbt_empty(query->doc_ids)) {
-		ulint			i;
 		fts_fetch_t		fetch;
-		const ib_vector_t*	nodes;
 		const fts_index_cache_t*index_cache;
 		que_t*			graph = NULL;
 		fts_cache_t*		cache = table->fts->cache;
@@ -1159,17 +1215,7 @@ fts_query_difference(
 		    && query->flags != FTS_PHRASE) {
 			fts_cache_find_wildcard(query, index_cache, token);
 		} else {
-			nodes = fts_cache_find_word(index_cache, token);
-
-			for (i = 0; nodes && i < ib_vector_size(nodes)
-			     && query->error == DB_SUCCESS; ++i) {
-				const fts_node_t*	node;
-
-				node = static_cast<const fts_node_t*>(
-					ib_vector_get_const(nodes, i));
-
-				fts_query_check_node(query, token, node);
-			}
+			fts_query_check_cache_word(query, index_cache, token);
 		}
 
 		mysql_mutex_unlock(&cache->lock);
@@ -1239,9 +1285,7 @@ fts_query_intersect(
 	we know the intersection set is empty in advance. */
 	if (!(rbt_empty(query->doc_ids) && query->multi_exist)) {
 		ulint                   n_doc_ids = 0;
-		ulint			i;
 		fts_fetch_t		fetch;
-		const ib_vector_t*	nodes;
 		const fts_index_cache_t*index_cache;
 		que_t*			graph = NULL;
 		fts_cache_t*		cache = table->fts->cache;
@@ -1291,17 +1335,7 @@ fts_query_intersect(
 			/* Wildcard search the index cache */
 			fts_cache_find_wildcard(query, index_cache, token);
 		} else {
-			nodes = fts_cache_find_word(index_cache, token);
-
-			for (i = 0; nodes && i < ib_vector_size(nodes)
-			     && query->error == DB_SUCCESS; ++i) {
-				const fts_node_t*	node;
-
-				node = static_cast<const fts_node_t*>(
-					ib_vector_get_const(nodes, i));
-
-				fts_query_check_node(query, token, node);
-			}
+			fts_query_check_cache_word(query, index_cache, token);
 		}
 
 		mysql_mutex_unlock(&cache->lock);
@@ -1375,20 +1409,7 @@ fts_query_cache(
 		/* Wildcard search the index cache */
 		fts_cache_find_wildcard(query, index_cache, token);
 	} else {
-		const ib_vector_t*      nodes;
-		ulint			i;
-
-		nodes = fts_cache_find_word(index_cache, token);
-
-		for (i = 0; nodes && i < ib_vector_size(nodes)
-		     && query->error == DB_SUCCESS; ++i) {
-			const fts_node_t*	node;
-
-			node = static_cast<const fts_node_t*>(
-				ib_vector_get_const(nodes, i));
-
-			fts_query_check_node(query, token, node);
-		}
+		fts_query_check_cache_word(query, index_cache, token);
 	}
 
 	mysql_mutex_unlock(&cache->lock);
@@ -97,6 +97,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "row0log.h"
 #include "row0merge.h"
 #include "row0mysql.h"
+#include "row0pread.h"
 #include "row0quiesce.h"
 #include "row0sel.h"
 #include "row0upd.h"
@@ -1011,6 +1012,9 @@ static SHOW_VAR innodb_status_variables[]= {
   {"onlineddl_pct_progress",
    &export_vars.innodb_onlineddl_pct_progress, SHOW_SIZE_T},
 
+  /* Parallel table scans */
+  {"parallel_scans", &export_vars.innodb_parallel_scans, SHOW_SIZE_T},
+
   /* Encryption */
   {"encryption_rotation_pages_read_from_cache",
    &export_vars.innodb_encryption_rotation_pages_read_from_cache, SHOW_SIZE_T},
@@ -2970,6 +2974,10 @@ ha_innobase::ha_innobase(
 			  |  (srv_force_primary_key ? HA_REQUIRE_PRIMARY_KEY : 0)
 		  ),
 	m_start_of_scan(),
+	m_sample_pages_left(),
+	m_sample_recs_left(),
+	m_sample_heap(),
+	m_pread(),
         m_mysql_has_locked()
 {}
 
@@ -6241,8 +6249,16 @@ ha_innobase::close()
 {
 	DBUG_ENTER("ha_innobase::close");
 
+	delete m_pread;
+	m_pread = NULL;
+
 	row_prebuilt_free(m_prebuilt);
 
+	if (m_sample_heap) {
+		mem_heap_free(m_sample_heap);
+		m_sample_heap = NULL;
+	}
+
 	if (m_upd_buf != NULL) {
 		ut_ad(m_upd_buf_size != 0);
 		my_free(m_upd_buf);
@@ -9360,6 +9376,10 @@ ha_innobase::rnd_init(
 {
 	int		err;
 
+	/* Stop a parallel scan when the scan is restarted */
+	delete m_pread;
+	m_pread = NULL;
+
 	/* Store the active index value so that we can restore the original
 	value after a scan */
 
@@ -9381,6 +9401,66 @@ ha_innobase::rnd_init(
 	return(err);
 }
 
+/** Start a table scan whose rows are read by worker threads in a
+consistent read, see row0pread.h. Only plain consistent reads of the
+stored columns are split; everything else uses rnd_init().
+@param n_threads  maximum number of worker threads
+@return 0, or HA_ERR_WRONG_COMMAND if the scan should be serial */
+int ha_innobase::rnd_init_parallel(uint n_threads)
+{
+	DBUG_ENTER("ha_innobase::rnd_init_parallel");
+
+	dict_table_t*	ib_table = m_prebuilt->table;
+	trx_t*		trx = m_prebuilt->trx;
+
+	if (n_threads < 2
+	    || m_prebuilt->select_lock_type != LOCK_NONE
+	    || trx->isolation_level == TRX_ISO_READ_UNCOMMITTED
+	    || ib_table->is_temporary()
+	    || ib_table->no_rollback()
+	    || !ib_table->is_readable()
+	    || ib_table->n_v_cols
+	    || dict_table_has_fts_index(ib_table)
+	    || pushed_idx_cond || pushed_rowid_filter
+	    || m_prebuilt->used_in_HANDLER) {
+		DBUG_RETURN(HA_ERR_WRONG_COMMAND);
+	}
+
+	/* This builds the template for the clustered index */
+	if (int err = rnd_init(true)) {
+		DBUG_RETURN(err);
+	}
+
+	if (m_prebuilt->templ_contains_blob || m_prebuilt->idx_cond
+	    || m_prebuilt->pk_filter) {
+		DBUG_RETURN(HA_ERR_WRONG_COMMAND);
+	}
+
+	/* Assign the read view, as row_search_mvcc() would */
+	if (m_prebuilt->sql_stat_start) {
+		m_prebuilt->sql_stat_start = false;
+		trx_start_if_not_started(trx, false);
+		trx->read_view.open(trx);
+	}
+
+	if (!trx->read_view.is_open()) {
+		DBUG_RETURN(HA_ERR_WRONG_COMMAND);
+	}
+
+	m_pread = new row_pread_t(m_prebuilt);
+
+	if (m_pread->start(n_threads) != DB_SUCCESS) {
+		/* The index is too small, or the serial scan will
+		report the error */
+		delete m_pread;
+		m_pread = NULL;
+		DBUG_RETURN(HA_ERR_WRONG_COMMAND);
+	}
+
+	srv_stats.n_parallel_scans.inc();
+	DBUG_RETURN(0);
+}
+
 /*****************************************************************//**
 Ends a table scan.
 @return 0 or error number */
@@ -9389,6 +9469,9 @@ int
 ha_innobase::rnd_end(void)
 /*======================*/
 {
+	delete m_pread;
+	m_pread = NULL;
+
 	return(index_end());
 }
 
@@ -9407,6 +9490,22 @@ ha_innobase::rnd_next(
 
 	DBUG_ENTER("rnd_next");
 
+	if (m_pread) {
+		switch (dberr_t ret = m_pread->next(buf)) {
+		case DB_SUCCESS:
+			table->status = 0;
+			DBUG_RETURN(0);
+		case DB_END_OF_INDEX:
+			table->status = STATUS_NOT_FOUND;
+			DBUG_RETURN(HA_ERR_END_OF_FILE);
+		default:
+			table->status = STATUS_NOT_FOUND;
+			DBUG_RETURN(convert_error_code_to_mysql(
+					    ret, m_prebuilt->table->flags,
+					    m_user_thd));
+		}
+	}
+
 	if (m_start_of_scan) {
 		error = index_first(buf);
 
@@ -9422,6 +9521,154 @@ ha_innobase::rnd_next(
 	DBUG_RETURN(error);
 }
 
+/** Initialize block sampling of the clustered index. Each sampled leaf
+page is found by a random descent of the B-tree, as in
+btr_estimate_number_of_different_key_vals(), and its records are then read
+through the normal MVCC path.
+@param fraction  the part of the leaf pages to sample
+@return 0 or error number */
+int ha_innobase::sample_init(double fraction)
+{
+	DBUG_ENTER("ha_innobase::sample_init");
+
+	dict_index_t*	index = dict_table_get_first_index(m_prebuilt->table);
+	ulint		n_leaf_pages = index->stat_n_leaf_pages;
+	ulint		n_sample = ulint(fraction * double(n_leaf_pages));
+
+	/* Without statistics the size of the index is unknown */
+	if (!m_prebuilt->table->stat_initialized
+	    || !m_prebuilt->table->is_readable()
+	    || index->is_corrupted()
+	    || n_sample < HA_SAMPLE_MIN_BLOCKS
+	    || n_sample * 2 >= n_leaf_pages) {
+		DBUG_RETURN(HA_ERR_WRONG_COMMAND);
+	}
+
+	if (int err = rnd_init(true)) {
+		DBUG_RETURN(err);
+	}
+
+	if (!m_sample_heap) {
+		m_sample_heap = mem_heap_create(256);
+	}
+
+	m_sample_pages_left = n_sample;
+	m_sample_recs_left = 0;
+	DBUG_RETURN(0);
+}
+
+/** Read the next row of the block sample.
+@return 0, HA_ERR_END_OF_FILE, or error number */
+int ha_innobase::sample_next(uchar* buf)
+{
+	DBUG_ENTER("ha_innobase::sample_next");
+
+	while (m_sample_recs_left == 0) {
+		if (m_sample_pages_left == 0) {
+			DBUG_RETURN(HA_ERR_END_OF_FILE);
+		}
+
+		m_sample_pages_left--;
+
+		dict_index_t*	index = m_prebuilt->index;
+		ut_ad(index->is_primary());
+
+		mem_heap_empty(m_sample_heap);
+		mem_heap_t*	heap = m_sample_heap;
+		rec_offs*	offsets = NULL;
+		btr_cur_t	cursor;
+		cursor.page_cur.index = index;
+		mtr_t		mtr;
+		mtr.start();
+
+		if (dberr_t err = cursor.open_random_leaf(offsets, heap, mtr)) {
+			mtr.commit();
+			DBUG_RETURN(convert_error_code_to_mysql(
+					    err, m_prebuilt->table->flags,
+					    m_user_thd));
+		}
+
+		rec_t*	rec = page_rec_get_next(cursor.page_cur.rec);
+
+		if (rec && rec_is_metadata(rec, *index)) {
+			rec = page_rec_get_next(rec);
+		}
+
+		if (!rec || !page_rec_is_user_rec(rec)) {
+			/* An empty table has an empty root page */
+			mtr.commit();
+			continue;
+		}
+
+		ulint	n_recs = page_get_n_recs(btr_cur_get_page(&cursor));
+		ulint	n_uniq = dict_index_get_n_unique(index);
+		/* dict_index_build_data_tuple() is only for secondary
+		indexes; this copies the fields into m_sample_heap */
+		dtuple_t* tuple = dtuple_create(m_sample_heap, n_uniq);
+		dict_index_copy_types(tuple, index, n_uniq);
+		rec_copy_prefix_to_dtuple(tuple, rec, index,
+					  index->n_core_fields, n_uniq,
+					  m_sample_heap);
+
+		mtr.commit();
+
+		/* Position the cursor on the first record of the page;
+		the following records are read by general_fetch() */
+		dtuple_t*	search_tuple = m_prebuilt->search_tuple;
+		dtuple_set_n_fields(search_tuple, n_uniq);
+
+		for (ulint i = 0; i < n_uniq; i++) {
+			dfield_copy(dtuple_get_nth_field(search_tuple, i),
+				    dtuple_get_nth_field(tuple, i));
+		}
+
+		if (m_prebuilt->sql_stat_start) {
+			build_template(false);
+		}
+
+		switch (dberr_t ret = row_search_mvcc(buf, PAGE_CUR_GE,
+						      m_prebuilt, 0, 0)) {
+		case DB_SUCCESS:
+			table->status = 0;
+			m_sample_recs_left = n_recs ? n_recs - 1 : 0;
+			m_start_of_scan = false;
+			DBUG_RETURN(0);
+		case DB_RECORD_NOT_FOUND:
+		case DB_END_OF_INDEX:
+			continue;
+		default:
+			table->status = STATUS_NOT_FOUND;
+			DBUG_RETURN(convert_error_code_to_mysql(
+					    ret, m_prebuilt->table->flags,
+					    m_user_thd));
+		}
+	}
+
+	m_sample_recs_left--;
+
+	int	error = general_fetch(buf, ROW_SEL_NEXT, 0);
+
+	if (error == HA_ERR_END_OF_FILE) {
+		/* The last page of the index was sampled */
+		m_sample_recs_left = 0;
+		error = HA_ERR_RECORD_DELETED;
+	}
+
+	DBUG_RETURN(error);
+}
+
+/** End block sampling.
+@return 0 or error number */
+int ha_innobase::sample_end()
+{
+	if (m_sample_heap) {
+		mem_heap_free(m_sample_heap);
+		m_sample_heap = NULL;
+	}
+
+	return rnd_end();
+}
+
 /**********************************************************************//**
 Fetches a row from the table based on a row reference.
 @return 0, HA_ERR_KEY_NOT_FOUND, or error code */
@@ -18797,6 +19044,13 @@ static MYSQL_SYSVAR_BOOL(doublewrite, srv_use_doublewrite_buf,
   " Disable with --skip-innodb-doublewrite.",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_UINT(doublewrite_files, srv_doublewrite_files,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of files in innodb_data_home_dir for the doublewrite buffer,"
+  " allowing multiple page flush batches to be written concurrently."
+  " 0 (the default) uses the doublewrite buffer in the system tablespace.",
+  NULL, NULL, 0, 0, buf_dblwr_t::MAX_FILES, 0);
+
 static MYSQL_SYSVAR_BOOL(use_atomic_writes, srv_use_atomic_writes,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
   "Enable atomic writes, instead of using the doublewrite buffer, for files "
@@ -19752,6 +20006,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(temp_data_file_path),
   MYSQL_SYSVAR(data_home_dir),
   MYSQL_SYSVAR(doublewrite),
+  MYSQL_SYSVAR(doublewrite_files),
   MYSQL_SYSVAR(stats_include_delete_marked),
   MYSQL_SYSVAR(use_atomic_writes),
   MYSQL_SYSVAR(fast_shutdown),
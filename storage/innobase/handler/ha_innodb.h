@@ -32,6 +32,9 @@ extern const char innobase_index_reserve_name[];
 /** Prebuilt structures in an InnoDB table handle used within MySQL */
 struct row_prebuilt_t;
 
+/** Parallel scan of a clustered index */
+class row_pread_t;
+
 /** InnoDB transaction */
 struct trx_t;
 
@@ -151,10 +154,18 @@ class ha_innobase final : public handler
 				uint rec_length);
 	int rnd_init(bool scan) override;
 
+	int rnd_init_parallel(uint n_threads) override;
+
 	int rnd_end() override;
 
 	int rnd_next(uchar *buf) override;
 
+	int sample_init(double fraction) override;
+
+	int sample_next(uchar *buf) override;
+
+	int sample_end() override;
+
 	int rnd_pos(uchar * buf, uchar *pos) override;
 
 	int ft_init() override;
@@ -516,6 +527,18 @@ class ha_innobase final : public handler
 	not yet fetched any row, else false */
 	bool			m_start_of_scan;
 
+	/** number of leaf pages still to be sampled by sample_next() */
+	ulint			m_sample_pages_left;
+
+	/** number of records left on the current sample page */
+	ulint			m_sample_recs_left;
+
+	/** memory for the search tuple of the current sample page */
+	mem_heap_t*		m_sample_heap;
+
+	/** the parallel scan started by rnd_init_parallel(), or NULL */
+	row_pread_t*		m_pread;
+
 	/*!< match mode of the latest search: ROW_SEL_EXACT,
 	ROW_SEL_EXACT_PREFIX, or undefined */
 	uint			m_last_match_mode;
@@ -2461,13 +2461,21 @@ i_s_fts_index_cache_fill_one_index(
 
 	int	ret = 0;
 
-	/* Go through each word in the index cache */
-	for (rbt_node = rbt_first(index_cache->words);
-	     rbt_node;
-	     rbt_node = rbt_next(index_cache->words, rbt_node)) {
-		fts_tokenizer_word_t* word;
-
-		word = rbt_value(fts_tokenizer_word_t, rbt_node);
+	/* Go through each word in the index cache: first the words that
+	are being written by a SYNC, then the words added after it */
+	rbt_node = rbt_first(index_cache->words);
+
+	for (ulint n = 0;; n++) {
+		const fts_tokenizer_word_t* word;
+
+		if (n < index_cache->n_sync_words) {
+			word = &index_cache->sync_words[n];
+		} else if (rbt_node) {
+			word = rbt_value(fts_tokenizer_word_t, rbt_node);
+			rbt_node = rbt_next(index_cache->words, rbt_node);
+		} else {
+			break;
+		}
 
 		/* Convert word from index charset to system_charset_info */
 		if (index_charset->cset != system_charset_info->cset) {
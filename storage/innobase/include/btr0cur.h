@@ -751,8 +751,8 @@ struct btr_cur_t {
   @param heap      memory heap for rec_get_offsets()
   @param mtr       mini-transaction
   @return error code */
-  inline dberr_t open_random_leaf(rec_offs *&offsets, mem_heap_t *& heap,
-                                  mtr_t &mtr);
+  dberr_t open_random_leaf(rec_offs *&offsets, mem_heap_t *& heap,
+                           mtr_t &mtr);
 };
 
 /** Modify the delete-mark flag of a record.
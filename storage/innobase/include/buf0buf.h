@@ -459,8 +459,9 @@ directory (buf) to see it. Do not use from outside! */
 
 class buf_tmp_buffer_t
 {
-  /** whether this slot is reserved */
-  std::atomic<bool> reserved;
+  friend buf_pool_t;
+  /** index of the next slot in buf_pool_t::io_buf_t::free_head */
+  std::atomic<uint32_t> next_free;
 public:
   /** For encryption, the data needs to be copied to a separate buffer
   before it's encrypted&written. The buffer block itself can be replaced
@@ -473,11 +474,7 @@ class buf_tmp_buffer_t
   byte *out_buf;
 
   /** Release the slot */
-  void release() { reserved.store(false, std::memory_order_relaxed); }
-
-  /** Acquire the slot
-  @return whether the slot was acquired */
-  bool acquire() { return !reserved.exchange(true, std::memory_order_relaxed);}
+  inline void release();
 
   /** Allocate a buffer for encryption, decryption or decompression. */
   void allocate()
@@ -1775,6 +1772,8 @@ class buf_pool_t
 
   /** Reserve a buffer. */
   buf_tmp_buffer_t *io_buf_reserve() { return io_buf.reserve(); }
+  /** Release a buffer that was returned by io_buf_reserve(). */
+  void io_buf_release(buf_tmp_buffer_t *slot) { io_buf.release(slot); }
 
   /** @return whether any I/O is pending */
   bool any_io_pending()
@@ -1815,13 +1814,29 @@ class buf_pool_t
     ulint n_slots;
     /** array of slots */
     buf_tmp_buffer_t *slots;
+    /** lock-free stack of free slots: the index of the first free
+    slot (or FIL_NULL) in the low 32 bits, and a counter against
+    the ABA problem in the high 32 bits */
+    std::atomic<uint64_t> free_head;
+    /** number of threads waiting in reserve() */
+    std::atomic<uint32_t> n_waiting;
+    /** protects waiting for a free slot */
+    mysql_mutex_t mutex;
+    /** signalled when a slot is released while n_waiting!=0 */
+    pthread_cond_t released;
 
     void create(ulint n_slots);
 
     void close();
 
-    /** Reserve a buffer */
+    /** Reserve a buffer, waiting for one to be released if needed */
     buf_tmp_buffer_t *reserve();
+    /** Release a buffer */
+    void release(buf_tmp_buffer_t *slot);
+  private:
+    /** @return a free slot
+    @retval nullptr if all slots are reserved */
+    buf_tmp_buffer_t *pop();
   } io_buf;
 
   /** whether resize() is in the critical path */
@@ -1831,6 +1846,8 @@ class buf_pool_t
 /** The InnoDB buffer pool */
 extern buf_pool_t buf_pool;
 
+inline void buf_tmp_buffer_t::release() { buf_pool.io_buf_release(this); }
+
 inline buf_page_t *buf_pool_t::page_hash_table::get(const page_id_t id,
                                                     const hash_chain &chain)
   const
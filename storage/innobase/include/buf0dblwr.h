@@ -29,9 +29,27 @@ Created 2011/12/19 Inaam Rana
 #include "os0file.h"
 #include "buf0types.h"
 
-/** Doublewrite control struct */
+/** Doublewrite control struct.
+
+The doublewrite copies of a batch of page writes are written to one of
+two kinds of storage, which is chosen at startup:
+
+(1) The two doublewrite blocks in the system tablespace (the default).
+There is only one such area, so at most one batch can be in flight.
+
+(2) innodb_doublewrite_files separate files ib_doublewrite0, ...
+in innodb_data_home_dir, each holding one batch. A batch is written
+and made durable in its own file by a thread pool task, so that
+several batches can be in flight concurrently. With a single file,
+there are still two memory slots sharing it, and at most one batch
+is in flight. */
 class buf_dblwr_t
 {
+public:
+  /** Maximum value of innodb_doublewrite_files */
+  static constexpr uint MAX_FILES= 64;
+
+private:
   struct element
   {
     /** asynchronous write request */
@@ -40,6 +58,15 @@ class buf_dblwr_t
     size_t size;
   };
 
+  /** a page write of a batch */
+  struct page_write
+  {
+    /** the page */
+    const buf_page_t *bpage;
+    /** whether the write has completed */
+    bool done;
+  };
+
   struct slot
   {
     /** first free position in write_buf measured in units of
@@ -51,6 +78,20 @@ class buf_dblwr_t
     byte* write_buf;
     /** buffer blocks to be written via write_buf */
     element* buf_block_arr;
+    /** buf_block_arr[].request.bpage in ascending order, for finding
+    the slot of a completed page write. A page whose write has completed
+    may be written again in another batch before this batch ends. */
+    page_write* bpages;
+    /** the doublewrite file of this slot, or OS_FILE_CLOSED if
+    the batch is written to the system tablespace */
+    pfs_os_file_t file;
+    /** whether the batch is being written to the doublewrite storage */
+    bool flushing;
+    /** whether the pages of the batch are being written to the data files */
+    bool writing;
+
+    /** @return whether the slot is part of a batch that is in flight */
+    bool in_flight() const { return flushing || writing; }
   };
 
   /** the page number of the first doublewrite block (block_size() pages) */
@@ -60,10 +101,11 @@ class buf_dblwr_t
 
   /** mutex protecting the data members below */
   mysql_mutex_t mutex;
-  /** condition variable for !batch_running */
+  /** condition variable for a slot becoming available, or for
+  !batches_running */
   pthread_cond_t cond;
-  /** whether a batch is being written from the doublewrite buffer */
-  bool batch_running;
+  /** number of batches being written from the doublewrite buffer */
+  ulint batches_running;
   /** number of expected flush_buffered_writes_completed() calls */
   unsigned flushing_buffered_writes;
   /** pages submitted to flush_buffered_writes() */
@@ -77,16 +119,49 @@ class buf_dblwr_t
   /** number of pending page writes */
   size_t writes_pending;
 
-  slot slots[2];
+  /** number of elements in slots[] */
+  uint n_slots;
+  /** number of doublewrite files; slots[i] uses file i % n_files */
+  uint n_files;
+  slot slots[MAX_FILES];
   slot *active_slot;
 
+  /** copies of the doublewrite files that were read on startup
+  for recovery, or nullptr */
+  byte *recv_buf;
+
   /** Initialise the persistent storage of the doublewrite buffer.
   @param header   doublewrite page header in the TRX_SYS page */
   inline void init(const byte *header);
 
+  /** Open or create the doublewrite files.
+  @return whether innodb_doublewrite_files are being used */
+  bool open_files();
+
+  /** Read the doublewrite files for recovery. */
+  void load_files();
+
   /** Flush possible buffered writes to persistent storage. */
   bool flush_buffered_writes(const ulint size);
 
+  /** Write the pages of a batch whose doublewrite copies are durable.
+  @param flush_slot  the batch */
+  void write_pages(slot *flush_slot);
+
+  /** Write a batch to its doublewrite file and then write the pages.
+  @param flush_slot  the batch */
+  static void write_file(void *flush_slot);
+
+  /** @return a slot that can be made the active slot, or nullptr */
+  slot *find_free_slot()
+  {
+    mysql_mutex_assert_owner(&mutex);
+    for (uint i= 0; i < n_slots; i++)
+      if (slots + i != active_slot && !slots[i].in_flight())
+        return slots + i;
+    return nullptr;
+  }
+
 public:
   /** Initialise the doublewrite buffer data structures. */
   void init();
@@ -123,8 +198,10 @@ class buf_dblwr_t
   /** Process and remove the double write buffer pages for all tablespaces. */
   void recover();
 
-  /** Update the doublewrite buffer on data page write completion. */
-  void write_completed(bool with_doublewrite);
+  /** Update the doublewrite buffer on data page write completion.
+  @param bpage             the page that was written
+  @param with_doublewrite  whether the page was written via add_to_batch() */
+  void write_completed(const buf_page_t *bpage, bool with_doublewrite);
   /** Flush possible buffered writes to persistent storage.
   It is very important to call this function after a batch of writes has been
   posted, and also when we may have to wait for a page latch!
@@ -163,7 +240,7 @@ class buf_dblwr_t
   void wait_flush_buffered_writes()
   {
     mysql_mutex_lock(&mutex);
-    while (batch_running)
+    while (batches_running)
       my_cond_wait(&cond, &mutex.m_mutex);
     mysql_mutex_unlock(&mutex);
   }
@@ -94,6 +94,10 @@ after releasing buf_pool.mutex.
 @retval 0 if a buf_pool.LRU batch is already running */
 ulint buf_flush_LRU(ulint max_n, bool evict);
 
+/** Wait for the pages that are being encrypted or page_compressed
+in the background to be submitted for writing. */
+void buf_flush_wait_encrypted();
+
 /** Wait until a LRU flush batch ends. */
 void buf_flush_wait_LRU_batch_end();
 /** Wait until all persistent pages are flushed up to a limit.
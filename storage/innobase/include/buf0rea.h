@@ -55,6 +55,17 @@ void buf_read_page_background(fil_space_t *space, const page_id_t page_id,
                               ulint zip_size)
   MY_ATTRIBUTE((nonnull));
 
+/** Issue asynchronous read requests for a run of consecutive pages,
+skipping those that already exist in the buffer pool.
+@param space     tablespace; the caller must hold a reference
+@param first     first page of the run
+@param n         number of consecutive pages
+@param zip_size  ROW_FORMAT=COMPRESSED page size, or 0
+@return number of page read requests issued */
+ulint buf_read_pages_background(fil_space_t *space, page_id_t first,
+                                uint32_t n, ulint zip_size)
+  MY_ATTRIBUTE((nonnull));
+
 /** Applies a random read-ahead in buf_pool if there are at least a threshold
 value of accessed pages from the random read-ahead area. Does not read any
 page, not even the one at the position (space, offset), if the read-ahead
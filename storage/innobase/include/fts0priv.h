@@ -397,16 +397,33 @@ fts_config_get_ulint(
 	const char*	name,		/*!< in: param name */
 	ulint*		int_value)	/*!< out: value */
 	MY_ATTRIBUTE((nonnull));
-/******************************************************************//**
-Search cache for word.
+/** Search cache for word.
+@param index_cache	cache to search
+@param text		word to search for
+@param sync		whether to search the words that are being written
+			by a SYNC, instead of the words of documents that
+			were added after the SYNC started
 @return the word node vector if found else NULL */
 const ib_vector_t*
 fts_cache_find_word(
-/*================*/
-	const fts_index_cache_t*
-			index_cache,	/*!< in: cache to search */
-	const fts_string_t*
-			text)		/*!< in: word to search for */
+	const fts_index_cache_t*	index_cache,
+	const fts_string_t*		text,
+	bool				sync)
+	MY_ATTRIBUTE((nonnull, warn_unused_result));
+
+/** Find the first of the words that are being written by a SYNC
+that is not less than a key.
+@param index_cache	cache to search
+@param text		key to search for
+@param cmp		innobase_fts_text_cmp() or
+			innobase_fts_text_cmp_prefix()
+@return position in index_cache->sync_words
+@retval index_cache->n_sync_words if all words are less than text */
+ulint
+fts_cache_sync_words_lower_bound(
+	const fts_index_cache_t*	index_cache,
+	const fts_string_t*		text,
+	ib_rbt_arg_compare		cmp)
 	MY_ATTRIBUTE((nonnull, warn_unused_result));
 
 /******************************************************************//**
@@ -36,6 +36,7 @@ Created 2007-03-27 Sunny Bains
 /** Types used within FTS. */
 struct fts_que_t;
 struct fts_node_t;
+struct fts_tokenizer_word_t;
 
 /** Callbacks used within FTS. */
 typedef pars_user_func_cb_t fts_sql_callback;
@@ -66,6 +67,16 @@ struct fts_index_cache_t {
 	ib_rbt_t*	words;		/*!< Nodes; indexed by fts_string_t*,
 					cells are fts_tokenizer_word_t*.*/
 
+	const fts_tokenizer_word_t*
+			sync_words;	/*!< Words that are being written to
+					the INDEX table by a SYNC, sorted by
+					text, or NULL. Meanwhile, new documents
+					are added to words. Protected by
+					fts_cache_t::lock. */
+
+	ulint		n_sync_words;	/*!< Number of elements in
+					sync_words */
+
 	ib_vector_t*	doc_stats;	/*!< Array of the fts_doc_stats_t
 					contained in the memory buffer.
 					Must be in sorted order (ascending).
@@ -73,8 +84,6 @@ struct fts_index_cache_t {
 					the rb tree imposes a space overhead
 					that we can do without */
 
-	que_t**		ins_graph;	/*!< Insert query graphs */
-
 	CHARSET_INFO*	charset;	/*!< charset */
 };
 
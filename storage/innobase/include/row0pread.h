@@ -0,0 +1,152 @@
+/*****************************************************************************
+
+Copyright (c) 2026, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file include/row0pread.h
+Parallel scan of a clustered index
+
+The clustered index is split into key ranges at the node pointers of a
+non-leaf level. Worker tasks in srv_thread_pool read the ranges in a
+consistent read of the transaction, convert the rows to the MySQL format
+and pass them in chunks to the thread that executes the query, which
+returns them from ha_innobase::rnd_next() in no particular order. The
+thread pool bounds the number of workers of all the concurrent scans.
+*******************************************************/
+
+#pragma once
+
+#include "row0types.h"
+#include "data0types.h"
+#include "rem0types.h"
+#include "mem0mem.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <tpool.h>
+
+struct row_prebuilt_t;
+
+/** Receiver of the rows of row_search_pread_range() */
+struct row_pread_sink_t
+{
+  virtual ~row_pread_sink_t()= default;
+  /** @return buffer for the next row, in the MySQL format */
+  virtual byte *row_buf()= 0;
+  /** Account for the row that was stored in row_buf().
+  @param rec  the clustered index record version of the row
+  @return whether flush() must be invoked before the next row */
+  virtual bool add(const rec_t *rec)= 0;
+  /** Hand over the rows; invoked without holding any page latch.
+  @return whether the scan should continue */
+  virtual bool flush()= 0;
+};
+
+/** Parallel scan of the clustered index of a table */
+class row_pread_t
+{
+public:
+  /** Number of ranges per thread, so that threads that are done with
+  a small range can pick up more work */
+  static constexpr ulint RANGES_PER_THREAD= 4;
+  /** Number of rows in a chunk */
+  static constexpr ulint CHUNK_ROWS= 256;
+  /** Number of filled chunks per thread that may wait for the consumer */
+  static constexpr ulint CHUNKS_PER_THREAD= 4;
+
+  /** Constructor.
+  @param prebuilt  prebuilt struct of the table handle, with the template
+                   built for the clustered index and an open read view */
+  explicit row_pread_t(row_prebuilt_t *prebuilt);
+  /** Stop the worker tasks and wait for them to finish */
+  ~row_pread_t();
+
+  /** Split the index and submit the worker tasks.
+  @param n_threads  maximum number of worker tasks
+  @return error code
+  @retval DB_END_OF_INDEX if the index is too small to be split */
+  dberr_t start(ulint n_threads);
+
+  /** Read the next row.
+  @param buf  buffer for the row in the MySQL format
+  @return error code
+  @retval DB_END_OF_INDEX after the last row */
+  dberr_t next(byte *buf);
+
+private:
+  /** A batch of rows */
+  struct chunk_t
+  {
+    std::unique_ptr<byte[]> rows;
+    /** number of rows in rows */
+    ulint n_rows= 0;
+    /** number of rows returned by next() */
+    ulint n_read= 0;
+  };
+
+  /** Pick the keys at which the index is split.
+  @param n_ranges  desired number of ranges */
+  dberr_t split(ulint n_ranges);
+  /** Body of a worker task */
+  void worker();
+  /** Callback of m_task */
+  static void worker_task(void *scan)
+  { static_cast<row_pread_t*>(scan)->worker(); }
+  /** Queue a filled chunk.
+  @param c  the chunk; replaced with an empty one
+  @return whether the scan should continue */
+  bool publish(std::unique_ptr<chunk_t> &c);
+  /** @return an empty chunk */
+  std::unique_ptr<chunk_t> get_chunk();
+
+  /** prebuilt struct of the table handle */
+  row_prebuilt_t *const m_prebuilt;
+  /** length of a row in a chunk */
+  const ulint m_row_len;
+  /** memory for m_splits */
+  mem_heap_t *m_heap;
+  /** the keys at which the index is split */
+  std::vector<const dtuple_t*> m_splits;
+  /** the next range to be read by a worker */
+  std::atomic<ulint> m_next_range{0};
+  /** the worker task, submitted once for each worker */
+  tpool::waitable_task m_task;
+
+  /** protects the following members */
+  std::mutex m_mutex;
+  /** signalled when a chunk was queued or a worker exited */
+  std::condition_variable m_produced;
+  /** signalled when a chunk was consumed or the scan was aborted */
+  std::condition_variable m_consumed;
+  /** filled chunks */
+  std::vector<std::unique_ptr<chunk_t>> m_full;
+  /** chunks that can be reused */
+  std::vector<std::unique_ptr<chunk_t>> m_free;
+  /** maximum size of m_full */
+  ulint m_max_full= 0;
+  /** number of worker tasks that have not finished */
+  ulint m_running= 0;
+  /** first error of a worker task */
+  dberr_t m_error= DB_SUCCESS;
+  /** whether the workers should stop */
+  bool m_abort= false;
+
+  /** the chunk that next() is returning rows from */
+  std::unique_ptr<chunk_t> m_current;
+};
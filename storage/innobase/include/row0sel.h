@@ -178,6 +178,21 @@ current read view.
 dberr_t row_check_index(row_prebuilt_t *prebuilt, ulint *n_rows)
   MY_ATTRIBUTE((nonnull, warn_unused_result));
 
+struct row_pread_sink_t;
+
+/** Read the rows of a clustered index key range in a consistent read,
+for a parallel table scan.
+@param prebuilt  prebuilt struct of the worker thread, with a template for
+                 the clustered index and the read view of the transaction
+@param start     first key of the range, or nullptr for the start of the index
+@param end       key that ends the range (not included), or nullptr
+@param sink      receiver of the rows
+@return error code */
+dberr_t row_search_pread_range(row_prebuilt_t *prebuilt,
+                               const dtuple_t *start, const dtuple_t *end,
+                               row_pread_sink_t &sink)
+  MY_ATTRIBUTE((nonnull(1), warn_unused_result));
+
 /** Read the max AUTOINC value from an index.
 @param[in] index	index starting with an AUTO_INCREMENT column
 @return	the largest AUTO_INCREMENT value
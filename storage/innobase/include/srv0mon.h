@@ -295,6 +295,18 @@ enum monitor_id_t {
 	MONITOR_OVLD_LOG_WAITS,
 	MONITOR_OVLD_LOG_WRITE_REQUEST,
 	MONITOR_OVLD_LOG_WRITES,
+	MONITOR_LOG_WRITE_AHEAD,
+	/* Latency histograms; the buckets must follow the total time */
+	MONITOR_LOG_WRITE_TIME,
+	MONITOR_LOG_WRITE_LT_100US,
+	MONITOR_LOG_WRITE_LT_1MS,
+	MONITOR_LOG_WRITE_LT_10MS,
+	MONITOR_LOG_WRITE_GE_10MS,
+	MONITOR_LOG_FLUSH_TIME,
+	MONITOR_LOG_FLUSH_LT_100US,
+	MONITOR_LOG_FLUSH_LT_1MS,
+	MONITOR_LOG_FLUSH_LT_10MS,
+	MONITOR_LOG_FLUSH_GE_10MS,
 
 	/* Page Manager related counters */
 	MONITOR_MODULE_PAGE,
@@ -119,6 +119,9 @@ struct srv_stats_t
 
 	/** Number of temporary tablespace blocks decrypted */
 	ulint_ctr_n_t		n_temp_blocks_decrypted;
+
+	/** Number of table scans that were split over worker tasks */
+	ulint_ctr_n_t		n_parallel_scans;
 };
 
 /** We are prepared for a situation that we have this many threads waiting for
@@ -311,6 +314,9 @@ extern unsigned long long	srv_stats_modified_counter;
 extern my_bool			srv_stats_sample_traditional;
 
 extern my_bool	srv_use_doublewrite_buf;
+/** innodb_doublewrite_files: number of doublewrite files, or 0 to
+use the doublewrite buffer in the system tablespace */
+extern uint	srv_doublewrite_files;
 extern ulong	srv_checksum_algorithm;
 
 extern my_bool	srv_force_primary_key;
@@ -658,6 +664,8 @@ struct export_var_t{
 						of used row log buffer */
 	ulint innodb_onlineddl_pct_progress;	/*!< Online alter progress */
 
+	ulint innodb_parallel_scans;		/*!< Parallel table scans */
+
 	int64_t innodb_page_compression_saved;/*!< Number of bytes saved
 						by page compression */
 	int64_t innodb_pages_page_compressed;/*!< Number of pages
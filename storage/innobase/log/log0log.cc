@@ -789,6 +789,19 @@ ATTRIBUTE_COLD void log_t::resize_write_buf(size_t length) noexcept
                           resize_flush_buf, offset, length) == DB_SUCCESS);
 }
 
+/** Account for the latency of a log write or flush in INNODB_METRICS.
+@param monitor  MONITOR_LOG_WRITE_TIME or MONITOR_LOG_FLUSH_TIME
+@param start    microsecond_interval_timer() at the start of the operation */
+static void log_latency(monitor_id_t monitor, ulonglong start)
+{
+  const ulonglong us{microsecond_interval_timer() - start};
+  MONITOR_INC_VALUE(monitor, us);
+  /* The histogram buckets follow the total time counter. */
+  const monitor_id_t bucket{monitor_id_t(monitor + 1 + (us >= 100) +
+                                         (us >= 1000) + (us >= 10000))};
+  MONITOR_INC(bucket);
+}
+
 /** Write buf to ib_logfile0.
 @tparam release_latch whether to invoke latch.wr_unlock()
 @return the current log sequence number */
@@ -863,11 +876,15 @@ template<bool release_latch> inline lsn_t log_t::write_buf() noexcept
                                      "InnoDB log write: " LSN_PF, write_lsn);
     }
 
+    const ulonglong start{MONITOR_IS_ON(MONITOR_LOG_WRITE_TIME)
+                          ? microsecond_interval_timer() : 0};
     /* Do the write to the log file */
     log_write_buf(write_buf, length, offset);
     if (UNIV_LIKELY_NULL(resize_buf))
       resize_write_buf(length);
     write_lsn= lsn;
+    if (start)
+      log_latency(MONITOR_LOG_WRITE_TIME, start);
   }
 
   return lsn;
@@ -877,7 +894,15 @@ bool log_t::flush(lsn_t lsn) noexcept
 {
   ut_ad(lsn >= get_flushed_lsn());
   flush_lock.set_pending(lsn);
-  const bool success{log_write_through || log.flush()};
+  bool success= log_write_through;
+  if (!success)
+  {
+    const ulonglong start{MONITOR_IS_ON(MONITOR_LOG_FLUSH_TIME)
+                          ? microsecond_interval_timer() : 0};
+    success= log.flush();
+    if (start)
+      log_latency(MONITOR_LOG_FLUSH_TIME, start);
+  }
   if (UNIV_LIKELY(success))
   {
     flushed_to_disk_lsn.store(lsn, std::memory_order_release);
@@ -993,14 +1018,37 @@ ATTRIBUTE_COLD void log_write_and_flush()
 #endif
 }
 
+/** whether log_write_ahead_task has been submitted and not started yet */
+static std::atomic<bool> log_write_ahead_submitted;
+
+/** Write the log buffer in the background. */
+static void log_write_ahead(void*)
+{
+  log_write_ahead_submitted.store(false, std::memory_order_relaxed);
+  log_buffer_flush_to_disk(false);
+}
+/** task for log_write_ahead() */
+static tpool::waitable_task log_write_ahead_task{log_write_ahead, nullptr};
+
 /********************************************************************
 
 Tries to establish a big enough margin of free space in the log buffer, such
-that a new log entry can be catenated without an immediate need for a flush. */
+that a new log entry can be catenated without an immediate need for a flush.
+The write is normally submitted to a background task, so that the caller
+can continue; log_t::append_prepare() will wait if the buffer fills up
+before the write completes. */
 ATTRIBUTE_COLD static void log_flush_margin()
 {
-  if (log_sys.buf_free > log_sys.max_buf_free)
+  if (log_sys.buf_free <= log_sys.max_buf_free)
+    return;
+  if (!srv_thread_pool)
     log_buffer_flush_to_disk(false);
+  else if (!log_write_ahead_submitted.exchange(true,
+                                               std::memory_order_relaxed))
+  {
+    MONITOR_ATOMIC_INC(MONITOR_LOG_WRITE_AHEAD);
+    srv_thread_pool->submit_task(&log_write_ahead_task);
+  }
 }
 
 /****************************************************************//**
@@ -1271,6 +1319,7 @@ void log_t::close()
 {
   ut_ad(this == &log_sys);
   if (!is_initialised()) return;
+  log_write_ahead_task.wait();
   close_file();
 
 #ifndef HAVE_PMEM
@@ -52,6 +52,7 @@ Created 10/21/1995 Heikki Tuuri
 #include "unistd.h"
 #endif
 #include "buf0dblwr.h"
+#include "buf0flu.h"
 
 #include <tpool_structs.h>
 
@@ -3703,6 +3704,7 @@ static void os_aio_wait_until_no_pending_writes_low()
 /** Wait until there are no pending asynchronous writes. */
 void os_aio_wait_until_no_pending_writes()
 {
+  buf_flush_wait_encrypted();
   os_aio_wait_until_no_pending_writes_low();
   buf_dblwr.wait_flush_buffered_writes();
 }
@@ -0,0 +1,332 @@
+/*****************************************************************************
+
+Copyright (c) 2026, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file row/row0pread.cc
+Parallel scan of a clustered index
+*******************************************************/
+
+#include "row0pread.h"
+#include "row0sel.h"
+#include "row0mysql.h"
+#include "btr0btr.h"
+#include "dict0dict.h"
+#include "page0page.h"
+#include "rem0rec.h"
+#include "my_sys.h"
+#include "srv0srv.h"
+
+row_pread_t::row_pread_t(row_prebuilt_t *prebuilt)
+  : m_prebuilt(prebuilt),
+    m_row_len(prebuilt->mysql_prefix_len +
+              (prebuilt->clust_index_was_generated ? DATA_ROW_ID_LEN : 0)),
+    m_heap(mem_heap_create(1024)),
+    m_task(worker_task, this)
+{
+  ut_ad(prebuilt->index->is_primary());
+}
+
+row_pread_t::~row_pread_t()
+{
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_abort= true;
+  }
+  m_consumed.notify_all();
+
+  m_task.wait();
+
+  mem_heap_free(m_heap);
+}
+
+/** Pick the keys at which the index is split. The tree is descended
+level by level from the root until a level has at least n_ranges node
+pointers, or down to the level above the leaves. The split keys are evenly
+spaced node pointers of that level.
+@param n_ranges  desired number of ranges
+@return error code
+@retval DB_END_OF_INDEX if the index cannot be split */
+dberr_t row_pread_t::split(ulint n_ranges)
+{
+  dict_index_t *index= m_prebuilt->index;
+  const ulint n_uniq= dict_index_get_n_unique(index);
+  mem_heap_t *heap= nullptr;
+  rec_offs *offsets= nullptr;
+  std::vector<uint32_t> pages{index->page};
+  std::vector<const rec_t*> node_ptrs;
+  dberr_t err= DB_SUCCESS;
+  mtr_t mtr;
+  mtr.start();
+  mtr_s_lock_index(index, &mtr);
+
+  if (index->page == FIL_NULL)
+  {
+    err= DB_CORRUPTION;
+    goto func_exit;
+  }
+
+  for (;;)
+  {
+    std::vector<uint32_t> children;
+    node_ptrs.clear();
+
+    for (const uint32_t page_no : pages)
+    {
+      const buf_block_t *block=
+        btr_block_get(*index, page_no, RW_S_LATCH, &mtr, &err);
+      if (!block)
+        goto func_exit;
+
+      const page_t *page= block->page.frame;
+      if (page_is_leaf(page))
+      {
+        /* The whole index fits in the root page */
+        err= DB_END_OF_INDEX;
+        goto func_exit;
+      }
+
+      const bool last_level= btr_page_get_level(page) == 1;
+
+      for (const rec_t *rec=
+             page_rec_get_next_const(page_get_infimum_rec(page));
+           rec && page_rec_is_user_rec(rec);
+           rec= page_rec_get_next_const(rec))
+      {
+        node_ptrs.push_back(rec);
+        if (!last_level)
+        {
+          offsets= rec_get_offsets(rec, index, offsets, 0, ULINT_UNDEFINED,
+                                   &heap);
+          children.push_back(btr_node_ptr_get_child_page_no(rec, offsets));
+        }
+      }
+    }
+
+    if (node_ptrs.size() >= n_ranges || children.empty())
+      break;
+    pages.swap(children);
+  }
+
+  n_ranges= std::min<ulint>(n_ranges, node_ptrs.size());
+
+  if (n_ranges < 2)
+  {
+    err= DB_END_OF_INDEX;
+    goto func_exit;
+  }
+
+  /* The first node pointer of a level carries the minimum record flag,
+  and it would start the first range anyway */
+  for (ulint i= 1; i < n_ranges; i++)
+  {
+    const rec_t *rec= node_ptrs[i * node_ptrs.size() / n_ranges];
+    dtuple_t *tuple= dtuple_create(m_heap, n_uniq);
+    dict_index_copy_types(tuple, index, n_uniq);
+    rec_copy_prefix_to_dtuple(tuple, rec, index, 0, n_uniq, m_heap);
+    dtuple_set_info_bits(tuple, 0);
+    m_splits.push_back(tuple);
+  }
+
+func_exit:
+  mtr.commit();
+  if (heap)
+    mem_heap_free(heap);
+  return err;
+}
+
+/** Split the index and submit the worker tasks.
+@param n_threads  maximum number of worker tasks
+@return error code
+@retval DB_END_OF_INDEX if the index is too small to be split */
+dberr_t row_pread_t::start(ulint n_threads)
+{
+  if (dberr_t err= split(n_threads * RANGES_PER_THREAD))
+    return err;
+
+  n_threads= std::min<ulint>(n_threads, m_splits.size() + 1);
+  m_max_full= n_threads * CHUNKS_PER_THREAD;
+  m_running= n_threads;
+
+  for (ulint i= 0; i < n_threads; i++)
+    srv_thread_pool->submit_task(&m_task);
+
+  return DB_SUCCESS;
+}
+
+/** @return an empty chunk; the caller must hold m_mutex */
+std::unique_ptr<row_pread_t::chunk_t> row_pread_t::get_chunk()
+{
+  std::unique_ptr<chunk_t> c;
+
+  if (!m_free.empty())
+  {
+    c= std::move(m_free.back());
+    m_free.pop_back();
+  }
+  else
+  {
+    c.reset(new chunk_t);
+    c->rows.reset(new byte[CHUNK_ROWS * m_row_len]());
+  }
+
+  return c;
+}
+
+/** Queue a filled chunk, waiting while too many chunks are queued.
+@param c  the chunk; replaced with an empty one
+@return whether the scan should continue */
+bool row_pread_t::publish(std::unique_ptr<chunk_t> &c)
+{
+  std::unique_lock<std::mutex> lk(m_mutex);
+
+  if (!m_abort && m_full.size() >= m_max_full)
+  {
+    /* Let the thread pool run other tasks while the consumer is behind */
+    tpool::tpool_wait_begin();
+    do
+      m_consumed.wait(lk);
+    while (!m_abort && m_full.size() >= m_max_full);
+    tpool::tpool_wait_end();
+  }
+
+  if (m_abort)
+    return false;
+
+  if (c->n_rows)
+  {
+    m_full.push_back(std::move(c));
+    m_produced.notify_one();
+    c= get_chunk();
+  }
+
+  return true;
+}
+
+/** Body of a worker task: read ranges until all have been read */
+void row_pread_t::worker()
+{
+  /* The template and the read view of the transaction are shared with
+  the other threads; the memory heaps for building rows are private. */
+  row_prebuilt_t prebuilt= *m_prebuilt;
+  prebuilt.old_vers_heap= nullptr;
+  prebuilt.blob_heap= nullptr;
+
+  class sink_t final : public row_pread_sink_t
+  {
+    row_pread_t &m_scan;
+  public:
+    std::unique_ptr<chunk_t> m_chunk;
+    bool m_stopped= false;
+
+    explicit sink_t(row_pread_t &scan) : m_scan(scan)
+    {
+      std::lock_guard<std::mutex> lk(scan.m_mutex);
+      m_chunk= scan.get_chunk();
+    }
+
+    byte *row_buf() override
+    { return &m_chunk->rows[m_chunk->n_rows * m_scan.m_row_len]; }
+
+    bool add(const rec_t *rec) override
+    {
+      if (m_scan.m_prebuilt->clust_index_was_generated)
+        /* DB_ROW_ID is the first field of the clustered index */
+        memcpy(row_buf() + m_scan.m_prebuilt->mysql_prefix_len, rec,
+               DATA_ROW_ID_LEN);
+      return ++m_chunk->n_rows == CHUNK_ROWS;
+    }
+
+    bool flush() override
+    {
+      m_stopped= !m_scan.publish(m_chunk);
+      return !m_stopped;
+    }
+  } sink(*this);
+
+  dberr_t err= DB_SUCCESS;
+
+  for (ulint r; !sink.m_stopped && (r= m_next_range++) <= m_splits.size(); )
+  {
+    err= row_search_pread_range(&prebuilt, r ? m_splits[r - 1] : nullptr,
+                                r < m_splits.size() ? m_splits[r] : nullptr,
+                                sink);
+    if (err != DB_SUCCESS)
+      break;
+  }
+
+  if (err == DB_SUCCESS && !sink.m_stopped)
+    sink.flush();
+
+  if (prebuilt.old_vers_heap)
+    mem_heap_free(prebuilt.old_vers_heap);
+  if (prebuilt.blob_heap)
+    mem_heap_free(prebuilt.blob_heap);
+
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (err != DB_SUCCESS && m_error == DB_SUCCESS)
+    {
+      m_error= err;
+      m_abort= true;
+      m_consumed.notify_all();
+    }
+    m_running--;
+  }
+
+  m_produced.notify_one();
+}
+
+/** Read the next row.
+@param buf  buffer for the row in the MySQL format
+@return error code
+@retval DB_END_OF_INDEX after the last row */
+dberr_t row_pread_t::next(byte *buf)
+{
+  for (;;)
+  {
+    if (m_current && m_current->n_read < m_current->n_rows)
+    {
+      const byte *row= &m_current->rows[m_current->n_read++ * m_row_len];
+      memcpy(buf, row, m_prebuilt->mysql_prefix_len);
+      if (m_prebuilt->clust_index_was_generated)
+        memcpy(m_prebuilt->row_id, row + m_prebuilt->mysql_prefix_len,
+               DATA_ROW_ID_LEN);
+      return DB_SUCCESS;
+    }
+
+    std::unique_lock<std::mutex> lk(m_mutex);
+
+    if (m_current)
+    {
+      m_current->n_rows= m_current->n_read= 0;
+      m_free.push_back(std::move(m_current));
+    }
+
+    while (m_full.empty() && m_running && m_error == DB_SUCCESS)
+      m_produced.wait(lk);
+
+    if (m_error != DB_SUCCESS)
+      return m_error;
+    if (m_full.empty())
+      return DB_END_OF_INDEX;
+
+    m_current= std::move(m_full.back());
+    m_full.pop_back();
+    m_consumed.notify_one();
+  }
+}
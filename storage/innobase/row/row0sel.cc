@@ -53,6 +53,7 @@ Created 12/19/1997 Heikki Tuuri
 #include "pars0sym.h"
 #include "pars0pars.h"
 #include "row0mysql.h"
+#include "row0pread.h"
 #include "buf0lru.h"
 #include "srv0srv.h"
 #include "srv0mon.h"
@@ -6950,3 +6951,117 @@ row_search_max_autoinc(dict_index_t* index)
 	mtr.commit();
 	return(value);
 }
+
+/** Read the rows of a clustered index key range for a parallel scan.
+@see row_pread_t */
+dberr_t row_search_pread_range(row_prebuilt_t *prebuilt,
+                               const dtuple_t *start, const dtuple_t *end,
+                               row_pread_sink_t &sink)
+{
+  dict_index_t *index= prebuilt->index;
+  trx_t *trx= prebuilt->trx;
+  ut_ad(index->is_primary());
+  ut_ad(!prebuilt->templ_contains_blob);
+  ut_ad(trx->read_view.is_open());
+
+  if (const trx_id_t bulk_trx_id= index->table->bulk_trx_id)
+    if (!trx->read_view.changes_visible(bulk_trx_id))
+      return DB_SUCCESS;
+
+  const bool comp= index->table->not_redundant();
+  rec_offs offsets_[REC_OFFS_NORMAL_SIZE];
+  rec_offs_init(offsets_);
+  rec_offs *offsets= offsets_;
+  mem_heap_t *heap= nullptr;
+  btr_pcur_t pcur;
+  pcur.btr_cur.page_cur.index= index;
+  mtr_t mtr;
+  mtr.start();
+
+  dberr_t err= start
+    ? btr_pcur_open_with_no_init(start, PAGE_CUR_GE, BTR_SEARCH_LEAF,
+                                 &pcur, &mtr)
+    : pcur.open_leaf(true, index, BTR_SEARCH_LEAF, &mtr);
+  /* After PAGE_CUR_GE the cursor is on the first record of the range;
+  after open_leaf() or restore_position() it is before it. */
+  bool on_rec= start != nullptr;
+
+  while (err == DB_SUCCESS)
+  {
+    if (on_rec)
+      on_rec= false;
+    else if (!btr_pcur_is_after_last_on_page(&pcur))
+    {
+      if (!btr_pcur_move_to_next_on_page(&pcur))
+      {
+        err= DB_CORRUPTION;
+        break;
+      }
+    }
+    else if (btr_pcur_is_after_last_in_tree(&pcur))
+      break;
+    else
+    {
+      err= btr_pcur_move_to_next_page(&pcur, &mtr);
+      if (err == DB_SUCCESS && trx_is_interrupted(trx))
+        err= DB_INTERRUPTED;
+      continue;
+    }
+
+    const rec_t *rec= btr_pcur_get_rec(&pcur);
+
+    if (!page_rec_is_user_rec(rec) || rec_is_metadata(rec, *index))
+      continue;
+
+    offsets= rec_get_offsets(rec, index, offsets, index->n_core_fields,
+                             ULINT_UNDEFINED, &heap);
+
+    if (end && cmp_dtuple_rec(end, rec, index, offsets) <= 0)
+      break;
+
+    err= row_sel_clust_sees(rec, *index, offsets, trx->read_view);
+
+    if (err == DB_SUCCESS_LOCKED_REC)
+    {
+      rec_t *old_vers;
+      err= row_sel_build_prev_vers_for_mysql(prebuilt, index, rec, &offsets,
+                                             &heap, &old_vers, nullptr, &mtr);
+      if (err != DB_SUCCESS)
+        break;
+      if (!old_vers)
+        continue;
+      rec= old_vers;
+    }
+    else if (err != DB_SUCCESS)
+      break;
+
+    /* Only fresh inserts may contain incomplete externally stored
+    columns; like row_search_mvcc() pretend that they do not exist. */
+    if (rec_get_deleted_flag(rec, comp) ||
+        !row_sel_store_mysql_rec(sink.row_buf(), prebuilt, rec, nullptr,
+                                 true, index, offsets))
+      continue;
+
+    if (!sink.add(rec))
+      continue;
+
+    /* Hand over the rows without holding any page latch */
+    btr_pcur_store_position(&pcur, &mtr);
+    mtr.commit();
+
+    if (!sink.flush())
+      goto func_exit;
+
+    mtr.start();
+    if (pcur.restore_position(BTR_SEARCH_LEAF, &mtr) ==
+        btr_pcur_t::CORRUPTED)
+      err= DB_CORRUPTION;
+  }
+
+  mtr.commit();
+func_exit:
+  btr_pcur_close(&pcur);
+  if (heap)
+    mem_heap_free(heap);
+  return err;
+}
@@ -767,6 +767,66 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
 	 MONITOR_DEFAULT_START, MONITOR_OVLD_LOG_WRITES},
 
+	{"log_write_ahead", "recovery",
+	 "Number of log writes that were submitted in the background"
+	 " because the log buffer was filling up",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LOG_WRITE_AHEAD},
+
+	{"log_write_time", "recovery",
+	 "Time (in microseconds) spent in log writes",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LOG_WRITE_TIME},
+
+	{"log_write_lt_100us", "recovery",
+	 "Number of log writes that took less than 100 microseconds",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LOG_WRITE_LT_100US},
+
+	{"log_write_lt_1ms", "recovery",
+	 "Number of log writes that took 100 microseconds to 1 millisecond",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LOG_WRITE_LT_1MS},
+
+	{"log_write_lt_10ms", "recovery",
+	 "Number of log writes that took 1 to 10 milliseconds",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LOG_WRITE_LT_10MS},
+
+	{"log_write_ge_10ms", "recovery",
+	 "Number of log writes that took 10 milliseconds or more",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LOG_WRITE_GE_10MS},
+
+	{"log_flush_time", "recovery",
+	 "Time (in microseconds) spent in log flushes to durable storage",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LOG_FLUSH_TIME},
+
+	{"log_flush_lt_100us", "recovery",
+	 "Number of log flushes to durable storage that took less than"
+	 " 100 microseconds",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LOG_FLUSH_LT_100US},
+
+	{"log_flush_lt_1ms", "recovery",
+	 "Number of log flushes to durable storage that took 100"
+	 " microseconds to 1 millisecond",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LOG_FLUSH_LT_1MS},
+
+	{"log_flush_lt_10ms", "recovery",
+	 "Number of log flushes to durable storage that took 1 to 10"
+	 " milliseconds",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LOG_FLUSH_LT_10MS},
+
+	{"log_flush_ge_10ms", "recovery",
+	 "Number of log flushes to durable storage that took 10"
+	 " milliseconds or more",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LOG_FLUSH_GE_10MS},
+
 	/* ========== Counters for Page Compression ========== */
 	{"module_compress", "compression", "Page Compression Info",
 	 MONITOR_MODULE,
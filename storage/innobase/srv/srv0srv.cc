@@ -309,6 +309,8 @@ based on number of configured pages */
 my_bool	srv_stats_sample_traditional;
 
 my_bool	srv_use_doublewrite_buf;
+/** innodb_doublewrite_files */
+uint	srv_doublewrite_files;
 
 /** innodb_sync_spin_loops */
 ulong	srv_n_spin_wait_rounds;
@@ -967,6 +969,8 @@ srv_export_innodb_status(void)
 	export_vars.innodb_onlineddl_rowlog_pct_used = onlineddl_rowlog_pct_used;
 	export_vars.innodb_onlineddl_pct_progress = onlineddl_pct_progress;
 
+	export_vars.innodb_parallel_scans = srv_stats.n_parallel_scans;
+
 	if (!srv_read_only_mode) {
 		export_vars.innodb_encryption_rotation_pages_read_from_cache =
 			crypt_stat.pages_read_from_cache;
@@ -2081,6 +2081,57 @@ int ha_myisam::rnd_next(uchar *buf)
   return error;
 }
 
+/*
+  Block sampling is only done for fixed length rows, where the position of
+  every row slot in the data file is known. A block is the row slots in
+  MI_SAMPLE_BLOCK_SIZE bytes of the data file.
+*/
+
+#define MI_SAMPLE_BLOCK_SIZE (16*1024)
+
+int ha_myisam::sample_init(double fraction)
+{
+  MYISAM_SHARE *share= file->s;
+  if (share->data_file_type != STATIC_RECORD || !share->base.pack_reclength)
+    return HA_ERR_WRONG_COMMAND;
+
+  ulong reclength= share->base.pack_reclength;
+  ha_rows slots= file->state->data_file_length / reclength;
+  sample_block_rows= MY_MAX(MI_SAMPLE_BLOCK_SIZE / reclength, 1);
+  sample_blocks= (slots + sample_block_rows - 1) / sample_block_rows;
+  sample_blocks_left= (ha_rows) (fraction * sample_blocks);
+  if (sample_blocks_left < HA_SAMPLE_MIN_BLOCKS ||
+      sample_blocks_left >= sample_blocks / 2)
+    return HA_ERR_WRONG_COMMAND;
+  sample_rows_left= 0;
+  return mi_reset(file);
+}
+
+int ha_myisam::sample_next(uchar *buf)
+{
+  ulong reclength= file->s->base.pack_reclength;
+  if (!sample_rows_left)
+  {
+    if (!sample_blocks_left)
+      return HA_ERR_END_OF_FILE;
+    sample_blocks_left--;
+    ha_rows block= MY_MIN((ha_rows) (thd_rnd(ha_thd()) * sample_blocks),
+                          sample_blocks - 1);
+    sample_pos= (my_off_t) block * sample_block_rows * reclength;
+    sample_rows_left= sample_block_rows;
+  }
+  sample_rows_left--;
+  int error= mi_rrnd(file, buf, sample_pos);
+  sample_pos+= reclength;
+  if (error == HA_ERR_END_OF_FILE)
+  {
+    /* The last block is not full; continue with the next block */
+    sample_rows_left= 0;
+    error= HA_ERR_RECORD_DELETED;
+  }
+  return error;
+}
+
 int ha_myisam::remember_rnd_pos()
 {
   position((uchar*) 0);
@@ -100,6 +100,8 @@ class ha_myisam final : public handler
   int rnd_init(bool scan) override;
   int rnd_next(uchar *buf) override;
   int rnd_pos(uchar * buf, uchar *pos) override;
+  int sample_init(double fraction) override;
+  int sample_next(uchar *buf) override;
   int remember_rnd_pos() override;
   int restart_rnd_next(uchar *buf) override;
   void position(const uchar *record) override;
@@ -183,5 +185,9 @@ class ha_myisam final : public handler
 
 private:
   DsMrr_impl ds_mrr;
+  /* Block sampling state, see sample_init() */
+  my_off_t sample_pos;
+  ha_rows sample_blocks, sample_blocks_left;
+  ulong sample_block_rows, sample_rows_left;
   friend check_result_t index_cond_func_myisam(void *arg);
 };
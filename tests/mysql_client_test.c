@@ -21802,6 +21802,208 @@ void test_mdev_10075()
   mysql_free_result(result);
 }
 
+
+#ifndef EMBEDDED_LIBRARY
+static void assert_ps_cache_hit_count_equals(MYSQL *mysql, int val)
+{
+  MYSQL_ROW row;
+  MYSQL_RES *result;
+  int rc= mysql_query(mysql, "SELECT VARIABLE_VALUE FROM INFORMATION_SCHEMA.SESSION_STATUS WHERE "
+                         "VARIABLE_NAME='Prepared_stmt_cache_hit'");
+  myquery(rc);
+  result= mysql_use_result(mysql);
+  mytest(result);
+  row= mysql_fetch_row(result);
+  DIE_UNLESS(atoi(row[0]) == val);
+  mysql_free_result(result);
+}
+
+
+static int get_prepared_stmt_count(MYSQL *mysql)
+{
+  MYSQL_ROW row;
+  MYSQL_RES *result;
+  int count;
+  int rc= mysql_query(mysql, "SELECT VARIABLE_VALUE FROM INFORMATION_SCHEMA.GLOBAL_STATUS WHERE "
+                         "VARIABLE_NAME='Prepared_stmt_count'");
+  myquery(rc);
+  result= mysql_use_result(mysql);
+  mytest(result);
+  row= mysql_fetch_row(result);
+  count= atoi(row[0]);
+  mysql_free_result(result);
+  return count;
+}
+
+
+/*
+  Reuse of closed prepared statements with @@prepared_stmt_cache_size
+*/
+
+static void test_prepared_stmt_cache()
+{
+  const char *query= "SELECT b, a FROM t1 WHERE a=?";
+  MYSQL_STMT *stmt;
+  MYSQL_RES  *metadata;
+  MYSQL_BIND my_bind[1];
+  int        int_data= 2;
+  int        rc, i, stmt_count;
+  char       buff[64];
+
+  myheader("test_prepared_stmt_cache");
+
+  rc= mysql_query(mysql, "CREATE OR REPLACE TABLE t1 (a INT PRIMARY KEY, b VARCHAR(10))");
+  myquery(rc);
+  rc= mysql_query(mysql, "INSERT INTO t1 VALUES (1,'a'),(2,'b'),(3,'c')");
+  myquery(rc);
+  rc= mysql_query(mysql, "SET prepared_stmt_cache_size= 4");
+  myquery(rc);
+  flush_session_status(mysql);
+  stmt_count= get_prepared_stmt_count(mysql);
+
+  bzero((char*) my_bind, sizeof(my_bind));
+  my_bind[0].buffer_type= MYSQL_TYPE_LONG;
+  my_bind[0].buffer= (void *) &int_data;
+
+  /* The second and the third prepare take the closed statement back */
+  for (i= 0; i < 3; i++)
+  {
+    stmt= mysql_simple_prepare(mysql, query);
+    check_stmt(stmt);
+    verify_param_count(stmt, 1);
+
+    metadata= mysql_stmt_result_metadata(stmt);
+    mytest(metadata);
+    verify_field_count(metadata, 2);
+    DIE_UNLESS(strcmp(mysql_fetch_field_direct(metadata, 0)->name, "b") == 0);
+    mysql_free_result(metadata);
+
+    rc= mysql_stmt_bind_param(stmt, my_bind);
+    check_execute(stmt, rc);
+    rc= mysql_stmt_execute(stmt);
+    check_execute(stmt, rc);
+    rc= my_process_stmt_result(stmt);
+    DIE_UNLESS(rc == 1);
+
+    mysql_stmt_close(stmt);
+  }
+  assert_ps_cache_hit_count_equals(mysql, 2);
+
+  /* The kept statement is counted against max_prepared_stmt_count */
+  DIE_UNLESS(get_prepared_stmt_count(mysql) == stmt_count + 1);
+
+  /* and gives way to a new statement when the limit is reached */
+  sprintf(buff, "SET GLOBAL max_prepared_stmt_count= %d", stmt_count + 1);
+  rc= mysql_query(mysql, buff);
+  myquery(rc);
+  stmt= mysql_simple_prepare(mysql, "SELECT a FROM t1");
+  check_stmt(stmt);
+  DIE_UNLESS(get_prepared_stmt_count(mysql) == stmt_count + 1);
+  mysql_stmt_close(stmt);
+  rc= mysql_query(mysql, "SET GLOBAL max_prepared_stmt_count= DEFAULT");
+  myquery(rc);
+
+  /* Take the first statement back into the cache */
+  stmt= mysql_simple_prepare(mysql, query);
+  check_stmt(stmt);
+  mysql_stmt_close(stmt);
+  assert_ps_cache_hit_count_equals(mysql, 2);
+
+  /* A changed table definition makes the statement be prepared again */
+  rc= mysql_query(mysql, "ALTER TABLE t1 ADD c INT");
+  myquery(rc);
+  stmt= mysql_simple_prepare(mysql, query);
+  check_stmt(stmt);
+  mysql_stmt_close(stmt);
+  assert_ps_cache_hit_count_equals(mysql, 2);
+
+  /* A dropped table fails the prepare */
+  rc= mysql_query(mysql, "DROP TABLE t1");
+  myquery(rc);
+  stmt= mysql_stmt_init(mysql);
+  check_stmt(stmt);
+  rc= mysql_stmt_prepare(stmt, query, (ulong) strlen(query));
+  DIE_UNLESS(rc);
+  DIE_UNLESS(mysql_stmt_errno(stmt) == ER_NO_SUCH_TABLE);
+  mysql_stmt_close(stmt);
+  assert_ps_cache_hit_count_equals(mysql, 2);
+
+  rc= mysql_query(mysql, "SET prepared_stmt_cache_size= DEFAULT");
+  myquery(rc);
+  DIE_UNLESS(get_prepared_stmt_count(mysql) == stmt_count);
+}
+
+
+/*
+  Executions sent without waiting for the replies get all their replies,
+  in order, when the server sends them together
+*/
+
+static void test_pipelined_execute()
+{
+  MYSQL_STMT *stmt;
+  MYSQL_RES  *result;
+  MYSQL_ROW  row;
+  uchar      buff[9];
+  int        rc, i, round;
+  my_ulonglong id= 0;
+
+  myheader("test_pipelined_execute");
+
+  rc= mysql_query(mysql, "CREATE OR REPLACE TABLE t1 "
+                         "(a INT AUTO_INCREMENT PRIMARY KEY, b INT)");
+  myquery(rc);
+
+  stmt= mysql_simple_prepare(mysql, "INSERT INTO t1 (b) VALUES (1)");
+  check_stmt(stmt);
+
+  /* A COM_STMT_EXECUTE without cursor and parameters */
+  int4store(buff, stmt->stmt_id);
+  buff[4]= CURSOR_TYPE_NO_CURSOR;
+  int4store(buff + 5, 1);
+  /*
+    Two pipelined runs, separated by an execution that waits for its
+    reply: the replies of the second run are kept together again
+  */
+  for (round= 0; round < 2; round++)
+  {
+    if (round)
+    {
+      rc= mysql_stmt_execute(stmt);
+      check_execute(stmt, rc);
+      DIE_UNLESS(mysql_stmt_insert_id(stmt) == ++id);
+    }
+    for (i= 0; i < 20; i++)
+    {
+      rc= simple_command(mysql, COM_STMT_EXECUTE, buff, sizeof(buff), 1);
+      DIE_UNLESS(rc == 0);
+    }
+
+    for (i= 0; i < 20; i++)
+    {
+      /* Each reply is the first packet of its command */
+      mysql->net.pkt_nr= 1;
+      rc= mysql_read_query_result(mysql);
+      myquery(rc);
+      DIE_UNLESS(mysql_affected_rows(mysql) == 1);
+      DIE_UNLESS(mysql_insert_id(mysql) == ++id);
+    }
+  }
+  mysql_stmt_close(stmt);
+
+  rc= mysql_query(mysql, "SELECT COUNT(*), MAX(a) FROM t1");
+  myquery(rc);
+  result= mysql_store_result(mysql);
+  mytest(result);
+  row= mysql_fetch_row(result);
+  DIE_UNLESS(strcmp(row[0], "41") == 0 && strcmp(row[1], "41") == 0);
+  mysql_free_result(result);
+
+  rc= mysql_query(mysql, "DROP TABLE t1");
+  myquery(rc);
+}
+#endif
+
 static struct my_tests_st my_tests[]= {
   { "test_mdev_20516", test_mdev_20516 },
   { "test_mdev24827", test_mdev24827 },
@@ -22109,6 +22311,10 @@ static struct my_tests_st my_tests[]= {
   { "test_execute_direct", test_execute_direct },
   { "test_cache_metadata", test_cache_metadata},
   { "test_mdev_10075", test_mdev_10075},
+#ifndef EMBEDDED_LIBRARY
+  { "test_prepared_stmt_cache", test_prepared_stmt_cache },
+  { "test_pipelined_execute", test_pipelined_execute },
+#endif
   { 0, 0 }
 };
 
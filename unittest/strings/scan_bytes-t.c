@@ -0,0 +1,113 @@
+/* Copyright (c) 2026, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+#include <my_global.h>
+#include <my_sys.h>
+#include <my_scan_bytes.h>
+#include <tap.h>
+
+#define BUF_SIZE 200
+#define BENCH_SIZE (64 << 20)
+#define BENCH_ROUNDS 8
+
+static const uchar *scan_bytes_simple(const MY_BYTE_SET *set,
+                                      const uchar *ptr, const uchar *end)
+{
+  for (; ptr < end; ptr++)
+  {
+    uint i;
+    for (i= 0; i < set->count; i++)
+      if (*ptr == set->bytes[i])
+        return ptr;
+  }
+  return end;
+}
+
+/*
+  Place a byte of the set at every position of buffers of every length
+  up to BUF_SIZE, at every alignment
+*/
+static int check_positions(const MY_BYTE_SET *set, uchar filler)
+{
+  uchar buf[BUF_SIZE + 16];
+  uint offset, length, pos, i;
+
+  for (offset= 0; offset < 16; offset++)
+    for (length= 0; length <= BUF_SIZE; length++)
+      for (pos= 0; pos <= length; pos++)
+        for (i= 0; i < MY_MAX(set->count, 1); i++)
+        {
+          uchar *ptr= buf + offset;
+          memset(buf, filler, sizeof buf);
+          if (pos < length)
+            ptr[pos]= set->bytes[i];
+          if (my_scan_bytes(set, ptr, ptr + length) !=
+              scan_bytes_simple(set, ptr, ptr + length))
+          {
+            diag("mismatch: offset %u length %u position %u byte %u",
+                 offset, length, pos, (uint) set->bytes[i]);
+            return 1;
+          }
+        }
+  return 0;
+}
+
+int main(int argc __attribute__((unused)), char *argv[])
+{
+  const int csv[]= {',', '"', '\\', '\n'};
+  const int high[]= {0x80, 0xff, INT_MAX, -1};
+  const int none[]= {INT_MAX};
+  MY_BYTE_SET set;
+  uchar *buf;
+  ulonglong start, ns;
+  uint i;
+
+  MY_INIT(argv[0]);
+  plan(6);
+
+  my_byte_set_init(&set, csv, 4);
+  ok(set.count == 4 && !check_positions(&set, 'a'), "csv bytes");
+  ok(!check_positions(&set, 0), "csv bytes in zeros");
+
+  my_byte_set_init(&set, high, 4);
+  ok(set.count == 2 && !check_positions(&set, 0x7f), "bytes >= 0x80");
+
+  my_byte_set_init(&set, csv, 1);
+  ok(set.count == 1 && !check_positions(&set, '.'), "single byte");
+
+  my_byte_set_init(&set, none, 1);
+  ok(set.count == 0 && !check_positions(&set, 0), "empty set");
+
+  /* Throughput of a scan that finds nothing, like a long unquoted field */
+  buf= (uchar*) my_malloc(PSI_NOT_INSTRUMENTED, BENCH_SIZE, MYF(MY_WME));
+  memset(buf, 'x', BENCH_SIZE);
+  my_byte_set_init(&set, csv, 4);
+  start= my_interval_timer();
+  for (i= 0; i < BENCH_ROUNDS; i++)
+  {
+    buf[BENCH_SIZE - 1]= (uchar) (i & 1 ? ',' : 'x');
+    if (my_scan_bytes(&set, buf, buf + BENCH_SIZE) <
+        buf + BENCH_SIZE - 1)
+      break;
+  }
+  ns= my_interval_timer() - start;
+  ok(i == BENCH_ROUNDS, "scan of %d MiB", BENCH_SIZE >> 20);
+  diag("my_scan_bytes: %.2f GB/s",
+       (double) BENCH_SIZE * BENCH_ROUNDS / (double) MY_MAX(ns, 1));
+  my_free(buf);
+
+  my_end(0);
+  return exit_status();
+}